@@ -0,0 +1,75 @@
+#!/bin/sh
+# build script (linux)
+
+CC="${CC:-cc}"
+command -v "$CC" > /dev/null || {
+	echo "ERROR: unable to find C compiler ($CC) installed"
+	exit 1
+}
+
+AR="${AR:-ar}"
+
+EXE_NAME="compilador"
+LIB_NAME="libcompilador"
+
+FLAGS="-std=c99 -Wall -Wextra -pedantic"
+if [ "$1" = "debug" ]; then
+	MFLAGS="-g -O0"
+	EXE_NAME="${EXE_NAME}_debug"
+	LIB_NAME="${LIB_NAME}_debug"
+else
+	MFLAGS="-DNDEBUG -O2"
+fi
+
+# NOTE(cya): regenerates the tables derived from compiler.c (and checks them),
+# only touching the headers whose contents changed
+generate() {
+	$CC -o compiler_gen compiler_gen.c $FLAGS -O0 -pthread || exit 1
+	for table in keywords dfa pow5 ll1; do
+		header="compiler_$table.h"
+		./compiler_gen "$table" > "$header.tmp" || {
+			rm -f "$header.tmp"
+			exit 1
+		}
+		if cmp -s "$header.tmp" "$header"; then
+			rm -f "$header.tmp"
+		else
+			mv "$header.tmp" "$header"
+			echo "generated $header"
+		fi
+	done
+}
+
+generate
+if [ "$1" = "gen" ]; then
+	exit 0
+fi
+
+if [ "$1" = "bench" ]; then
+	set -x
+	$CC -o compilador_bench compiler_bench.c $FLAGS $MFLAGS -pthread || exit 1
+	{ set +x; } 2> /dev/null
+	if [ "$2" = "run" ]; then
+		./compilador_bench
+	fi
+	exit 0
+fi
+
+set -ex
+$CC -c -o "$LIB_NAME.o" compiler.c $FLAGS $MFLAGS -pthread
+$AR rcs "$LIB_NAME.a" "$LIB_NAME.o"
+$CC -o "$EXE_NAME" compiler_linux.c "$LIB_NAME.a" $FLAGS $MFLAGS -pthread
+{ set +x; } 2> /dev/null
+
+# NOTE(cya): the tests include compiler.c, to get at the tokenizer too
+if [ "$1" = "test" ]; then
+	set -x
+	$CC -o compilador_test compiler_test.c $FLAGS $MFLAGS -pthread
+	{ set +x; } 2> /dev/null
+	./compilador_test || exit 1
+	exit 0
+fi
+
+if [ "$1" = "run" ] || [ "$2" = "run" ]; then
+	"./$EXE_NAME"
+fi
@@ -1,3134 +1,6523 @@
-#define CY_IMPLEMENTATION
-#include "cy.h"
-
-typedef CyStringView String;
-
-#define STRING_ARG(s) (int)s.len, s.text
-
-/* ---------------------------- Tokenizer ----------------------------------- */
-#define TOKEN_KINDS \
-    TOKEN_KIND(C_TOKEN_INVALID, "símbolo inválido"), \
-    TOKEN_KIND(C_TOKEN_EOF, "EOF"), \
-\
-TOKEN_KIND(C_TOKEN__LITERAL_BEGIN, ""), \
-    TOKEN_KIND(C_TOKEN_IDENT, "identificador"), \
-    TOKEN_KIND(C_TOKEN_INTEGER, "constante_int"), \
-    TOKEN_KIND(C_TOKEN_FLOAT, "constante_float"), \
-    TOKEN_KIND(C_TOKEN_STRING, "constante_string"), \
-    TOKEN_KIND(C_TOKEN_COMMENT, "comentário"), \
-TOKEN_KIND(C_TOKEN__LITERAL_END, ""), \
-\
-TOKEN_KIND(C_TOKEN__OPERATOR_BEGIN, ""), \
-    TOKEN_KIND(C_TOKEN_EQUALS, "="), \
-    TOKEN_KIND(C_TOKEN_ADD, "+"), \
-    TOKEN_KIND(C_TOKEN_SUB, "-"), \
-    TOKEN_KIND(C_TOKEN_MUL, "*"), \
-    TOKEN_KIND(C_TOKEN_DIV, "/"), \
-    TOKEN_KIND(C_TOKEN_OR, "||"), \
-    TOKEN_KIND(C_TOKEN_AND, "&&"), \
-    TOKEN_KIND(C_TOKEN_NOT, "!"), \
-\
-TOKEN_KIND(C_TOKEN__COMPARISON_BEGIN, ""), \
-    TOKEN_KIND(C_TOKEN_CMP_EQ, "=="), \
-    TOKEN_KIND(C_TOKEN_CMP_NE, "!="), \
-    TOKEN_KIND(C_TOKEN_CMP_LT, "<"), \
-    TOKEN_KIND(C_TOKEN_CMP_GT, ">"), \
-TOKEN_KIND(C_TOKEN__COMPARISON_END, ""), \
-\
-    TOKEN_KIND(C_TOKEN_PAREN_OPEN, "("), \
-    TOKEN_KIND(C_TOKEN_PAREN_CLOSE, ")"), \
-    TOKEN_KIND(C_TOKEN_COMMA, ","), \
-    TOKEN_KIND(C_TOKEN_SEMICOLON, ";"), \
-TOKEN_KIND(C_TOKEN__OPERATOR_END, ""), \
-\
-TOKEN_KIND(C_TOKEN__KEYWORD_BEGIN, ""), \
-    TOKEN_KIND(C_TOKEN_MAIN, "main"), \
-    TOKEN_KIND(C_TOKEN_END, "end"), \
-    TOKEN_KIND(C_TOKEN_IF, "if"), \
-    TOKEN_KIND(C_TOKEN_ELIF, "elif"), \
-    TOKEN_KIND(C_TOKEN_ELSE, "else"), \
-    TOKEN_KIND(C_TOKEN_TRUE, "true"), \
-    TOKEN_KIND(C_TOKEN_FALSE, "false"), \
-    TOKEN_KIND(C_TOKEN_READ, "read"), \
-    TOKEN_KIND(C_TOKEN_WRITE, "write"), \
-    TOKEN_KIND(C_TOKEN_WRITELN, "writeln"), \
-    TOKEN_KIND(C_TOKEN_REPEAT, "repeat"), \
-    TOKEN_KIND(C_TOKEN_UNTIL, "until"), \
-    TOKEN_KIND(C_TOKEN_WHILE, "while"), \
-TOKEN_KIND(C_TOKEN__KEYWORD_END, ""), \
-    TOKEN_KIND(C_TOKEN_COUNT, "")
-
-#define KEYWORD_COUNT (C_TOKEN__KEYWORD_END - C_TOKEN__KEYWORD_BEGIN - 1)
-
-typedef enum {
-#define TOKEN_KIND(e, s) e
-    TOKEN_KINDS
-#undef TOKEN_KIND
-} TokenKind;
-
-const String g_token_strings[] = {
-#define TOKEN_KIND(e, s) {(const u8*)s, CY_STATIC_STR_LEN(s)}
-    TOKEN_KINDS
-#undef TOKEN_KIND
-};
-
-static isize g_keyword_map_arr[KEYWORD_COUNT * 3];
-
-typedef struct {
-    i32 line;
-    i32 col;
-} TokenPos;
-
-typedef struct {
-    TokenKind kind;
-    TokenPos pos;
-    String str;
-} Token;
-
-typedef enum {
-    T_ERR_OUT_OF_MEMORY = -1,
-    T_ERR_NONE,
-    T_ERR_INVALID_SYMBOL,
-    T_ERR_INVALID_KEYWORD,
-    T_ERR_INVALID_IDENT,
-    T_ERR_INVALID_STRING,
-    T_ERR_INVALID_COMMENT,
-} TokenizerError;
-
-typedef struct {
-    const u8 *start;
-    const u8 *end;
-    const u8 *cur;
-    const u8 *next;
-
-    Rune cur_rune;
-    TokenPos pos;
-
-    TokenizerError err;
-    const u8 *err_desc;
-    Token bad_tok;
-} Tokenizer;
-
-typedef struct {
-    u8 lo, hi;
-} Utf8AcceptRange;
-
-typedef isize (*HashFunc)(String);
-
-typedef struct {
-    isize *data;
-    isize len;
-    HashFunc hash_func;
-} KeywordMap;
-
-static KeywordMap g_keyword_map;
-
-static KeywordMap keyword_map_init(
-    isize *arr, isize len, HashFunc hash_func
-) {
-    return (KeywordMap){
-        .data = (void*)arr,
-        .len = len,
-        .hash_func = hash_func,
-    };
-}
-
-void keyword_map_insert(KeywordMap *map, String key, isize val)
-{
-    if (map != NULL) {
-        isize idx = map->hash_func(key);
-        if (idx == -1)  {
-            return;
-        }
-
-        idx %= map->len;
-        CY_ASSERT_MSG(
-            map->data[idx] == 0,
-            "hash collision detected (idx: %td, cur val: %td, new val: %td)",
-            idx, map->data[idx], val
-        );
-
-        map->data[idx] = val;
-    }
-}
-
-isize keyword_hash_func(String key)
-{
-    isize len = key.len;
-    if (len < 2) {
-        return -1;
-    }
-
-    // NOTE(cya): uniqueness <- 1st char, last char and length
-    u16 l = (u16)key.text[0] << 8, r = key.text[len - 2];
-    return (isize)((l | r) * key.len);
-}
-
-static isize keyword_map_lookup(KeywordMap *map, String key)
-{
-    isize idx = map->hash_func(key);
-    if (idx == -1) {
-        return -1;
-    }
-
-    idx %= map->len;
-    return map->data[idx];
-}
-
-static isize utf8_decode(String str, Rune *rune_out)
-{
-    if (str.len < 1) {
-        return 0;
-    }
-
-    isize width = 0;
-    (void)width;
-    // TODO(cya): implement
-    *rune_out = *str.text;
-    return 1;
-}
-
-static void tokenizer_advance_to_next_rune(Tokenizer *t)
-{
-    if (t->cur_rune == '\n') {
-        t->pos.line += 1;
-        t->pos.col = 1;
-    }
-
-    if (t->next >= t->end) {
-        t->cur = t->end;
-        t->cur_rune = CY_RUNE_EOF;
-        return;
-    }
-
-    t->cur = t->next;
-    Rune rune = *t->cur;
-    if (rune == 0) {
-        t->cur_rune = CY_RUNE_INVALID;
-        return;
-    } else if (rune & 0x80) {
-        // NOTE(cya): non-ASCII UTF-8 code unit
-        isize width = utf8_decode((String){
-            .text = t->cur,
-            .len = t->end - t->cur
-        }, &rune);
-        t->next += width;
-    } else {
-        t->next += 1;
-    }
-
-    t->cur_rune = rune;
-    t->pos.col += 1;
-}
-
-static inline Tokenizer tokenizer_init(String src)
-{
-    if (g_keyword_map.data == NULL) {
-        g_keyword_map = keyword_map_init(
-            g_keyword_map_arr, CY_STATIC_ARR_LEN(g_keyword_map_arr),
-            keyword_hash_func
-        );
-
-        isize offset = C_TOKEN__KEYWORD_BEGIN + 1;
-        for (isize i = 0; i < KEYWORD_COUNT; i++) {
-            isize idx = offset + i;
-            keyword_map_insert(&g_keyword_map, g_token_strings[idx], idx);
-        }
-    }
-
-    const u8 *start = (const u8*)src.text;
-    const u8 *end = start + src.len;
-    Tokenizer t = {
-        .start = start,
-        .end = end,
-        .cur = start,
-        .next = start,
-        .pos = (TokenPos){
-            .line = 1,
-        },
-    };
-
-    tokenizer_advance_to_next_rune(&t);
-    if (t.cur_rune == CY_RUNE_BOM) { // NOTE(cya): is this even necessary?
-        tokenizer_advance_to_next_rune(&t);
-    }
-
-    return t;
-}
-
-static inline b32 rune_is_letter(Rune r)
-{
-    if (r < 0x80) {
-        // NOTE(cya): (r >= 'a' && r <= 'z') || (r >= 'A' && r <= 'Z');
-        return ((u32)r | 0x20) - 0x61 < 26;
-    } else {
-        // TODO(cya): detect non-ascii unicode letters
-        return false;
-    }
-}
-
-static inline b32 rune_is_digit(Rune r)
-{
-    if (r < 0x80) {
-        return (u32)r - '0' < 10;
-    } else {
-        return false;
-    }
-}
-
-static inline b32 rune_is_alphanumeric(Rune r)
-{
-    return rune_is_letter(r) || rune_is_digit(r);
-}
-
-static inline b32 rune_is_uppercase(Rune r) {
-    return (u32)r - 0x41 < 26;
-}
-
-static inline b32 token_is_ident(String tok)
-{
-    if (tok.len < 3) {
-        return false;
-    }
-
-    const u8 *s = tok.text;
-    b32 has_prefix = (s[1] == '_' && (
-        s[0] == 'i' || s[0] == 'f' || s[0] == 'b' || s[0] == 's'
-    ));
-    if (!has_prefix || !rune_is_letter(s[2])) {
-        return false;
-    }
-
-    for (isize i = 2; i < tok.len; i++) {
-        Rune r = s[i];
-        if (!rune_is_alphanumeric(r)) {
-            return false;
-        }
-
-        b32 has_adjacent_uppercases = i < tok.len - 1 &&
-            rune_is_uppercase(r) && rune_is_uppercase(s[i + 1]);
-        if (has_adjacent_uppercases) {
-            return false;
-        }
-    }
-
-    return true;
-}
-
-static inline b32 token_is_keyword(String tok, i32 *kind_out)
-{
-    isize idx = keyword_map_lookup(&g_keyword_map, tok);
-    if (idx == -1) {
-        return false;
-    }
-
-    String keyword = g_token_strings[idx];
-    if (*tok.text != *keyword.text || !cy_string_view_are_equal(tok, keyword)) {
-        return false;
-    }
-
-    *kind_out = idx;
-    return true;
-}
-
-static inline b32 is_whitespace(Rune r)
-{
-    return r == ' ' || r == '\t' ||
-        r == '\r' || r == '\n' ||
-        r == '\v' || r == '\f';
-}
-
-static inline void tokenizer_skip_whitespace(Tokenizer *t)
-{
-    while (is_whitespace(t->cur_rune)) {
-        tokenizer_advance_to_next_rune(t);
-    }
-}
-
-static inline String string_from_token_kind(TokenKind kind)
-{
-    if (kind < 0 || kind >= C_TOKEN_COUNT) {
-        return g_token_strings[C_TOKEN_INVALID];
-    } else if (kind > C_TOKEN__OPERATOR_BEGIN && kind < C_TOKEN__OPERATOR_END) {
-        return cy_string_view_create_c("símbolo especial");
-    } else if (kind > C_TOKEN__KEYWORD_BEGIN && kind < C_TOKEN__KEYWORD_END) {
-        return cy_string_view_create_c("palavra reservada");
-    }
-
-    return g_token_strings[kind];
-}
-
-static inline CyString cy_string_from_token_kind(CyAllocator a, TokenKind kind)
-{
-    return cy_string_create_view(a, string_from_token_kind(kind));
-}
-
-static inline TokenKind token_kind_from_string(String str)
-{
-    for (isize i = 0; i < C_TOKEN_COUNT; i++) {
-        if (cy_string_view_are_equal(str, g_token_strings[i])) {
-            return i;
-        }
-    }
-
-    return C_TOKEN_INVALID;
-}
-
-static inline void tokenizer_error(
-    Tokenizer *t, Token *bad_tok, TokenizerError err, const char *err_desc
-) {
-    if (bad_tok != NULL) {
-        t->bad_tok = *bad_tok;
-    }
-
-    t->err = err;
-    t->err_desc = (const u8*)err_desc;
-}
-
-static inline void tokenizer_parse_numeric_constant(
-    Tokenizer *t, Token *token_out
-) {
-    if (t->cur_rune != '0') {
-        do {
-            tokenizer_advance_to_next_rune(t);
-        } while ((rune_is_digit(t->cur_rune)));
-    } else {
-        tokenizer_advance_to_next_rune(t);
-        t->cur_rune = t->cur_rune;
-    }
-
-    b32 is_float = t->cur_rune == ',' &&
-        t->next < t->end && rune_is_digit(*t->next);
-    if (is_float) {
-        token_out->kind = C_TOKEN_FLOAT;
-
-        tokenizer_advance_to_next_rune(t);
-        t->cur_rune = t->cur_rune;
-
-        const u8 *start = t->cur;
-        const u8 *end = start;
-        do {
-            end += 1;
-        } while ((rune_is_digit(*end)));
-
-        while (*(end - 1) == '0') {
-            end -= 1;
-        }
-
-        isize adv_len = end - start;
-        if (end == start && *start == '0') {
-            adv_len = 1;
-        }
-
-        while (adv_len-- > 0) {
-            tokenizer_advance_to_next_rune(t);
-            t->cur_rune = t->cur_rune;
-        }
-    } else {
-        token_out->kind = C_TOKEN_INTEGER;
-    }
-}
-
-static inline void tokenizer_parse_string_literal(
-    Tokenizer *t, Token *token_out
-) {
-    do {
-        tokenizer_advance_to_next_rune(t);
-
-        if (t->cur_rune == '%' && t->next < t->end && *t->next != 'x') {
-            const char *s = (const char*)t->cur;
-            Token bad_tok = {
-                .kind = C_TOKEN_INVALID,
-                .pos = token_out->pos,
-                .str = cy_string_view_create_len(s, 1),
-            };
-            if (*t->next != '"') {
-                bad_tok.str.len += 1;
-            }
-
-            tokenizer_error(
-                t, &bad_tok, T_ERR_INVALID_STRING,
-                "especificador de formato inválido (%*)"
-            );
-            return;
-        } else if (t->cur_rune == '\n') {
-            tokenizer_error(
-                t, token_out, T_ERR_INVALID_STRING,
-                "quebra de linha ilegal dentro da literal"
-            );
-            return;
-        }
-    } while (t->cur < t->end && *t->cur != '"');
-
-    if (t->cur >= t->end) {
-        tokenizer_error(
-            t, token_out, T_ERR_INVALID_STRING, "feche-a com \""
-        );
-        return;
-    }
-
-    tokenizer_advance_to_next_rune(t);
-    token_out->kind = C_TOKEN_STRING;
-}
-
-static inline void tokenizer_parse_comment(Tokenizer *t, Token *token_out)
-{
-    const u8 *start = t->cur;
-    token_out->str.len += 1;
-
-    tokenizer_advance_to_next_rune(t);
-    tokenizer_advance_to_next_rune(t);
-
-    while (t->cur < t->end && t->cur_rune != '@') {
-        tokenizer_advance_to_next_rune(t);
-    }
-
-    if (t->end - t->cur < 2) {
-        tokenizer_error(
-            t, token_out, T_ERR_INVALID_COMMENT,
-            "feche-o com uma quebra de linha seguida por @<"
-        );
-        return;
-    } else if (*t->next != '<') {
-        tokenizer_error(
-            t, token_out, T_ERR_INVALID_COMMENT, "@ ilegal dentro da literal"
-        );
-        return;
-    }
-
-    const u8 *end = t->next;
-    tokenizer_advance_to_next_rune(t);
-    tokenizer_advance_to_next_rune(t);
-
-    // NOTE(cya): should detect CR/LF/CRLF line endings correctly
-    b32 malformed =
-        (*(end - 2) != '\n' && *(end - 2) != '\r') ||
-        (*(start + 2) != '\r' && *(start + 2) != '\n');
-    if (malformed) {
-        tokenizer_error(t, token_out, T_ERR_INVALID_COMMENT, "mal formatado");
-        return;
-    }
-
-    token_out->kind = C_TOKEN_COMMENT;
-}
-
-static Token tokenizer_get_token(Tokenizer *t)
-{
-    tokenizer_skip_whitespace(t);
-
-    TokenPos cur_pos = t->pos;
-    Token token = {
-        .kind = C_TOKEN_INVALID,
-        .pos.line = cur_pos.line,
-        .pos.col = cur_pos.col,
-        .str = (String){
-            .text = t->cur,
-            .len = 1,
-        },
-    };
-
-    Rune cur_rune = t->cur_rune;
-    if (rune_is_letter(cur_rune)) {
-        while (rune_is_alphanumeric(cur_rune) || cur_rune == '_') {
-            tokenizer_advance_to_next_rune(t);
-            cur_rune = t->cur_rune;
-        }
-
-        token.str.len = t->cur - token.str.text;
-        b32 not_keyword = rune_is_uppercase(token.str.text[0]) ||
-            cy_string_view_contains(token.str, "_0123456789");
-        if (not_keyword) {
-            if (token_is_ident(token.str)) {
-                token.kind = C_TOKEN_IDENT;
-            } else {
-                tokenizer_error(t, &token, T_ERR_INVALID_IDENT, NULL);
-            }
-        } else  {
-            i32 kind;
-            if (token_is_keyword(token.str, &kind)) {
-                token.kind = kind;
-                return token;
-            } else {
-                tokenizer_error(t, &token, T_ERR_INVALID_KEYWORD, NULL);
-            }
-        }
-    } else {
-        switch (cur_rune) {
-        case CY_RUNE_EOF: {
-            token.kind = C_TOKEN_EOF;
-        } break;
-        case '0':
-        case '1':
-        case '2':
-        case '3':
-        case '4':
-        case '5':
-        case '6':
-        case '7':
-        case '8':
-        case '9': {
-            tokenizer_parse_numeric_constant(t, &token);
-        } break;
-        case '"': {
-            tokenizer_parse_string_literal(t, &token);
-        } break;
-        case ';':
-        case ',':
-        case '(':
-        case ')':
-        case '<':
-        case '+':
-        case '-':
-        case '*':
-        case '/': {
-            String s = cy_string_view_create_len((const char*)t->cur, 1);
-            tokenizer_advance_to_next_rune(t);
-            token.kind = token_kind_from_string(s);
-            return token;
-        } break;
-        case '&':
-        case '|':
-        case '=':
-        case '!':
-        case '>': {
-            String s = cy_string_view_create_len((const char*)t->cur, 1);
-            if (t->next < t->end) {
-                Rune next_rune = *t->next;
-                b32 is_cmp = (cur_rune == '&' && next_rune == '&') ||
-                    (cur_rune == '|' && next_rune == '|') ||
-                    (cur_rune == '=' && next_rune == '=') ||
-                    (cur_rune == '!' && next_rune == '=');
-                b32 is_comment = (cur_rune == '>' && next_rune == '@');
-                if (is_cmp) {
-                    s.len += 1;
-                    tokenizer_advance_to_next_rune(t);
-                    tokenizer_advance_to_next_rune(t);
-                    token.kind = token_kind_from_string(s);
-                } else if (is_comment) {
-                    tokenizer_parse_comment(t, &token);
-                } else {
-                    b32 invalid = (cur_rune == '&' || cur_rune == '|') &&
-                        next_rune != cur_rune;
-                    if (invalid) {
-                        tokenizer_error(t, &token, T_ERR_INVALID_SYMBOL, NULL);
-                    } else {
-                        tokenizer_advance_to_next_rune(t);
-                        token.kind = token_kind_from_string(s);
-                    }
-                }
-            } else {
-                tokenizer_advance_to_next_rune(t);
-                token.kind = token_kind_from_string(s);
-                if (token.kind == C_TOKEN_INVALID) {
-                    tokenizer_error(t, &token, T_ERR_INVALID_SYMBOL, NULL);
-                }
-            }
-        } break;
-        default: {
-            tokenizer_error(t, &token, T_ERR_INVALID_SYMBOL, NULL);
-        } break;
-        }
-    }
-
-    token.str.len = t->cur - token.str.text;
-    return token;
-}
-
-typedef struct {
-    Token *arr;
-    isize len;
-    isize cap;
-} TokenList;
-
-#define C_TOKEN_LIST_INIT_CAP 0x1000
-
-static TokenList tokenize(CyAllocator a, Tokenizer *t, b32 ignore_comments)
-{
-    TokenList list = {
-        .cap = C_TOKEN_LIST_INIT_CAP,
-    };
-    list.arr = cy_alloc_array(a, Token, list.cap);
-    if (list.arr == NULL) {
-        tokenizer_error(t, NULL, T_ERR_OUT_OF_MEMORY, NULL);
-        cy_mem_set(&list, 0, sizeof(list));
-        return list;
-    }
-
-    isize e = 0;
-    for (;;) {
-        if (list.len == list.cap) {
-            isize new_cap = list.cap * 2;
-            list.arr = cy_resize_array(a, list.arr, Token, list.cap, new_cap);
-            if (list.arr == NULL) {
-                tokenizer_error(t, NULL, T_ERR_OUT_OF_MEMORY, NULL);
-                cy_mem_set(&list, 0, sizeof(list));
-                break;
-            }
-
-            list.cap = new_cap;
-        }
-
-        Token new_tok = tokenizer_get_token(t);
-        if (ignore_comments && new_tok.kind == C_TOKEN_COMMENT) {
-            continue;
-        }
-
-        list.arr[e++] = new_tok;
-        if (t->err != T_ERR_NONE) {
-            cy_free(a, list.arr);
-            cy_mem_set(&list, 0, sizeof(list));
-            break;
-        }
-
-        list.len += 1;
-        if (new_tok.kind == C_TOKEN_EOF) {
-            break;
-        }
-    }
-
-    return list;
-}
-
-static inline CyString append_error_prefix(CyString str, TokenPos err_pos)
-{
-    return cy_string_append_fmt(str, "Erro na linha %td – ", err_pos.line);
-}
-
-static CyString tokenizer_append_error_msg(CyString msg, const Tokenizer *t)
-{
-    if (t->err == T_ERR_OUT_OF_MEMORY) {
-        return msg; // NOTE(cya): since we're out of memory
-    }
-
-    msg = append_error_prefix(msg, t->bad_tok.pos);
-
-    TokenizerError err = t->err;
-    if (err != T_ERR_INVALID_STRING && err != T_ERR_INVALID_COMMENT) {
-        msg = cy_string_append_fmt(msg, "%.*s ", STRING_ARG(t->bad_tok.str));
-    }
-
-    const char *desc = NULL;
-    switch (err) {
-    case T_ERR_INVALID_SYMBOL: {
-        desc = "símbolo inválido";
-    } break;
-    case T_ERR_INVALID_KEYWORD: {
-        desc = "palavra reservada inválida";
-    } break;
-    case T_ERR_INVALID_IDENT: {
-        desc = "identificador inválido";
-    } break;
-    case T_ERR_INVALID_STRING: {
-        desc = "constante_string inválida";
-    } break;
-    case T_ERR_INVALID_COMMENT: {
-        desc = "comentário de bloco inválido ou não finalizado";
-    } break;
-    default: {
-        desc = "(fatal) erro não reconhecido ao tokenizar código";
-    } break;
-    }
-
-    msg = cy_string_append_c(msg, desc);
-
-#if 0
-    if (t->err_desc != NULL) {
-        msg = cy_string_append_fmt(msg, " (%s)", t->err_desc);
-    }
-#endif
-
-    return msg;
-}
-
-/* ----------------------------- Parser ------------------------------------- */
-#define NON_TERMINALS \
-    NON_TERMINAL(NT_START, "<main>"), \
-\
-NON_TERMINAL(NT__INSTRUCTION_BEGIN, ""), \
-    NON_TERMINAL(NT_INSTR_LIST, "<lista_instr>"), \
-    NON_TERMINAL(NT_INSTR_LIST_R, "<lista_instr_rep>"), \
-    NON_TERMINAL(NT_INSTRUCTION, "<instrucao>"), \
-    NON_TERMINAL(NT_DEC_OR_ASSIGN, "<dec_ou_atr>"), \
-    NON_TERMINAL(NT_ASSIGN_OPT, "<atr_opt>"), \
-    NON_TERMINAL(NT_ID_LIST, "<lista_id>"), \
-    NON_TERMINAL(NT_ID_LIST_R, "<lista_id_mul>"), \
-NON_TERMINAL(NT__INSTRUCTION_END, ""), \
-\
-NON_TERMINAL(NT__COMMAND_BEGIN, ""), \
-    NON_TERMINAL(NT_CMD, "<cmd>"), \
-    NON_TERMINAL(NT_CMD_ASSIGN, "<cmd_atr>"), \
-    NON_TERMINAL(NT_CMD_INPUT, "<cmd_entr>"), \
-    NON_TERMINAL(NT_INPUT_LIST, "<lista_entr>"), \
-    NON_TERMINAL(NT_INPUT_LIST_R, "<lista_entr_mul>"), \
-    NON_TERMINAL(NT_STRING_OPT, "<cte_str_opt>"), \
-    NON_TERMINAL(NT_CMD_OUTPUT, "<cmd_saida>"), \
-    NON_TERMINAL(NT_CMD_OUTPUT_KEYWORD, "<cmd_saida_tipo>"), \
-    NON_TERMINAL(NT_CMD_COND, "<cmd_sel>"), \
-    NON_TERMINAL(NT_ELIF, "<elif>"), \
-    NON_TERMINAL(NT_ELSE, "<else>"), \
-    NON_TERMINAL(NT_CMD_LIST, "<lista_cmd>"), \
-    NON_TERMINAL(NT_CMD_LIST_R, "<lista_cmd_mul>"), \
-    NON_TERMINAL(NT_CMD_LOOP, "<cmd_rep>"), \
-    NON_TERMINAL(NT_CMD_LOOP_KEYWORD, "<cmd_rep_tipo>"), \
-NON_TERMINAL(NT__COMMAND_END, ""), \
-\
-NON_TERMINAL(NT__EXPRESSION_BEGIN, ""), \
-    NON_TERMINAL(NT_EXPR_LIST, "<lista_expr>"), \
-    NON_TERMINAL(NT_EXPR_LIST_R, "<lista_expr_mul>"), \
-    NON_TERMINAL(NT_EXPR, "<expr>"), \
-    NON_TERMINAL(NT_EXPR_LOG, "<expr_log>"), \
-    NON_TERMINAL(NT_ELEMENT, "<elemento>"), \
-    NON_TERMINAL(NT_RELATIONAL, "<relacional>"), \
-    NON_TERMINAL(NT_RELATIONAL_R, "<relacional_mul>"), \
-    NON_TERMINAL(NT_RELATIONAL_OP, "<operador_relacional>"), \
-    NON_TERMINAL(NT_ARITHMETIC, "<aritmetica>"), \
-    NON_TERMINAL(NT_ARITHMETIC_R, "<aritmetica_mul>"), \
-    NON_TERMINAL(NT_TERM, "<termo>"), \
-    NON_TERMINAL(NT_TERM_R, "<termo_mul>"), \
-    NON_TERMINAL(NT_FACTOR, "<fator>"), \
-NON_TERMINAL(NT__EXPRESSION_END, ""), \
-    NON_TERMINAL(NT_COUNT, ""),
-
-#define NT_IS_OF_CLASS(n, c) (n > NT__##c##_BEGIN && n < NT__##c##_END)
-
-typedef enum {
-#define NON_TERMINAL(e, s) e
-    NON_TERMINALS
-#undef NON_TERMINAL
-} NonTerminal;
-
-const String g_non_terminal_strings[] = {
-#define NON_TERMINAL(e, s) {(const u8*)s, CY_STATIC_STR_LEN(s)}
-    NON_TERMINALS
-#undef NON_TERMINAL
-};
-
-static inline CyString reachable_terminals(CyAllocator a, NonTerminal n);
-
-static inline CyString non_terminal_description(CyAllocator a, NonTerminal n)
-{
-    return (NT_IS_OF_CLASS(n, EXPRESSION)) ?
-        cy_string_create(a, "expressão") : reachable_terminals(a, n);
-}
-
-typedef enum {
-    GR_NONE, GR_0, GR_1, GR_2, GR_3, GR_4, GR_5, GR_6, GR_7, GR_8, GR_9, GR_10,
-    GR_11, GR_12, GR_13, GR_14, GR_15, GR_16, GR_17, GR_18, GR_19, GR_20, GR_21,
-    GR_22, GR_23, GR_24, GR_25, GR_26, GR_27, GR_28, GR_29, GR_30, GR_31, GR_32,
-    GR_33, GR_34, GR_35, GR_36, GR_37, GR_38, GR_39, GR_40, GR_41, GR_42, GR_43,
-    GR_44, GR_45, GR_46, GR_47, GR_48, GR_49, GR_50, GR_51, GR_52, GR_53, GR_54,
-    GR_55, GR_56, GR_57, GR_58, GR_59, GR_60, GR_61, GR_62, GR_63, GR_64, GR_65,
-    GR_66, GR_67, GR_68, GR_69, GR_70, GR_71, GR_72, GR_73,
-    GR_COUNT,
-} GrammarRule;
-
-CY_STATIC_ASSERT(GR_COUNT == 74 + 1);
-
-#define RULE_IS_INVALID(r) (r <= GR_NONE || r >= GR_COUNT)
-
-#define LL1_ROWS \
-    LL1_ROW(NT_START, 0), \
-    LL1_ROW(NT_INSTR_LIST, 1), \
-    LL1_ROW(NT_INSTR_LIST_R, 2), \
-    LL1_ROW(NT_INSTRUCTION, 3), \
-    LL1_ROW(NT_DEC_OR_ASSIGN, 4), \
-    LL1_ROW(NT_ASSIGN_OPT, 5), \
-    LL1_ROW(NT_ID_LIST, 6), \
-    LL1_ROW(NT_ID_LIST_R, 7), \
-    LL1_ROW(NT_CMD, 8), \
-    LL1_ROW(NT_CMD_ASSIGN, 9), \
-    LL1_ROW(NT_CMD_INPUT, 10), \
-    LL1_ROW(NT_INPUT_LIST, 11), \
-    LL1_ROW(NT_INPUT_LIST_R, 12), \
-    LL1_ROW(NT_STRING_OPT, 13), \
-    LL1_ROW(NT_CMD_OUTPUT, 14), \
-    LL1_ROW(NT_CMD_OUTPUT_KEYWORD, 15), \
-    LL1_ROW(NT_EXPR_LIST, 16), \
-    LL1_ROW(NT_EXPR_LIST_R, 17), \
-    LL1_ROW(NT_CMD_COND, 18), \
-    LL1_ROW(NT_ELIF, 19), \
-    LL1_ROW(NT_ELSE, 20), \
-    LL1_ROW(NT_CMD_LIST, 21), \
-    LL1_ROW(NT_CMD_LIST_R, 22), \
-    LL1_ROW(NT_CMD_LOOP, 23), \
-    LL1_ROW(NT_CMD_LOOP_KEYWORD, 24), \
-    LL1_ROW(NT_EXPR, 25), \
-    LL1_ROW(NT_EXPR_LOG, 26), \
-    LL1_ROW(NT_ELEMENT, 27), \
-    LL1_ROW(NT_RELATIONAL, 28), \
-    LL1_ROW(NT_RELATIONAL_R, 29), \
-    LL1_ROW(NT_RELATIONAL_OP, 30), \
-    LL1_ROW(NT_ARITHMETIC, 31), \
-    LL1_ROW(NT_ARITHMETIC_R, 32), \
-    LL1_ROW(NT_TERM, 33), \
-    LL1_ROW(NT_TERM_R, 34), \
-    LL1_ROW(NT_FACTOR, 35), \
-
-#define LL1_ROW_COUNT 36
-
-static u8 g_ll1_row_from_kind[NT_COUNT] = {
-#define LL1_ROW(n, r) [n] = r
-    LL1_ROWS
-#undef LL1_ROW
-};
-
-#define LL1_COLS \
-    LL1_COL(C_TOKEN_IDENT, 0), \
-    LL1_COL(C_TOKEN_INTEGER, 1), \
-    LL1_COL(C_TOKEN_FLOAT, 2), \
-    LL1_COL(C_TOKEN_STRING, 3), \
-    LL1_COL(C_TOKEN_SEMICOLON, 4), \
-    LL1_COL(C_TOKEN_COMMA, 5), \
-    LL1_COL(C_TOKEN_PAREN_OPEN, 6), \
-    LL1_COL(C_TOKEN_PAREN_CLOSE, 7), \
-    LL1_COL(C_TOKEN_EQUALS, 8), \
-    LL1_COL(C_TOKEN_AND, 9), \
-    LL1_COL(C_TOKEN_OR, 10), \
-    LL1_COL(C_TOKEN_NOT, 11), \
-    LL1_COL(C_TOKEN_CMP_EQ, 12), \
-    LL1_COL(C_TOKEN_CMP_NE, 13), \
-    LL1_COL(C_TOKEN_CMP_LT, 14), \
-    LL1_COL(C_TOKEN_CMP_GT, 15), \
-    LL1_COL(C_TOKEN_ADD, 16), \
-    LL1_COL(C_TOKEN_SUB, 17), \
-    LL1_COL(C_TOKEN_MUL, 18), \
-    LL1_COL(C_TOKEN_DIV, 19), \
-    LL1_COL(C_TOKEN_MAIN, 20), \
-    LL1_COL(C_TOKEN_READ, 21), \
-    LL1_COL(C_TOKEN_TRUE, 22), \
-    LL1_COL(C_TOKEN_FALSE, 23), \
-    LL1_COL(C_TOKEN_WRITE, 24), \
-    LL1_COL(C_TOKEN_WRITELN, 25), \
-    LL1_COL(C_TOKEN_IF, 26), \
-    LL1_COL(C_TOKEN_ELIF, 27), \
-    LL1_COL(C_TOKEN_ELSE, 28), \
-    LL1_COL(C_TOKEN_END, 29), \
-    LL1_COL(C_TOKEN_REPEAT, 30), \
-    LL1_COL(C_TOKEN_WHILE, 31), \
-    LL1_COL(C_TOKEN_UNTIL, 32), \
-    LL1_COL(C_TOKEN_EOF, 33), \
-
-#define LL1_COL_COUNT 34
-
-static u8 g_ll1_col_from_kind[] = {
-#define LL1_COL(k, c) [k] = c
-    LL1_COLS
-#undef LL1_COL
-};
-
-static u8 g_ll1_kind_from_col[] = {
-#define LL1_COL(k, c) [c] = k
-    LL1_COLS
-#undef LL1_COL
-};
-
-static GrammarRule g_ll1_table[LL1_ROW_COUNT][LL1_COL_COUNT] = {
-    { [20] = GR_0, },
-    {
-        [0] = GR_1, [21] = GR_1, [24] = GR_1, [25] = GR_1, [26] = GR_1,
-        [30] = GR_1,
-    },
-    {
-        [0] = GR_2, [21] = GR_2, [24] = GR_2, [25] = GR_2, [26] = GR_2,
-        [29] = GR_3, [30] = GR_2,
-    },
-    {
-        [0] = GR_4, [21] = GR_5, [24] = GR_6, [25] = GR_6, [26] = GR_8,
-        [30] = GR_7,
-    },
-    { [0] = GR_9, },
-    { [4] = GR_11, [8] = GR_10, },
-    { [0] = GR_12, },
-    { [4] = GR_14, [5] = GR_13, [8] = GR_14, },
-    {
-        [0] = GR_15, [21] = GR_16, [24] = GR_17, [25] = GR_17, [26] = GR_19,
-        [30] = GR_18,
-    },
-    { [0] = GR_20, },
-    { [21] = GR_21, },
-    { [0] = GR_22, [3] = GR_22, },
-    { [5] = GR_23, [7] = GR_24, },
-    { [0] = GR_26, [3] = GR_25, },
-    { [24] = GR_27, [25] = GR_27, },
-    { [24] = GR_28, [25] = GR_29, },
-    {
-        [0] = GR_30, [1] = GR_30, [2] = GR_30, [3] = GR_30, [6] = GR_30,
-        [11] = GR_30, [16] = GR_30, [17] = GR_30, [22] = GR_30, [23] = GR_30,
-    },
-    { [5] = GR_31, [7] = GR_32, },
-    { [26] = GR_33, },
-    { [27] = GR_34, [28] = GR_35, [29] = GR_35, },
-    { [28] = GR_36, [29] = GR_37, },
-    {
-        [0] = GR_38, [21] = GR_38, [24] = GR_38, [25] = GR_38, [26] = GR_38,
-        [30] = GR_38,
-    },
-    {
-        [0] = GR_39, [21] = GR_39, [24] = GR_39, [25] = GR_39, [26] = GR_39,
-        [27] = GR_40, [28] = GR_40, [29] = GR_40, [30] = GR_39, [31] = GR_40,
-        [32] = GR_40,
-    },
-    { [30] = GR_41, },
-    { [31] = GR_42, [32] = GR_43, },
-    {
-        [0] = GR_44, [1] = GR_44, [2] = GR_44, [3] = GR_44, [6] = GR_44,
-        [11] = GR_44, [16] = GR_44, [17] = GR_44, [22] = GR_44,  [23] = GR_44,
-    },
-    {
-        [0] = GR_47, [4] = GR_47, [5] = GR_47, [7] = GR_47, [9] = GR_45,
-        [10] = GR_46, [21] = GR_47, [24] = GR_47, [25] = GR_47, [26] = GR_47,
-        [30] = GR_47,
-    },
-    {
-        [0] = GR_48, [1] = GR_48, [2] = GR_48, [3] = GR_48, [6] = GR_48,
-        [11] = GR_51, [16] = GR_48, [17] = GR_48, [22] = GR_49, [23] = GR_50,
-    },
-    {
-        [0] = GR_52, [1] = GR_52, [2] = GR_52, [3] = GR_52, [6] = GR_52,
-        [16] = GR_52, [17] = GR_52,
-    },
-    {
-        [0] = GR_54, [4] = GR_54, [5] = GR_54, [7] = GR_54, [9] = GR_54,
-        [10] = GR_54, [12] = GR_53, [13] = GR_53, [14] = GR_53, [15] = GR_53,
-        [21] = GR_54, [24] = GR_54, [25] = GR_54, [26] = GR_54, [30] = GR_54,
-    },
-    { [12] = GR_55, [13] = GR_56, [14] = GR_57, [15] = GR_58, },
-    {
-        [0] = GR_59, [1] = GR_59, [2] = GR_59, [3] = GR_59, [6] = GR_59,
-        [16] = GR_59, [17] = GR_59,
-    },
-    {
-        [0] = GR_62, [4] = GR_62, [5] = GR_62, [7] = GR_62, [9] = GR_62,
-        [10] = GR_62, [12] = GR_62, [13] = GR_62, [14] = GR_62, [15] = GR_62,
-        [16] = GR_60, [17] = GR_61, [21] = GR_62, [24] = GR_62, [25] = GR_62,
-        [26] = GR_62, [30] = GR_62,
-    },
-    {
-        [0] = GR_63, [1] = GR_63, [2] = GR_63, [3] = GR_63, [6] = GR_63,
-        [16] = GR_63, [17] = GR_63,
-    },
-    {
-        [0] = GR_66, [4] = GR_66, [5] = GR_66, [7] = GR_66, [9] = GR_66,
-        [10] = GR_66, [12] = GR_66, [13] = GR_66, [14] = GR_66, [15] = GR_66,
-        [16] = GR_66, [17] = GR_66, [18] = GR_64, [19] = GR_65, [21] = GR_66,
-        [24] = GR_66, [25] = GR_66, [26] = GR_66, [30] = GR_66,
-    },
-    {
-        [0] = GR_67, [1] = GR_68, [2] = GR_69, [3] = GR_70, [6] = GR_71,
-        [16] = GR_72, [17] = GR_73,
-    },
-};
-
-typedef struct {
-    f64 val;
-    isize precision;
-} AstFloat;
-
-typedef enum {
-    AST_ENT_INT,
-    AST_ENT_FLOAT,
-    AST_ENT_STRING,
-    AST_ENT_BOOL,
-} AstEntityKind;
-
-typedef struct {
-    AstEntityKind kind;
-    union {
-        isize i;
-        AstFloat f;
-        String s;
-        b32 b;
-    } u;
-} AstLiteral;
-
-#define AST_KINDS \
-    AST_KIND(IDENT, struct { \
-        Token tok; \
-        AstEntityKind kind; \
-    }) \
-    AST_KIND(LITERAL, struct { \
-        Token tok; \
-        AstLiteral val; \
-    }) \
-    AST_KIND(MAIN, struct { \
-        AstNode *body; \
-    }) \
-\
-AST_KIND(_LIST_BEGIN, isize) \
-    AST_KIND(IDENT_LIST, struct { \
-        AstList list; \
-    }) \
-    AST_KIND(INPUT_LIST, struct { \
-        AstList list; \
-    }) \
-    AST_KIND(EXPR_LIST, struct { \
-        AstList list; \
-    }) \
-    AST_KIND(STMT_LIST, struct { \
-        AstList list; \
-    }) \
-    AST_KIND(INPUT_ARG, struct { \
-        AstNode *prompt; \
-        AstNode *ident; \
-    }) \
-    AST_KIND(INPUT_PROMPT, struct { \
-        Token string; \
-    }) \
-    AST_KIND(VAR_DECL, struct { \
-        AstNode *ident_list; \
-    }) \
-AST_KIND(_LIST_END, isize) \
-\
-AST_KIND(_STMT_BEGIN, isize) \
-    AST_KIND(ASSIGN_STMT, struct { \
-        AstNode *ident_list; \
-        AstNode *expr; \
-    }) \
-    AST_KIND(READ_STMT, struct { \
-        AstNode *input_list; \
-    }) \
-    AST_KIND(WRITE_STMT, struct { \
-        Token keyword; \
-        AstNode *expr_list; \
-    }) \
-    AST_KIND(IF_STMT, struct { \
-        AstNode *body; \
-        AstNode *cond; \
-        AstNode *else_stmt; \
-        b32 is_root; \
-    }) \
-    AST_KIND(REPEAT_STMT, struct { \
-        AstNode *body; \
-        Token keyword; \
-        AstNode *expr; \
-    }) \
-AST_KIND(_STMT_END, isize) \
-\
-AST_KIND(_EXPR_BEGIN, isize) \
-    AST_KIND(BINARY_EXPR, struct { \
-        AstNode *left; \
-        AstNode *right; \
-        Token op; \
-    }) \
-    AST_KIND(UNARY_EXPR, struct { \
-        AstNode *expr; \
-        Token op; \
-    }) \
-    AST_KIND(PAREN_EXPR, struct { \
-        AstNode *expr; \
-    }) \
-AST_KIND(_EXPR_END, isize) \
-    AST_KIND(KIND_COUNT, isize)
-
-#define IS_IN_RANGE_IN(n, lo, hi) (n >= lo && n <= hi)
-#define IS_IN_RANGE_EX(n, lo, hi) (n > lo && n < hi)
-
-#define AST_KIND_IS_OF_CLASS(kind, c) \
-    IS_IN_RANGE_EX(kind, AST_KIND__##c##_BEGIN, AST_KIND__##c##_END)
-
-#define AST_KIND_PREFIX(t) AST_KIND_##t
-typedef enum {
-#define AST_KIND(e, ...) AST_KIND_PREFIX(e),
-    AST_KINDS
-#undef AST_KIND
-} AstKind;
-
-typedef struct AstNode AstNode;
-
-typedef struct {
-    CyAllocator alloc;
-    AstNode **data;
-    isize len;
-    isize cap;
-} AstList;
-
-#define AST_LIST_INIT_CAP 0x10
-
-#define AST_PREFIX(t) AST_##t
-#define AST_KIND(t, s) typedef s AST_PREFIX(t);
-    AST_KINDS
-#undef AST_KIND
-
-struct AstNode {
-    AstKind kind;
-    union {
-#define AST_KIND(t, ...) AST_PREFIX(t) t;
-        AST_KINDS
-#undef AST_KIND
-    } u;
-};
-
-typedef struct {
-    CyAllocator alloc;
-    AstNode *root;
-} Ast;
-
-#define AST_NODE_ALLOC(alloc, k) ast_node_alloc(alloc, AST_KIND_PREFIX(k))
-
-static inline AstNode *ast_node_alloc(CyAllocator a, AstKind kind)
-{
-    AstNode *node = cy_alloc(a, sizeof(AstNode));
-    CY_VALIDATE_PTR(node);
-
-    node->kind = kind;
-    return node;
-}
-
-static inline AstList ast_list_init(CyAllocator a)
-{
-    isize cap = AST_LIST_INIT_CAP;
-    AstNode **data = cy_alloc(a, cap * sizeof(AstNode*));
-    return (AstList){
-        .alloc = a,
-        .data = data,
-        .cap = data == NULL ? 0 : cap,
-    };
-}
-
-#define AST_LIST_CREATE(alloc, _list, new, _kind) { \
-    new = *_list; \
-    if (*_list == NULL) { \
-        new = AST_NODE_ALLOC(alloc, _kind); \
-        new->u._kind.list = ast_list_init(alloc); \
-        *_list = new; \
-    }  \
-} (void)0
-
-static inline void ast_list_append_node(AstList *l, AstNode *node)
-{
-    if (l->len == l->cap) {
-        isize new_cap = l->cap * 2;
-        AstNode **new = cy_resize(
-            l->alloc, l->data,
-            l->cap * sizeof(AstNode*), new_cap * sizeof(AstNode*)
-        );
-        l->data = new;
-        l->cap = new_cap;
-    }
-
-    l->data[l->len++] = node;
-}
-
-static inline AstNode *ast_list_get_last_node(AstList *l)
-{
-    return l->data[l->len - 1];
-}
-
-static inline void ast_list_shrink(AstList *l)
-{
-    if (l->len == l->cap) {
-        return;
-    }
-
-    isize new_cap = l->len;
-    AstNode **new = cy_resize(
-        l->alloc, l->data,
-        l->cap * sizeof(AstNode*), new_cap * sizeof(AstNode*)
-    );
-    l->data = new;
-    l->cap = new_cap;
-}
-
-static inline void ast_expr_insert_node(AstNode *expr, AstNode *node)
-{
-    switch (expr->kind) {
-    case AST_KIND_UNARY_EXPR:
-    case AST_KIND_PAREN_EXPR: {
-        AST_PAREN_EXPR *e = &expr->u.PAREN_EXPR;
-        CY_ASSERT(e->expr == NULL);
-
-        e->expr = node;
-    } break;
-    case AST_KIND_BINARY_EXPR: {
-        AST_BINARY_EXPR *e = &expr->u.BINARY_EXPR;
-        CY_ASSERT(e->left == NULL || e->right == NULL);
-
-        if (e->left == NULL) {
-            e->left = node;
-        } else {
-            e->right = node;
-        }
-    } break;
-    default: break;
-    }
-}
-
-static inline AstEntityKind ast_entity_kind_from_ident(Token *ident_tok)
-{
-    String ident = ident_tok->str;
-    AstEntityKind kind = -1;
-    if (cy_string_view_has_prefix(ident, "i_")) {
-        kind = AST_ENT_INT;
-    } else if (cy_string_view_has_prefix(ident, "f_")) {
-        kind = AST_ENT_FLOAT;
-    } else if (cy_string_view_has_prefix(ident, "b_")) {
-        kind = AST_ENT_BOOL;
-    } else {
-        kind = AST_ENT_STRING;
-    }
-
-    return kind;
-}
-
-static inline AstEntityKind ast_expr_determine_kind(AstNode *expr)
-{
-    AstEntityKind kind = -1;
-    AstKind expr_kind = expr->kind;
-    switch (expr_kind) {
-    case AST_KIND_BINARY_EXPR: {
-        AstEntityKind lhs = ast_expr_determine_kind(expr->u.BINARY_EXPR.left);
-        AstEntityKind rhs = ast_expr_determine_kind(expr->u.BINARY_EXPR.right);
-
-        Token op = expr->u.BINARY_EXPR.op;
-        switch (op.kind) {
-        case C_TOKEN_ADD:
-        case C_TOKEN_SUB:
-        case C_TOKEN_MUL: {
-            if (lhs == AST_ENT_INT && rhs == AST_ENT_INT) {
-                kind = AST_ENT_INT;
-            } else {
-                kind = AST_ENT_FLOAT;
-            }
-        } break;
-        case C_TOKEN_DIV: {
-            kind = AST_ENT_FLOAT;
-        } break;
-        case C_TOKEN_CMP_EQ:
-        case C_TOKEN_CMP_NE:
-        case C_TOKEN_CMP_GT:
-        case C_TOKEN_CMP_LT: {
-            kind = lhs;
-        } break;
-        case C_TOKEN_AND:
-        case C_TOKEN_OR: {
-            kind = AST_ENT_BOOL;
-        } break;
-        default: break;
-        }
-    } break;
-    case AST_KIND_UNARY_EXPR: {
-        if (expr->u.UNARY_EXPR.op.kind == C_TOKEN_NOT) {
-            kind = AST_ENT_BOOL;
-        } else {
-            kind = ast_expr_determine_kind(expr->u.UNARY_EXPR.expr);
-        }
-    } break;
-    case AST_KIND_PAREN_EXPR: {
-        kind = ast_expr_determine_kind(expr->u.PAREN_EXPR.expr);
-    } break;
-    case AST_KIND_IDENT: {
-        kind = ast_entity_kind_from_ident(&expr->u.IDENT.tok);
-    } break;
-    case AST_KIND_LITERAL: {
-        kind = expr->u.LITERAL.val.kind;
-    } break;
-    default: break;
-    }
-
-    return kind;
-}
-
-static inline void ast_binary_expr_reduce(CyAllocator a, AstNode *expr)
-{
-    CY_ASSERT(expr->kind == AST_KIND_BINARY_EXPR);
-
-    AST_BINARY_EXPR *e = &expr->u.BINARY_EXPR;
-    CY_ASSERT(e->right == NULL);
-
-    AstNode *child = e->left;
-    // if (child->kind == AST_KIND_BINARY_EXPR) {
-    //     child->u.BINARY_EXPR.op = e->op;
-    // }
-
-    cy_mem_copy(expr, child, sizeof(*expr));
-    cy_free(a, child);
-}
-
-static inline isize parse_int(const Token *tok)
-{
-    CY_ASSERT(tok->kind == C_TOKEN_INTEGER);
-
-    isize res = 0;
-    const u8 *start = tok->str.text, *cur = start + tok->str.len - 1;
-    for (isize mul = 1; cur >= start; mul *= 10) {
-        res += (*cur-- - '0') * mul;
-    }
-
-    return res;
-}
-
-static inline f64 pow(f64 n, f64 exp)
-{
-    f64 mul = n;
-    while (--exp) {
-        n *= mul;
-    }
-
-    return n;
- }
-
-static inline AstFloat parse_float(const Token *tok)
-{
-    CY_ASSERT(tok->kind == C_TOKEN_FLOAT);
-
-    isize len = 0;
-    const u8 *start, *end;
-    end = start = tok->str.text;
-    while (*end != ',') {
-        end += 1, len += 1;
-    }
-
-    f64 whole_part = (f64)parse_int(&(Token){
-        .kind = C_TOKEN_INTEGER,
-        .str = cy_string_view_create_len((const char*)start, len),
-    });
-
-    f64 div = 10.0;
-    start = end + 1;
-    end = tok->str.text + tok->str.len;
-
-    len = end - start;
-    f64 decimal_part = (f64)parse_int(&(Token){
-        .kind = C_TOKEN_INTEGER,
-        .str = cy_string_view_create_len((const char*)start, len),
-    });
-
-    return (AstFloat){
-        .val = whole_part + decimal_part / pow(div, len),
-        .precision = len,
-    };
-}
-
-static inline void ast_node_read_token(AstNode *node, Token *tok)
-{
-    if (node == NULL) {
-        return;
-    }
-
-    Token *dest = NULL;
-    switch (node->kind) {
-    case AST_KIND_IDENT_LIST: {
-        if (tok->kind != C_TOKEN_IDENT) {
-            return;
-        }
-
-        AstNode *ident_node = ast_list_get_last_node(&node->u.IDENT_LIST.list);
-        ident_node->u.IDENT.kind = ast_entity_kind_from_ident(tok);
-        dest = &ident_node->u.IDENT.tok;
-    } break;
-    case AST_KIND_INPUT_LIST: {
-        if (tok->kind != C_TOKEN_IDENT) {
-            return;
-        }
-
-        AstNode *arg_node = ast_list_get_last_node(&node->u.INPUT_LIST.list);
-        arg_node->u.INPUT_ARG.ident->u.IDENT.kind =
-            ast_entity_kind_from_ident(tok);
-        dest = &arg_node->u.INPUT_ARG.ident->u.IDENT.tok;
-    } break;
-    case AST_KIND_INPUT_PROMPT: {
-        if (tok->kind != C_TOKEN_STRING) {
-            return;
-        }
-
-        dest = &node->u.INPUT_PROMPT.string;
-    } break;
-    case AST_KIND_WRITE_STMT: {
-        if (!IS_IN_RANGE_IN(tok->kind, C_TOKEN_WRITE, C_TOKEN_WRITELN)) {
-            return;
-        }
-
-        dest = &node->u.WRITE_STMT.keyword;
-    } break;
-    case AST_KIND_REPEAT_STMT: {
-        if (!IS_IN_RANGE_IN(tok->kind, C_TOKEN_UNTIL, C_TOKEN_WHILE)) {
-            return;
-        }
-
-        dest = &node->u.REPEAT_STMT.keyword;
-    } break;
-    case AST_KIND_LITERAL: {
-        switch (tok->kind) {
-        case C_TOKEN_INTEGER: {
-            node->u.LITERAL.val.kind = AST_ENT_INT;
-            node->u.LITERAL.val.u.i = parse_int(tok);
-        } break;
-        case C_TOKEN_FLOAT: {
-            node->u.LITERAL.val.kind = AST_ENT_FLOAT;
-            node->u.LITERAL.val.u.f = parse_float(tok);
-        } break;
-        case C_TOKEN_STRING: {
-            node->u.LITERAL.val.kind = AST_ENT_STRING;
-            node->u.LITERAL.val.u.s = tok->str;
-        } break;
-        case C_TOKEN_TRUE: {
-            node->u.LITERAL.val.kind = AST_ENT_BOOL;
-            node->u.LITERAL.val.u.b = true;
-        } break;
-        case C_TOKEN_FALSE: {
-            node->u.LITERAL.val.kind = AST_ENT_BOOL;
-            node->u.LITERAL.val.u.b = false;
-        } break;
-        default: return;
-        }
-
-        dest = &node->u.LITERAL.tok;
-    } break;
-    case AST_KIND_IDENT: {
-        if (tok->kind != C_TOKEN_IDENT) {
-            return;
-        }
-
-        node->u.IDENT.kind = ast_entity_kind_from_ident(tok);
-        dest = &node->u.IDENT.tok;
-    } break;
-    case AST_KIND_UNARY_EXPR: {
-        dest = &node->u.UNARY_EXPR.op;
-    } break;
-    default: return;
-    }
-
-    cy_mem_copy(dest, tok, sizeof(*dest));
-}
-
-typedef struct {
-    AstNode *ast_entry;
-    b32 is_frame_start;
-    enum {
-        PARSER_KIND_TOKEN,
-        PARSER_KIND_NON_TERMINAL,
-    } kind;
-    union {
-        Token token;
-        NonTerminal non_terminal;
-    } u;
-} ParserSymbol;
-
-typedef struct {
-    CyAllocator alloc;
-    ParserSymbol *items;
-    isize len;
-    isize cap;
-} ParserStack;
-
-// NOTE(cya): equivalent to alignof(ParserSymbol)
-#define PARSER_STACK_ALIGN (sizeof(Token))
-
-typedef enum {
-    P_ERR_OUT_OF_MEMORY = -1,
-    P_ERR_NONE,
-    P_ERR_REACHED_EOF,
-    P_ERR_UNEXPECTED_TOKEN,
-    P_ERR_INVALID_RULE,
-} ParserErrorKind;
-
-typedef struct {
-    ParserErrorKind kind;
-    ParserSymbol expected;
-    Token found;
-} ParserError;
-
-typedef struct {
-    Token *read_tok;
-    ParserStack stack;
-    Ast ast;
-    AstNode *cur_node;
-    ParserError err;
-} Parser;
-
-static void parser_error(Parser *p, ParserErrorKind kind);
-static inline ParserSymbol *parser_stack_peek(Parser *p);
-
-static inline void parser_stack_push(
-    Parser *p, ParserSymbol item, AstNode *ast_entry
-) {
-    if (p->stack.len == p->stack.cap) {
-        isize old_size = p->stack.cap * sizeof(*p->stack.items);
-        isize new_size = old_size * 2;
-        ParserSymbol *items = cy_resize_align(
-            p->stack.alloc, p->stack.items,
-            old_size, new_size,
-            PARSER_STACK_ALIGN
-        );
-        if (items == NULL) {
-            parser_error(p, P_ERR_OUT_OF_MEMORY);
-            return;
-        }
-
-        p->stack.items = items;
-        p->stack.cap *= 2;
-    }
-
-    item.ast_entry = ast_entry == NULL ? p->cur_node : ast_entry;
-    p->stack.items[p->stack.len++] = item;
-}
-
-static inline void parser_stack_push_token(
-    Parser *p, TokenKind kind, AstNode *ast_entry
-) {
-    parser_stack_push(p, (ParserSymbol){
-        .kind = PARSER_KIND_TOKEN,
-        .u.token = (Token){.kind = kind, .str = g_token_strings[kind]},
-    }, ast_entry);
-}
-
-static inline void parser_stack_push_non_terminal(
-    Parser *p, NonTerminal n, AstNode *ast_entry
-) {
-    parser_stack_push(p, (ParserSymbol){
-        .kind = PARSER_KIND_NON_TERMINAL,
-        .u.non_terminal = n,
-    }, ast_entry);
-}
-
-static inline void parser_stack_pop(Parser *p)
-{
-    if (p->stack.len <= 0) {
-        return;
-    }
-
-    ParserSymbol *top = &p->stack.items[--p->stack.len];
-    cy_mem_set(top, 0, sizeof(*top));
-}
-
-static inline ParserSymbol *parser_stack_peek(Parser *p)
-{
-    CY_VALIDATE_PTR(p);
-    return (p->stack.len > 0) ? &p->stack.items[p->stack.len - 1] : NULL;
-}
-
-static inline b32 parser_stack_is_empty(Parser *p)
-{
-    return p->stack.len < 1;
-}
-
-static inline void parser_stack_mark_top_as_frame(Parser *p)
-{
-    ParserSymbol *s = parser_stack_peek(p);
-    s->is_frame_start = true;
-}
-
-static inline void parser_error(Parser *p, ParserErrorKind kind)
-{
-    if (p == NULL) {
-        return;
-    }
-
-    p->err = (ParserError){
-        .kind = kind,
-        .expected = *(parser_stack_peek(p)),
-        .found = *p->read_tok,
-    };
-}
-
-static CyString reachable_terminals(CyAllocator a, NonTerminal n)
-{
-    CyString str = cy_string_create_reserve(a, 0x20);
-    u8 table_row = g_ll1_row_from_kind[n];
-    GrammarRule *ll1_row = g_ll1_table[table_row];
-    for (isize i = 0; i < LL1_COL_COUNT; i++) {
-        if (ll1_row[i] == GR_NONE) {
-            continue;
-        }
-
-        TokenKind kind = g_ll1_kind_from_col[i];
-        String s = g_token_strings[kind];
-        str = cy_string_append_fmt(str, "%.*s ", STRING_ARG(s));
-    }
-
-    int len = cy_string_len(str);
-    str[len - 1] = '\0';
-    cy__string_set_len(str, len - 1);
-    str = cy_string_shrink(str);
-
-    return str;
-}
-
-static CyString parser_append_error_msg(CyString msg, Parser *p)
-{
-    msg = append_error_prefix(msg, p->err.found.pos);
-
-    CyAllocator a = CY_STRING_HEADER(msg)->alloc;
-    Token found = p->err.found;
-    String found_str;
-    switch (found.kind) {
-    case C_TOKEN_EOF:
-    case C_TOKEN_STRING: {
-        found_str = g_token_strings[found.kind];
-    } break;
-    default: {
-        found_str = found.str;
-    } break;
-    }
-
-    ParserSymbol expected = p->err.expected;
-    CyString expected_str = NULL;
-    switch (expected.kind) {
-    case PARSER_KIND_TOKEN: {
-        switch (expected.u.token.kind) {
-        case C_TOKEN_IDENT:
-        case C_TOKEN_INTEGER:
-        case C_TOKEN_FLOAT:
-        case C_TOKEN_STRING: {
-            expected_str = cy_string_from_token_kind(a, expected.u.token.kind);
-        } break;
-        default: {
-            expected_str = cy_string_create_view(a, expected.u.token.str);
-        } break;
-        }
-    } break;
-    case PARSER_KIND_NON_TERMINAL: {
-        expected_str = non_terminal_description(a, expected.u.non_terminal);
-    } break;
-    }
-
-    msg = cy_string_append_fmt(
-        msg, "encontrado %.*s esperado %s",
-        STRING_ARG(found_str),
-        expected_str
-    );
-    cy_string_free(expected_str);
-
-    return msg;
-}
-
-static Parser parser_init(CyAllocator stack_allocator, const TokenList *l)
-{
-    ParserSymbol *items = NULL;
-    isize cap = CY_MAX(l->len, 0x10);
-    isize size = cap * sizeof(*items);
-    items = cy_alloc_align(stack_allocator, size, PARSER_STACK_ALIGN);
-    if (items == NULL) {
-        return (Parser){ .err.kind = P_ERR_OUT_OF_MEMORY, };
-    }
-
-    Parser p = {
-        .read_tok = l->arr,
-        .stack = (ParserStack){
-            .alloc = stack_allocator,
-            .items = items,
-            .cap = cap,
-        },
-    };
-    parser_stack_push_token(&p, C_TOKEN_EOF, NULL);
-    parser_stack_push_non_terminal(&p, NT_START, NULL);
-
-    return p;
-}
-
-static Ast parse(CyAllocator a, Parser *p)
-{
-    p->ast = (Ast){.alloc = a};
-    for (;;) {
-        if (p->err.kind != P_ERR_NONE) {
-            break;
-        } else if (p->read_tok->kind == C_TOKEN_COMMENT) {
-            p->read_tok += 1;
-            continue;
-        }
-
-        ParserSymbol *stack_top = parser_stack_peek(p);
-        if (stack_top->kind == PARSER_KIND_TOKEN) {
-            TokenKind kind = stack_top->u.token.kind;
-            if (kind != p->read_tok->kind) {
-                parser_error(p, P_ERR_UNEXPECTED_TOKEN);
-                break;
-            } else if (kind == C_TOKEN_EOF) {
-                break;
-            }
-
-            ast_node_read_token(p->cur_node, p->read_tok);
-            parser_stack_pop(p);
-
-            p->read_tok += 1;
-            continue;
-        } else if (stack_top->is_frame_start) {
-            parser_stack_pop(p);
-            if (!parser_stack_is_empty(p)) {
-                p->cur_node = parser_stack_peek(p)->ast_entry;
-            }
-
-            continue;
-        }
-
-        u8 table_row = g_ll1_row_from_kind[stack_top->u.non_terminal];
-        u8 table_col = g_ll1_col_from_kind[p->read_tok->kind];
-        GrammarRule rule = g_ll1_table[table_row][table_col];
-        if (RULE_IS_INVALID(rule)) {
-            parser_error(p, P_ERR_INVALID_RULE);
-            break;
-        }
-
-        parser_stack_mark_top_as_frame(p);
-
-        AstNode *new_node = p->cur_node;
-        switch (rule) {
-        case GR_0: { // <inicio> ::= main <lista_instr> end
-            parser_stack_push_token(p, C_TOKEN_END, NULL);
-            parser_stack_push_non_terminal(p, NT_INSTR_LIST, NULL);
-            parser_stack_push_token(p, C_TOKEN_MAIN, NULL);
-
-            CY_ASSERT(p->cur_node == NULL);
-
-            new_node = AST_NODE_ALLOC(a, MAIN);
-            p->ast.root = new_node;
-        } break;
-        case GR_1: { // <lista_instr> ::= <instrucao> ";" <lista_instr_rep>
-            parser_stack_push_non_terminal(p, NT_INSTR_LIST_R, NULL);
-            parser_stack_push_token(p, C_TOKEN_SEMICOLON, NULL);
-            parser_stack_push_non_terminal(p, NT_INSTRUCTION, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_MAIN);
-
-            AstNode **body = &(p->cur_node->u.MAIN.body);
-            AST_LIST_CREATE(a, body, new_node, STMT_LIST);
-        } break;
-        case GR_2: { // <lista_instr_rep> ::= <lista_instr>
-            parser_stack_push_non_terminal(p, NT_INSTR_LIST, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_MAIN);
-        } break;
-        case GR_3: { // <lista_instr_rep> ::= î
-            CY_ASSERT(p->cur_node->kind == AST_KIND_MAIN);
-
-            AstList *l = &p->cur_node->u.MAIN.body->u.STMT_LIST.list;
-            ast_list_shrink(l);
-        } break;
-        case GR_4: { // <instrucao> ::= <dec_ou_atr>
-            parser_stack_push_non_terminal(p, NT_DEC_OR_ASSIGN, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_STMT_LIST);
-
-            // NOTE(cya): assuming assignment first
-            AstList *l = &p->cur_node->u.STMT_LIST.list;
-            new_node = AST_NODE_ALLOC(a, ASSIGN_STMT);
-            ast_list_append_node(l, new_node);
-        } break;
-        case GR_5: { // <instrucao> ::= <cmd_entr>
-            parser_stack_push_non_terminal(p, NT_CMD_INPUT, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_STMT_LIST);
-
-            AstList *l = &p->cur_node->u.STMT_LIST.list;
-            new_node = AST_NODE_ALLOC(a, READ_STMT);
-            ast_list_append_node(l, new_node);
-        } break;
-        case GR_6: { // <instrucao> ::= <cmd_saida>
-            parser_stack_push_non_terminal(p, NT_CMD_OUTPUT, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_STMT_LIST);
-
-            AstList *l = &p->cur_node->u.STMT_LIST.list;
-            new_node = AST_NODE_ALLOC(a, WRITE_STMT);
-            ast_list_append_node(l, new_node);
-        } break;
-        case GR_7: { // <instrucao> ::= <cmd_rep>
-            parser_stack_push_non_terminal(p, NT_CMD_LOOP, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_STMT_LIST);
-
-            AstList *l = &p->cur_node->u.STMT_LIST.list;
-            new_node = AST_NODE_ALLOC(a, REPEAT_STMT);
-            ast_list_append_node(l, new_node);
-        } break;
-        case GR_8: { // <instrucao> ::= <cmd_sel>
-            parser_stack_push_non_terminal(p, NT_CMD_COND, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_STMT_LIST);
-
-            AstList *l = &p->cur_node->u.STMT_LIST.list;
-            new_node = AST_NODE_ALLOC(a, IF_STMT);
-            ast_list_append_node(l, new_node);
-        } break;
-        case GR_9: { // <dec_ou_atr> ::= <lista_id> <atr_opt>
-            parser_stack_push_non_terminal(p, NT_ASSIGN_OPT, NULL);
-            parser_stack_push_non_terminal(p, NT_ID_LIST, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_ASSIGN_STMT);
-
-            AstNode **ident_list = &p->cur_node->u.ASSIGN_STMT.ident_list;
-            AST_LIST_CREATE(a, ident_list, new_node, IDENT_LIST);
-        } break;
-        case GR_10: { // <atr_opt> ::= "=" <expr>
-            parser_stack_push_non_terminal(p, NT_EXPR, NULL);
-            parser_stack_push_token(p, C_TOKEN_EQUALS, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_ASSIGN_STMT);
-        } break;
-        case GR_11: { // <atr_opt> ::= î
-            CY_ASSERT(p->cur_node->kind == AST_KIND_ASSIGN_STMT);
-
-            p->cur_node->kind = AST_KIND_VAR_DECL;
-        } break;
-        case GR_12: { // <lista_id> ::= identificador <lista_id_mul>
-            parser_stack_push_non_terminal(p, NT_ID_LIST_R, NULL);
-            parser_stack_push_token(p, C_TOKEN_IDENT, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_IDENT_LIST);
-
-            AstNode *ident_node = AST_NODE_ALLOC(a, IDENT);
-            AstList *l = &p->cur_node->u.IDENT_LIST.list;
-            ast_list_append_node(l, ident_node);
-        } break;
-        case GR_13: { // <lista_id_mul> ::= "," <lista_id>
-            parser_stack_push_non_terminal(p, NT_ID_LIST, NULL);
-            parser_stack_push_token(p, C_TOKEN_COMMA, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_IDENT_LIST);
-        } break;
-        case GR_14: { // <lista_id_mul> ::= î
-            CY_ASSERT(p->cur_node->kind == AST_KIND_IDENT_LIST);
-
-            AstList *l = &p->cur_node->u.IDENT_LIST.list;
-            ast_list_shrink(l);
-        } break;
-        case GR_15: { // <cmd> ::= <cmd_atr>
-            parser_stack_push_non_terminal(p, NT_CMD_ASSIGN, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_STMT_LIST);
-
-            AstList *l = &p->cur_node->u.STMT_LIST.list;
-            new_node = AST_NODE_ALLOC(a, ASSIGN_STMT);
-            ast_list_append_node(l, new_node);
-        } break;
-        case GR_16: { // <cmd> ::= <cmd_entr>
-            parser_stack_push_non_terminal(p, NT_CMD_INPUT, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_STMT_LIST);
-
-            AstList *l = &p->cur_node->u.STMT_LIST.list;
-            new_node = AST_NODE_ALLOC(a, READ_STMT);
-            ast_list_append_node(l, new_node);
-        } break;
-         case GR_17: { // <cmd> ::= <cmd_saida>
-            parser_stack_push_non_terminal(p, NT_CMD_OUTPUT, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_STMT_LIST);
-
-            AstList *l = &p->cur_node->u.STMT_LIST.list;
-            new_node = AST_NODE_ALLOC(a, WRITE_STMT);
-            ast_list_append_node(l, new_node);
-        } break;
-        case GR_18: { // <cmd> ::= <cmd_rep>
-            parser_stack_push_non_terminal(p, NT_CMD_LOOP, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_STMT_LIST);
-
-            AstList *l = &p->cur_node->u.STMT_LIST.list;
-            new_node = AST_NODE_ALLOC(a, REPEAT_STMT);
-            ast_list_append_node(l, new_node);
-        } break;
-        case GR_19: { // <cmd> ::= <cmd_sel>
-            parser_stack_push_non_terminal(p, NT_CMD_COND, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_STMT_LIST);
-
-            AstList *l = &p->cur_node->u.STMT_LIST.list;
-            new_node = AST_NODE_ALLOC(a, IF_STMT);
-            ast_list_append_node(l, new_node);
-        } break;
-        case GR_20: { // <cmd_atr> ::= <lista_id> "=" <expr>
-            parser_stack_push_non_terminal(p, NT_EXPR, NULL);
-            parser_stack_push_token(p, C_TOKEN_EQUALS, NULL);
-            parser_stack_push_non_terminal(p, NT_ID_LIST, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_ASSIGN_STMT);
-
-            AstNode **ident_list = &p->cur_node->u.ASSIGN_STMT.ident_list;
-            AST_LIST_CREATE(a, ident_list, new_node, IDENT_LIST);
-        } break;
-        case GR_21: { // <cmd_entr> ::= read "(" <lista_entr> ")"
-            parser_stack_push_token(p, C_TOKEN_PAREN_CLOSE, NULL);
-            parser_stack_push_non_terminal(p, NT_INPUT_LIST, NULL);
-            parser_stack_push_token(p, C_TOKEN_PAREN_OPEN, NULL);
-            parser_stack_push_token(p, C_TOKEN_READ, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_READ_STMT);
-
-            AstNode **input_list = &(p->cur_node->u.READ_STMT.input_list);
-            AST_LIST_CREATE(a, input_list, new_node, INPUT_LIST);
-        } break;
-        case GR_22: { // <lista_entr> ::= <cte_str_opt> id <lista_entr_mul>
-            parser_stack_push_non_terminal(p, NT_INPUT_LIST_R, NULL);
-            parser_stack_push_token(p, C_TOKEN_IDENT, NULL);
-            parser_stack_push_non_terminal(p, NT_STRING_OPT, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_INPUT_LIST);
-
-            new_node = AST_NODE_ALLOC(a, INPUT_ARG);
-            new_node->u.INPUT_ARG.ident = AST_NODE_ALLOC(a, IDENT);
-
-            AstList *l = &p->cur_node->u.INPUT_LIST.list;
-            ast_list_append_node(l, new_node);
-        } break;
-        case GR_23: { // <lista_entr_mul> ::= "," <lista_entr>
-            parser_stack_push_non_terminal(p, NT_INPUT_LIST, NULL);
-            parser_stack_push_token(p, C_TOKEN_COMMA, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_INPUT_LIST);
-        } break;
-        case GR_24: { // <lista_entr_mul> ::= î
-            CY_ASSERT(p->cur_node->kind == AST_KIND_INPUT_LIST);
-
-            AstList *l = &p->cur_node->u.INPUT_LIST.list;
-            ast_list_shrink(l);
-        } break;
-        case GR_25: { // <cte_str_opt> ::= constante_string ","
-            parser_stack_push_token(p, C_TOKEN_COMMA, NULL);
-            parser_stack_push_token(p, C_TOKEN_STRING, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_INPUT_ARG);
-
-            new_node = AST_NODE_ALLOC(a, INPUT_PROMPT);
-            p->cur_node->u.INPUT_ARG.prompt = new_node;
-        } break;
-        case GR_26: { // <cte_str_opt> ::= î
-            CY_ASSERT(p->cur_node->kind == AST_KIND_INPUT_ARG);
-        } break;
-        case GR_27: { // <cmd_saida> ::= <cmd_saida_tipo> "(" <lista_expr> ")"
-            parser_stack_push_token(p, C_TOKEN_PAREN_CLOSE, NULL);
-            parser_stack_push_non_terminal(p, NT_EXPR_LIST, NULL);
-            parser_stack_push_token(p, C_TOKEN_PAREN_OPEN, NULL);
-            parser_stack_push_non_terminal(p, NT_CMD_OUTPUT_KEYWORD, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_WRITE_STMT);
-        } break;
-        case GR_28: { // <cmd_saida_tipo> ::= write
-            parser_stack_push_token(p, C_TOKEN_WRITE, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_WRITE_STMT);
-        } break;
-        case GR_29: { // <cmd_saida_tipo> ::= writeln
-            parser_stack_push_token(p, C_TOKEN_WRITELN, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_WRITE_STMT);
-        } break;
-        case GR_30: { // <lista_expr> ::= <expr> <lista_expr_mul>
-            parser_stack_push_non_terminal(p, NT_EXPR_LIST_R, NULL);
-            parser_stack_push_non_terminal(p, NT_EXPR, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_WRITE_STMT);
-
-            AstNode **expr_list = &p->cur_node->u.WRITE_STMT.expr_list;
-            AST_LIST_CREATE(a, expr_list, new_node, EXPR_LIST);
-        } break;
-        case GR_31: { // <lista_expr_mul> ::= "," <lista_expr>
-            parser_stack_push_non_terminal(p, NT_EXPR_LIST, NULL);
-            parser_stack_push_token(p, C_TOKEN_COMMA, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_WRITE_STMT);
-        } break;
-        case GR_32: { // <lista_expr_mul> ::= î
-            CY_ASSERT(p->cur_node->kind == AST_KIND_WRITE_STMT);
-
-            AstList *l = &p->cur_node->u.WRITE_STMT.expr_list->u.EXPR_LIST.list;
-            ast_list_shrink(l);
-        } break;
-        case GR_33: { // <cmd_sel> ::= if <expr> <lista_cmd> <elif> <else> end
-            parser_stack_push_token(p, C_TOKEN_END, NULL);
-            parser_stack_push_non_terminal(p, NT_ELSE, NULL);
-            parser_stack_push_non_terminal(p, NT_ELIF, NULL);
-            parser_stack_push_non_terminal(p, NT_CMD_LIST, NULL);
-            parser_stack_push_non_terminal(p, NT_EXPR, NULL);
-            parser_stack_push_token(p, C_TOKEN_IF, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_IF_STMT);
-
-            p->cur_node->u.IF_STMT.is_root = true;
-        } break;
-        case GR_34: { // <elif> ::= elif <expr> <lista_cmd> <elif>
-            new_node = AST_NODE_ALLOC(a, IF_STMT);
-
-            parser_stack_push_non_terminal(p, NT_ELIF, new_node);
-            parser_stack_push_non_terminal(p, NT_CMD_LIST, new_node);
-            parser_stack_push_non_terminal(p, NT_EXPR, new_node);
-            parser_stack_push_token(p, C_TOKEN_ELIF, new_node);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_IF_STMT);
-
-            AstNode *else_stmt = p->cur_node->u.IF_STMT.else_stmt;
-            while (else_stmt != NULL) {
-                p->cur_node = else_stmt;
-                else_stmt = p->cur_node->u.IF_STMT.else_stmt;
-            }
-
-            p->cur_node->u.IF_STMT.else_stmt = new_node;
-        } break;
-        case GR_35: { // <elif> ::= î
-            CY_ASSERT(p->cur_node->kind == AST_KIND_IF_STMT);
-        } break;
-        case GR_36: { // <else> ::= else <lista_cmd>
-            new_node = AST_NODE_ALLOC(a, IF_STMT);
-
-            parser_stack_push_non_terminal(p, NT_CMD_LIST, new_node);
-            parser_stack_push_token(p, C_TOKEN_ELSE, new_node);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_IF_STMT);
-
-            AstNode *else_stmt = p->cur_node->u.IF_STMT.else_stmt;
-            while (else_stmt != NULL) {
-                p->cur_node = else_stmt;
-                else_stmt = p->cur_node->u.IF_STMT.else_stmt;
-            }
-
-            p->cur_node->u.IF_STMT.else_stmt = new_node;
-        } break;
-        case GR_37: { // <else> ::= î
-            CY_ASSERT(p->cur_node->kind == AST_KIND_IF_STMT);
-        } break;
-        case GR_38: { // <lista_cmd> ::= <cmd> ";" <lista_cmd_mul>
-            parser_stack_push_non_terminal(p, NT_CMD_LIST_R, NULL);
-            parser_stack_push_token(p, C_TOKEN_SEMICOLON, NULL);
-            parser_stack_push_non_terminal(p, NT_CMD, NULL);
-
-            CY_ASSERT(
-                p->cur_node->kind == AST_KIND_IF_STMT ||
-                p->cur_node->kind == AST_KIND_REPEAT_STMT
-            );
-
-            AstNode **body = &p->cur_node->u.IF_STMT.body;
-            AST_LIST_CREATE(a, body, new_node, STMT_LIST);
-        } break;
-        case GR_39: { // <lista_cmd_mul> ::= <lista_cmd>
-            parser_stack_push_non_terminal(p, NT_CMD_LIST, NULL);
-
-            CY_ASSERT(
-                p->cur_node->kind == AST_KIND_IF_STMT ||
-                p->cur_node->kind == AST_KIND_REPEAT_STMT
-            );
-        } break;
-        case GR_40: { // <lista_cmd_mul> ::= î
-            CY_ASSERT(
-                p->cur_node->kind == AST_KIND_IF_STMT ||
-                p->cur_node->kind == AST_KIND_REPEAT_STMT
-            );
-
-            AstList *l = &p->cur_node->u.IF_STMT.body->u.STMT_LIST.list;
-            ast_list_shrink(l);
-        } break;
-        case GR_41: { // <cmd_rep> ::= repeat <lista_cmd> <cmd_rep_tipo> <expr>
-            parser_stack_push_non_terminal(p, NT_EXPR, NULL);
-            parser_stack_push_non_terminal(p, NT_CMD_LOOP_KEYWORD, NULL);
-            parser_stack_push_non_terminal(p, NT_CMD_LIST, NULL);
-            parser_stack_push_token(p, C_TOKEN_REPEAT, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_REPEAT_STMT);
-        } break;
-        case GR_42: { // <cmd_rep_tipo> ::= while
-            parser_stack_push_token(p, C_TOKEN_WHILE, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_REPEAT_STMT);
-        } break;
-        case GR_43: { // <cmd_rep_tipo> ::= until
-            parser_stack_push_token(p, C_TOKEN_UNTIL, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_REPEAT_STMT);
-        } break;
-        case GR_44: { // <expr> ::= <elemento> <expr_log>
-            new_node = AST_NODE_ALLOC(a, BINARY_EXPR);
-
-            parser_stack_push_non_terminal(p, NT_EXPR_LOG, new_node);
-            parser_stack_push_non_terminal(p, NT_ELEMENT, new_node);
-
-            CY_ASSERT(
-                p->cur_node->kind == AST_KIND_ASSIGN_STMT ||
-                p->cur_node->kind == AST_KIND_IF_STMT ||
-                p->cur_node->kind == AST_KIND_REPEAT_STMT ||
-                p->cur_node->kind == AST_KIND_EXPR_LIST ||
-                p->cur_node->kind == AST_KIND_PAREN_EXPR
-            );
-
-            switch (p->cur_node->kind) {
-            case AST_KIND_ASSIGN_STMT: {
-                p->cur_node->u.ASSIGN_STMT.expr = new_node;
-            } break;
-            case AST_KIND_IF_STMT: {
-                p->cur_node->u.IF_STMT.cond = new_node;
-            } break;
-            case AST_KIND_REPEAT_STMT: {
-                p->cur_node->u.REPEAT_STMT.expr = new_node;
-            } break;
-            case AST_KIND_EXPR_LIST: {
-                AstList *l = &p->cur_node->u.EXPR_LIST.list;
-                ast_list_append_node(l, new_node);
-            } break;
-            case AST_KIND_PAREN_EXPR: {
-                p->cur_node->u.PAREN_EXPR.expr = new_node;
-            } break;
-            default: break;
-            }
-        } break;
-        case GR_45: { // <expr_log> ::= "&&" <elemento> <expr_log>
-            new_node = AST_NODE_ALLOC(a, BINARY_EXPR);
-
-            parser_stack_push_non_terminal(p, NT_EXPR_LOG, new_node);
-            parser_stack_push_non_terminal(p, NT_ELEMENT, new_node);
-            parser_stack_push_token(p, C_TOKEN_AND, new_node);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
-
-            p->cur_node->u.BINARY_EXPR.op = *p->read_tok;
-            ast_expr_insert_node(p->cur_node, new_node);
-        } break;
-        case GR_46: { // <expr_log> ::= "||" <elemento> <expr_log>
-            new_node = AST_NODE_ALLOC(a, BINARY_EXPR);
-
-            parser_stack_push_non_terminal(p, NT_EXPR_LOG, new_node);
-            parser_stack_push_non_terminal(p, NT_ELEMENT, new_node);
-            parser_stack_push_token(p, C_TOKEN_OR, new_node);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
-
-            p->cur_node->u.BINARY_EXPR.op = *p->read_tok;
-            ast_expr_insert_node(p->cur_node, new_node);
-        } break;
-        case GR_47: { // <expr_log> ::= î
-            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
-
-            ast_binary_expr_reduce(a, p->cur_node);
-        } break;
-        case GR_48: { // <elemento> ::= <relacional>
-            parser_stack_push_non_terminal(p, NT_RELATIONAL, NULL);
-
-            CY_ASSERT(AST_KIND_IS_OF_CLASS(p->cur_node->kind, EXPR));
-        } break;
-        case GR_49: { // <elemento> ::= true
-            parser_stack_push_token(p, C_TOKEN_TRUE, NULL);
-
-            CY_ASSERT(AST_KIND_IS_OF_CLASS(p->cur_node->kind, EXPR));
-
-            new_node = AST_NODE_ALLOC(a, LITERAL);
-            ast_expr_insert_node(p->cur_node, new_node);
-        } break;
-        case GR_50: { // <elemento> ::= false
-            parser_stack_push_token(p, C_TOKEN_FALSE, NULL);
-
-            CY_ASSERT(AST_KIND_IS_OF_CLASS(p->cur_node->kind, EXPR));
-
-            new_node = AST_NODE_ALLOC(a, LITERAL);
-            ast_expr_insert_node(p->cur_node, new_node);
-        } break;
-        case GR_51: { // <elemento> ::= "!" <elemento>
-            new_node = AST_NODE_ALLOC(a, UNARY_EXPR);
-            parser_stack_push_non_terminal(p, NT_ELEMENT, new_node);
-            parser_stack_push_token(p, C_TOKEN_NOT, new_node);
-
-            CY_ASSERT(AST_KIND_IS_OF_CLASS(p->cur_node->kind, EXPR));
-
-            ast_expr_insert_node(p->cur_node, new_node);
-        } break;
-        case GR_52: { // <relacional> ::= <aritmetica> <relacional_mul>
-            new_node = AST_NODE_ALLOC(a, BINARY_EXPR);
-
-            parser_stack_push_non_terminal(p, NT_RELATIONAL_R, new_node);
-            parser_stack_push_non_terminal(p, NT_ARITHMETIC, new_node);
-
-            CY_ASSERT(AST_KIND_IS_OF_CLASS(p->cur_node->kind, EXPR));
-
-            ast_expr_insert_node(p->cur_node, new_node);
-        } break;
-        case GR_53: { // <relacional_mul> ::= <operador_relacional> <aritmetica>
-            parser_stack_push_non_terminal(p, NT_ARITHMETIC, NULL);
-            parser_stack_push_non_terminal(p, NT_RELATIONAL_OP, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
-        } break;
-        case GR_54: { // <relacional_mul> ::= î
-            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
-
-            ast_binary_expr_reduce(a, p->cur_node);
-        } break;
-        case GR_55: { // <operador_relacional> ::= "=="
-            parser_stack_push_token(p, C_TOKEN_CMP_EQ, NULL);
-
-            p->cur_node->u.BINARY_EXPR.op = *p->read_tok;
-            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
-        } break;
-        case GR_56: { // <operador_relacional> ::= "!="
-            parser_stack_push_token(p, C_TOKEN_CMP_NE, NULL);
-
-            p->cur_node->u.BINARY_EXPR.op = *p->read_tok;
-            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
-        } break;
-        case GR_57: { // <operador_relacional> ::= "<"
-            parser_stack_push_token(p, C_TOKEN_CMP_LT, NULL);
-
-            p->cur_node->u.BINARY_EXPR.op = *p->read_tok;
-            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
-        } break;
-        case GR_58: { // <operador_relacional> ::= ">"
-            parser_stack_push_token(p, C_TOKEN_CMP_GT, NULL);
-
-            p->cur_node->u.BINARY_EXPR.op = *p->read_tok;
-            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
-        } break;
-        case GR_59: { // <aritmetica> ::= <termo> <aritmetica_mul>
-            new_node = AST_NODE_ALLOC(a, BINARY_EXPR);
-
-            parser_stack_push_non_terminal(p, NT_ARITHMETIC_R, new_node);
-            parser_stack_push_non_terminal(p, NT_TERM, new_node);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
-
-            ast_expr_insert_node(p->cur_node, new_node);
-        } break;
-        case GR_60: { // <aritmetica_mul> ::= "+" <termo> <aritmetica_mul>
-            new_node = AST_NODE_ALLOC(a, BINARY_EXPR);
-
-            parser_stack_push_non_terminal(p, NT_ARITHMETIC_R, new_node);
-            parser_stack_push_non_terminal(p, NT_TERM, new_node);
-            parser_stack_push_token(p, C_TOKEN_ADD, new_node);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
-
-            p->cur_node->u.BINARY_EXPR.op = *p->read_tok;
-            ast_expr_insert_node(p->cur_node, new_node);
-        } break;
-        case GR_61: { // <aritmetica_mul> ::= "-" <termo> <aritmetica_mul>
-            new_node = AST_NODE_ALLOC(a, BINARY_EXPR);
-
-            parser_stack_push_non_terminal(p, NT_ARITHMETIC_R, new_node);
-            parser_stack_push_non_terminal(p, NT_TERM, new_node);
-            parser_stack_push_token(p, C_TOKEN_SUB, new_node);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
-
-            p->cur_node->u.BINARY_EXPR.op = *p->read_tok;
-            ast_expr_insert_node(p->cur_node, new_node);
-        } break;
-        case GR_62: { // <aritmetica_mul> ::= î
-            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
-
-            ast_binary_expr_reduce(a, p->cur_node);
-        } break;
-        case GR_63: { // <termo> ::= <fator> <termo_mul>
-            new_node = AST_NODE_ALLOC(a, BINARY_EXPR);
-
-            parser_stack_push_non_terminal(p, NT_TERM_R, new_node);
-            parser_stack_push_non_terminal(p, NT_FACTOR, new_node);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
-
-            ast_expr_insert_node(p->cur_node, new_node);
-        } break;
-        case GR_64: { // <termo_mul> ::= "*" <fator> <termo_mul>
-            new_node = AST_NODE_ALLOC(a, BINARY_EXPR);
-
-            parser_stack_push_non_terminal(p, NT_TERM_R, new_node);
-            parser_stack_push_non_terminal(p, NT_FACTOR, new_node);
-            parser_stack_push_token(p, C_TOKEN_MUL, new_node);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
-
-            p->cur_node->u.BINARY_EXPR.op = *p->read_tok;
-            ast_expr_insert_node(p->cur_node, new_node);
-        } break;
-        case GR_65: { // <termo_mul> ::= "/" <fator> <termo_mul>
-            new_node = AST_NODE_ALLOC(a, BINARY_EXPR);
-
-            parser_stack_push_non_terminal(p, NT_TERM_R, new_node);
-            parser_stack_push_non_terminal(p, NT_FACTOR, new_node);
-            parser_stack_push_token(p, C_TOKEN_DIV, new_node);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
-
-            p->cur_node->u.BINARY_EXPR.op = *p->read_tok;
-            ast_expr_insert_node(p->cur_node, new_node);
-        } break;
-        case GR_66: { // <termo_mul> ::= î
-            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
-
-            ast_binary_expr_reduce(a, p->cur_node);
-        } break;
-        case GR_67: { // <fator> ::= identificador
-            parser_stack_push_token(p, C_TOKEN_IDENT, NULL);
-
-            CY_ASSERT(AST_KIND_IS_OF_CLASS(p->cur_node->kind, EXPR));
-
-            new_node = AST_NODE_ALLOC(a, IDENT);
-            ast_expr_insert_node(p->cur_node, new_node);
-        } break;
-        case GR_68: { // <fator> ::= constante_int
-            parser_stack_push_token(p, C_TOKEN_INTEGER, NULL);
-
-            CY_ASSERT(AST_KIND_IS_OF_CLASS(p->cur_node->kind, EXPR));
-
-            new_node = AST_NODE_ALLOC(a, LITERAL);
-            ast_expr_insert_node(p->cur_node, new_node);
-        } break;
-        case GR_69: { // <fator> ::= constante_float
-            parser_stack_push_token(p, C_TOKEN_FLOAT, NULL);
-
-            CY_ASSERT(AST_KIND_IS_OF_CLASS(p->cur_node->kind, EXPR));
-
-            new_node = AST_NODE_ALLOC(a, LITERAL);
-            ast_expr_insert_node(p->cur_node, new_node);
-        } break;
-        case GR_70: { // <fator> ::= constante_string
-            parser_stack_push_token(p, C_TOKEN_STRING, NULL);
-
-            CY_ASSERT(AST_KIND_IS_OF_CLASS(p->cur_node->kind, EXPR));
-
-            new_node = AST_NODE_ALLOC(a, LITERAL);
-            ast_expr_insert_node(p->cur_node, new_node);
-        } break;
-        case GR_71: { // <fator> ::= "(" <expr> ")"
-            parser_stack_push_token(p, C_TOKEN_PAREN_CLOSE, NULL);
-            parser_stack_push_non_terminal(p, NT_EXPR, NULL);
-            parser_stack_push_token(p, C_TOKEN_PAREN_OPEN, NULL);
-
-            CY_ASSERT(AST_KIND_IS_OF_CLASS(p->cur_node->kind, EXPR));
-
-            new_node = AST_NODE_ALLOC(a, PAREN_EXPR);
-
-            ast_expr_insert_node(p->cur_node, new_node);
-        } break;
-        case GR_72: { // <fator> ::= "+" <fator>
-            parser_stack_push_non_terminal(p, NT_FACTOR, NULL);
-            parser_stack_push_token(p, C_TOKEN_ADD, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
-
-            new_node = AST_NODE_ALLOC(a, UNARY_EXPR);
-            ast_expr_insert_node(p->cur_node, new_node);
-        } break;
-        case GR_73: { // <fator> ::= "-" <fator>
-            parser_stack_push_non_terminal(p, NT_FACTOR, NULL);
-            parser_stack_push_token(p, C_TOKEN_SUB, NULL);
-
-            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
-
-            new_node = AST_NODE_ALLOC(a, UNARY_EXPR);
-            ast_expr_insert_node(p->cur_node, new_node);
-        } break;
-        default: {
-        } break;
-        }
-
-        p->cur_node = new_node;
-    }
-
-    return p->ast;
-}
-
-/* ----------------------------- Checker ------------------------------------ */
-typedef enum {
-    C_ERR_NONE,
-    C_ERR_UNDECLARED_IDENT,
-    C_ERR_REDECLARED_IDENT,
-    C_ERR_INVALID_TYPE,
-} CheckerError;
-
-typedef struct {
-    CheckerError err;
-    Token tok;
-    Token op;
-} CheckerStatus;
-
-static inline b32 is_declared(AstList *decl_idents, Token *ident)
-{
-    String tok = ident->str;
-    for (isize i = 0; i < decl_idents->len; i++) {
-        String other = decl_idents->data[i]->u.IDENT.tok.str;
-        if (cy_string_view_are_equal(tok, other)) {
-            return true;
-        }
-    }
-
-    return false;
-}
-
-static inline CheckerStatus checker_error(CheckerError err, Token *tok)
-{
-    CheckerStatus status = { .err = err };
-    if (tok != NULL) {
-        status.tok = *tok;
-    }
-
-    return status;
-}
-
-static CheckerStatus check_expr(AstNode *expr, AstList *decl_idents)
-{
-    switch (expr->kind) {
-    case AST_KIND_BINARY_EXPR: {
-        CheckerStatus lhs = check_expr(expr->u.BINARY_EXPR.left, decl_idents);
-        if (lhs.err != C_ERR_NONE) {
-            return lhs;
-        }
-
-        CheckerStatus rhs = check_expr(expr->u.BINARY_EXPR.right, decl_idents);
-        if (rhs.err != C_ERR_NONE) {
-            return rhs;
-        }
-    } break;
-    case AST_KIND_UNARY_EXPR:
-    case AST_KIND_PAREN_EXPR: {
-        AstNode *sub = expr->u.UNARY_EXPR.expr;
-        if (AST_KIND_IS_OF_CLASS(sub->kind, EXPR)) {
-            return check_expr(sub, decl_idents);
-        } else switch (sub->kind) {
-        case AST_KIND_IDENT: {
-            return check_expr(sub, decl_idents);
-        } break;
-        default: break;
-        }
-    } break;
-    case AST_KIND_IDENT: {
-        Token *tok = &expr->u.IDENT.tok;
-        if (!is_declared(decl_idents, tok)) {
-            return checker_error(C_ERR_UNDECLARED_IDENT, tok);
-        }
-    } break;
-    default: break;
-    }
-
-    return checker_error(C_ERR_NONE, NULL);
-}
-
-static CheckerStatus check_stmt(AstNode *node, AstList *decl_idents)
-{
-    CheckerStatus status = {0};
-    switch (node->kind) {
-    case AST_KIND_VAR_DECL: {
-        AstList *idents = &node->u.VAR_DECL.ident_list->u.IDENT_LIST.list;
-        for (isize i = 0; i < idents->len; i++) {
-            AstNode *ident = idents->data[i];
-            Token *tok = &ident->u.IDENT.tok;
-            if (is_declared(decl_idents, tok)) {
-                return checker_error(C_ERR_REDECLARED_IDENT, tok);
-            }
-
-            ast_list_append_node(decl_idents, ident);
-        }
-    } break;
-    case AST_KIND_ASSIGN_STMT: {
-        AstList *idents = &node->u.ASSIGN_STMT.ident_list->u.IDENT_LIST.list;
-        for (isize i = 0; i < idents->len; i++) {
-            AstNode *ident = idents->data[i];
-            Token *tok = &ident->u.IDENT.tok;
-            if (!is_declared(decl_idents, tok)) {
-                return checker_error(C_ERR_UNDECLARED_IDENT, tok);
-            }
-        }
-
-        return check_expr(node->u.ASSIGN_STMT.expr, decl_idents);
-    } break;
-    case AST_KIND_READ_STMT: {
-        AstList *inputs = &node->u.READ_STMT.input_list->u.INPUT_LIST.list;
-        for (isize i = 0; i < inputs->len; i++) {
-            Token *tok = &inputs->data[i]->u.INPUT_ARG.ident->u.IDENT.tok;
-            if (!is_declared(decl_idents, tok)) {
-                return checker_error(C_ERR_UNDECLARED_IDENT, tok);
-            }
-        }
-    } break;
-    case AST_KIND_WRITE_STMT: {
-        AstList *exprs = &node->u.WRITE_STMT.expr_list->u.EXPR_LIST.list;
-        for (isize i = 0; i < exprs->len; i++) {
-            AstNode *expr = exprs->data[i];
-            status = check_expr(expr, decl_idents);
-            if (status.err != C_ERR_NONE) {
-                return status;
-            }
-        }
-    } break;
-    case AST_KIND_IF_STMT: {
-        AstNode *cond = node->u.IF_STMT.cond;
-        if (cond != NULL) {
-            status = check_expr(cond, decl_idents);
-            if (status.err != C_ERR_NONE) {
-                return status;
-            }
-        }
-
-        AstList *stmts = &node->u.IF_STMT.body->u.STMT_LIST.list;
-        for (isize i = 0; i < stmts->len; i++) {
-            AstNode *stmt = stmts->data[i];
-            status = check_stmt(stmt, decl_idents);
-            if (status.err != C_ERR_NONE) {
-                return status;
-            }
-        }
-
-        AstNode *else_stmt = node->u.IF_STMT.else_stmt;
-        if (else_stmt != NULL) {
-            status = check_stmt(else_stmt, decl_idents);
-        }
-    } break;
-    case AST_KIND_REPEAT_STMT: {
-        AstNode *expr = node->u.REPEAT_STMT.expr;
-        if (expr != NULL) {
-            status = check_expr(expr, decl_idents);
-            if (status.err != C_ERR_NONE) {
-                return status;
-            }
-        }
-
-        AstList *stmts = &node->u.REPEAT_STMT.body->u.STMT_LIST.list;
-        for (isize i = 0; i < stmts->len; i++) {
-            AstNode *stmt = stmts->data[i];
-            status = check_stmt(stmt, decl_idents);
-            if (status.err != C_ERR_NONE) {
-                return status;
-            }
-        }
-    } break;
-    default: break;
-    }
-
-    return status;
-}
-
-static CheckerStatus check(Ast *a)
-{
-    CheckerStatus status = {0};
-    AstList decl_idents = ast_list_init(a->alloc);
-
-    AstList *stmts = &a->root->u.MAIN.body->u.STMT_LIST.list;
-    for (isize i = 0; i < stmts->len; i++) {
-        AstNode *stmt = stmts->data[i];
-        status = check_stmt(stmt, &decl_idents);
-        if (status.err != C_ERR_NONE) {
-            break;
-        }
-    }
-
-    return status;
-}
-
-static inline CyString checker_append_error_msg(CyString msg, CheckerStatus *s)
-{
-    msg = append_error_prefix(msg, s->tok.pos);
-    msg = cy_string_append_fmt(msg, "%.*s ", STRING_ARG(s->tok.str));
-
-    switch (s->err) {
-    case C_ERR_UNDECLARED_IDENT: {
-        msg = cy_string_append_c(msg, "não declarado");
-    } break;
-    case C_ERR_REDECLARED_IDENT: {
-        msg = cy_string_append_c(msg, "já declarado");
-    } break;
-    case C_ERR_INVALID_TYPE: {
-    } break;
-    case C_ERR_NONE: {
-    } break;
-    }
-
-    return msg;
-}
-
-/* ------------------------- Code Generator (MSIL) -------------------------- */
-typedef struct {
-    CyAllocator alloc;
-    isize *items;
-    isize len;
-    isize cap;
-} LabelStack;
-
-typedef struct {
-    CyAllocator alloc;
-    Ast *ast;
-    CyString code;
-    LabelStack end_labels;
-    isize cur_label;
-} IlGenerator;
-
-static inline isize label_stack_peek(IlGenerator *g)
-{
-    return (g->end_labels.len > 0) ?
-        g->end_labels.items[g->end_labels.len - 1] : 0;
-}
-
-static inline isize label_stack_push(IlGenerator *g)
-{
-    if (g->end_labels.len == g->end_labels.cap) {
-        isize old_size = g->end_labels.cap * sizeof(*g->end_labels.items);
-        isize new_size = old_size * 2;
-        isize *items = cy_resize(
-            g->end_labels.alloc, g->end_labels.items,
-            old_size, new_size
-        );
-        if (items == NULL) {
-            return -1;
-        }
-
-        g->end_labels.items = items;
-        g->end_labels.cap *= 2;
-    }
-
-     isize item = ++g->cur_label;
-     g->end_labels.items[g->end_labels.len++] = item;
-     return item;
-}
-
-static inline isize label_stack_pop(IlGenerator *g)
-{
-    if (g->end_labels.len <= 0) {
-        return -1;
-    }
-
-    isize *top = &g->end_labels.items[--g->end_labels.len];
-    isize ret = *top;
-
-    cy_mem_set(top, 0, sizeof(*top));
-    return ret;
-}
-
-static inline IlGenerator il_generator_init(
-    CyAllocator a, CyAllocator stack_allocator, Ast *ast
-) {
-    isize cap = 0x10;
-    isize *items = cy_alloc(stack_allocator, cap);
-    return (IlGenerator){
-        .alloc = a,
-        .ast = ast,
-        .end_labels = (LabelStack){
-            .alloc = stack_allocator,
-            .items = items,
-            .cap = cap,
-        },
-    };
-}
-
-static void il_generator_append_line(IlGenerator *g, const char *fmt, ...)
-{
-    va_list va;
-    va_start(va, fmt);
-
-    char buf[0x1000] = {0};
-    vsnprintf(buf, sizeof(buf), fmt, va);
-
-    va_end(va);
-
-    g->code = cy_string_append_fmt(g->code, "\t\t%s\r\n", buf);
-}
-
-static inline void il_generator_append_ldstr(IlGenerator *g, String s);
-
-static inline void il_generator_append_expr(IlGenerator *g, AstNode *expr)
-{
-    AstKind expr_kind = expr->kind;
-    switch (expr_kind) {
-    case AST_KIND_BINARY_EXPR: {
-        il_generator_append_expr(g, expr->u.BINARY_EXPR.left);
-        il_generator_append_expr(g, expr->u.BINARY_EXPR.right);
-
-        const char *instr = NULL;
-        Token op = expr->u.BINARY_EXPR.op;
-        switch (op.kind) {
-        case C_TOKEN_ADD: {
-            instr = "add";
-        } break;
-        case C_TOKEN_SUB: {
-            instr = "sub";
-        } break;
-        case C_TOKEN_MUL: {
-            instr = "mul";
-        } break;
-        case C_TOKEN_DIV: {
-            instr = "div";
-        } break;
-        case C_TOKEN_CMP_EQ:
-        case C_TOKEN_CMP_NE: {
-            instr = "ceq";
-        } break;
-        case C_TOKEN_CMP_GT: {
-            instr = "cgt";
-        } break;
-        case C_TOKEN_CMP_LT: {
-            instr = "clt";
-        } break;
-        case C_TOKEN_AND: {
-            instr = "and";
-        } break;
-        case C_TOKEN_OR: {
-            instr = "or";
-        } break;
-        default: break;
-        }
-
-        il_generator_append_line(g, instr);
-        if (op.kind == C_TOKEN_CMP_NE) {
-            il_generator_append_line(g, "ldc.i4 1");
-            il_generator_append_line(g, "xor");
-        }
-    } break;
-    case AST_KIND_UNARY_EXPR: {
-        il_generator_append_expr(g, expr->u.UNARY_EXPR.expr);
-
-        Token op = expr->u.UNARY_EXPR.op;
-        if (op.kind == C_TOKEN_NOT) {
-            il_generator_append_line(g, "ldc.i4 1");
-            il_generator_append_line(g, "xor");
-        } else if (op.kind == C_TOKEN_SUB) {
-            il_generator_append_line(g, "ldc.r8 -1.0");
-            il_generator_append_line(g, "mul");
-        }
-    } break;
-    case AST_KIND_PAREN_EXPR: {
-        il_generator_append_expr(g, expr->u.PAREN_EXPR.expr);
-    } break;
-    case AST_KIND_IDENT: {
-        String name = expr->u.IDENT.tok.str;
-        il_generator_append_line(g, "ldloc %.*s", STRING_ARG(name));
-        if (expr->u.IDENT.kind == AST_ENT_INT) {
-            il_generator_append_line(g, "conv.r8");
-        }
-    } break;
-    case AST_KIND_LITERAL: {
-        AstEntityKind kind = expr->u.LITERAL.val.kind;
-        if (kind== AST_ENT_STRING) {
-            String s = expr->u.LITERAL.val.u.s;
-            il_generator_append_ldstr(g, s);
-        } else {
-            char buf[0x100] = {0};
-            isize buf_size = sizeof(buf);
-            const char *kind_id = NULL;
-            switch (kind) {
-            case AST_ENT_INT: {
-                kind_id = "i8";
-                isize val = expr->u.LITERAL.val.u.i;
-                snprintf(buf, buf_size, "%td", val);
-            } break;
-            case AST_ENT_FLOAT: {
-                kind_id = "r8";
-                f64 val = expr->u.LITERAL.val.u.f.val;
-                isize precision = expr->u.LITERAL.val.u.f.precision;
-                snprintf(buf, buf_size, "%.*lf", (int)precision, val);
-            } break;
-            case AST_ENT_BOOL: {
-                kind_id = "i4";
-                b32 val = expr->u.LITERAL.val.u.b;
-                snprintf(buf, buf_size, "%d", val);
-            } break;
-            default: break;
-            }
-
-            il_generator_append_line(g, "ldc.%s %s", kind_id, buf);
-            if (kind == AST_ENT_INT) {
-                il_generator_append_line(g, "conv.r8");
-            }
-        }
-    } break;
-    default: break;
-    }
-}
-
-static inline const char *il_keyword_from_entity_kind(AstEntityKind kind)
-{
-    const char *keyword = NULL;
-    switch (kind) {
-    case AST_ENT_INT: {
-        keyword = "int64";
-    } break;
-    case AST_ENT_FLOAT: {
-        keyword = "float64";
-    } break;
-    case AST_ENT_BOOL: {
-        keyword = "bool";
-    } break;
-    case AST_ENT_STRING: {
-        keyword = "string";
-    } break;
-    }
-
-    return keyword;
-}
-
-static inline const char *il_class_from_entity_kind(AstEntityKind kind)
-{
-    const char *keyword = NULL;
-    switch (kind) {
-    case AST_ENT_INT: {
-        keyword = "Int64";
-    } break;
-    case AST_ENT_FLOAT: {
-        keyword = "Double";
-    } break;
-    case AST_ENT_BOOL: {
-        keyword = "Bool";
-    } break;
-    case AST_ENT_STRING: {
-        keyword = "string";
-    } break;
-    }
-
-    return keyword;
-}
-
-static inline void il_generator_append_ldstr(IlGenerator *g, String s)
-{
-    CyAllocator a = g->alloc;
-    CyString str = cy_string_create_view(a, s);
-
-#ifdef CY_OS_WINDOWS
-    isize utf16_len = MultiByteToWideChar(
-        CP_UTF8, 0, str, cy_string_len(str), NULL, 0
-    );
-    CyString16 utf16 = cy_string_16_create_reserve(a, utf16_len);
-    MultiByteToWideChar(CP_UTF8, 0, str, cy_string_len(str), utf16, utf16_len);
-
-    UINT cp = GetConsoleOutputCP();
-    const char *def_char = IS_IN_RANGE_IN(cp, CP_UTF7, CP_UTF8) ? NULL : "?";
-
-    isize ansi_len = WideCharToMultiByte(
-        cp, 0, utf16, utf16_len, NULL, 0, def_char, NULL
-    );
-    CyString ansi = cy_string_create_reserve(a, ansi_len);
-    WideCharToMultiByte(
-        cp, 0, utf16, utf16_len, ansi, ansi_len, def_char, NULL
-    );
-    cy__string_set_len(ansi, ansi_len);
-
-    cy_string_free(str);
-    cy_string_16_free(utf16);
-    str = ansi;
-#endif
-
-    il_generator_append_line(g, "ldstr %s", str);
-    cy_string_free(str);
-}
-
-static inline void il_generator_append_label(IlGenerator *g, isize label)
-{
-    g->code = cy_string_append_fmt(g->code, "IL_%02td:\r\n", label);
-}
-
-static inline void il_generator_append_stmt(IlGenerator *g, AstNode *stmt)
-{
-    switch (stmt->kind) {
-    case AST_KIND_VAR_DECL: {
-        AstList *idents = &stmt->u.VAR_DECL.ident_list->u.IDENT_LIST.list;
-        for (isize i = 0; i < idents->len; i++) {
-            AstNode *ident = idents->data[i];
-            const char *kind = il_keyword_from_entity_kind(ident->u.IDENT.kind);
-
-            String name = ident->u.IDENT.tok.str;
-            il_generator_append_line(
-                g, ".locals (%s %.*s)", kind, STRING_ARG(name)
-            );
-        }
-    } break;
-    case AST_KIND_ASSIGN_STMT: {
-        AstNode *expr = stmt->u.ASSIGN_STMT.expr;
-        AstEntityKind expr_kind = ast_expr_determine_kind(expr);
-        il_generator_append_expr(g, expr);
-        if (expr_kind == AST_ENT_INT) {
-            il_generator_append_line(g, "conv.i8");
-        }
-
-        AstList *idents = &stmt->u.ASSIGN_STMT.ident_list->u.IDENT_LIST.list;
-        for (isize i = 0; i < idents->len - 1; i++) {
-            il_generator_append_line(g, "dup");
-        }
-
-        for (isize i = 0; i < idents->len; i++) {
-            AstNode *ident = idents->data[i];
-            String name = ident->u.IDENT.tok.str;
-            il_generator_append_line(g, "stloc %.*s", STRING_ARG(name));
-        }
-    } break;
-    case AST_KIND_READ_STMT: {
-        AstList *args = &stmt->u.READ_STMT.input_list->u.INPUT_LIST.list;
-        for (isize i = 0; i < args->len; i++) {
-            AstNode *arg = args->data[i];
-            if (arg->u.INPUT_ARG.prompt != NULL) {
-                String s = arg->u.INPUT_ARG.prompt->u.INPUT_PROMPT.string.str;
-                il_generator_append_ldstr(g, s);
-                il_generator_append_line(
-                    g, "call void [mscorlib]System.Console::Write(string)"
-                );
-            }
-
-            String ident = arg->u.INPUT_ARG.ident->u.IDENT.tok.str;
-            AstEntityKind kind = arg->u.INPUT_ARG.ident->u.IDENT.kind;
-            il_generator_append_line(
-                g, "call string [mscorlib]System.Console::ReadLine()"
-            );
-            if (kind != AST_ENT_STRING) {
-                const char *keyword = il_keyword_from_entity_kind(kind);
-                const char *class = il_class_from_entity_kind(kind);
-                il_generator_append_line(
-                    g, "call %s [mscorlib]System.%s::Parse(string)",
-                    keyword, class
-                );
-            }
-
-            il_generator_append_line(g, "stloc %.*s", STRING_ARG(ident));
-        }
-    } break;
-    case AST_KIND_WRITE_STMT: {
-        b32 writeln = stmt->u.WRITE_STMT.keyword.kind == C_TOKEN_WRITELN;
-        AstList *exprs = &stmt->u.WRITE_STMT.expr_list->u.EXPR_LIST.list;
-        for (isize i = 0; i < exprs->len; i++) {
-            AstNode *expr = exprs->data[i];
-            AstEntityKind expr_kind = ast_expr_determine_kind(expr);
-            il_generator_append_expr(g, expr);
-
-            const char *kind = il_keyword_from_entity_kind(expr_kind);
-            if (expr_kind == AST_ENT_INT) {
-                il_generator_append_line(g, "conv.i8");
-            }
-
-            const char *keyword = writeln && i == exprs->len - 1 ?
-                "WriteLine" : "Write";
-            il_generator_append_line(
-                g, "call void [mscorlib]System.Console::%s(%s)", keyword, kind
-            );
-        }
-    } break;
-    case AST_KIND_IF_STMT: {
-        b32 is_root = stmt->u.IF_STMT.is_root;
-
-        isize if_label = ++g->cur_label;
-        isize end_label = is_root ? label_stack_push(g) : label_stack_peek(g);
-
-        AstNode *else_stmt = stmt->u.IF_STMT.else_stmt;
-        isize else_label = else_stmt == NULL ? end_label : ++g->cur_label;
-
-        AstNode *cond = stmt->u.IF_STMT.cond;
-        if (cond != NULL) {
-            il_generator_append_expr(g, cond);
-            il_generator_append_line(g, "brtrue IL_%02td", if_label);
-            il_generator_append_line(g, "br IL_%02td", else_label);
-
-            il_generator_append_label(g, if_label);
-        }
-
-        AstList *stmts = &stmt->u.IF_STMT.body->u.STMT_LIST.list;
-        for (isize i = 0; i < stmts->len; i++) {
-            il_generator_append_stmt(g, stmts->data[i]);
-        }
-
-        il_generator_append_line(g, "br IL_%02td", end_label);
-
-        if (else_stmt != NULL) {
-            il_generator_append_label(g, else_label);
-            il_generator_append_stmt(g, else_stmt);
-        }
-
-        if (is_root) {
-            il_generator_append_label(g, end_label);
-            label_stack_pop(g);
-        }
-    } break;
-    case AST_KIND_REPEAT_STMT: {
-        isize label = ++g->cur_label;
-        il_generator_append_label(g, label);
-
-        AstList *stmts = &stmt->u.REPEAT_STMT.body->u.STMT_LIST.list;
-        for (isize i = 0; i < stmts->len; i++) {
-            il_generator_append_stmt(g, stmts->data[i]);
-        }
-
-        AstNode *expr = stmt->u.REPEAT_STMT.expr;
-        il_generator_append_expr(g, expr);
-
-        const char *instr = stmt->u.REPEAT_STMT.keyword.kind == C_TOKEN_WHILE ?
-            "true" : "false";
-        il_generator_append_line(g, "br%s IL_%02td", instr, label);
-    } break;
-    default: break;
-    }
-}
-
-static CyString il_generate(IlGenerator *g)
-{
-    AstList *stmts = &g->ast->root->u.MAIN.body->u.STMT_LIST.list;
-    isize init_cap = 10 * stmts->len;
-    g->code = cy_string_create_reserve(g->alloc, init_cap);
-    const char *header =
-        ".assembly extern mscorlib {}\r\n"
-        ".assembly _obj_code {}\r\n"
-        ".module _obj_code.exe\r\n"
-        ".class public Main {\r\n"
-        "\t.method public static void main() {\r\n"
-        "\t\t.entrypoint\r\n";
-    g->code = cy_string_append_c(g->code, header);
-
-    for (isize i = 0; i < stmts->len; i++) {
-        AstNode *stmt = stmts->data[i];
-        il_generator_append_stmt(g, stmt);
-    }
-
-    const char *footer =
-        "\t\tret\r\n"
-        "\t}\r\n"
-        "}\r\n";
-    g->code = cy_string_append_c(g->code, footer);
-
-    return g->code;
-}
-
-/* -------------------------- Compiler interface ---------------------------- */
-typedef struct {
-    CyString msg;
-    CyString code;
-} CompilerOutput;
-
-void compiler_output_free(CompilerOutput *output)
-{
-    cy_string_free(output->msg);
-    cy_string_free(output->code);
-    cy_mem_zero(output, sizeof(*output));
-}
-
-CompilerOutput compile(CyAllocator a, String src_code)
-{
-#ifdef CY_DEBUG
-    CyTicks start = cy_ticks_query();
-#endif
-
-    CyArena tokenizer_arena = cy_arena_init(a, 0x4000);
-    CyAllocator temp_allocator = cy_arena_allocator(&tokenizer_arena);
-
-    CyStack parser_stack = {0};
-
-    CyString code = NULL;
-    isize init_cap = 0x100;
-    CyString msg = cy_string_create_reserve(a, init_cap);
-    Tokenizer tokenizer = tokenizer_init(src_code);
-    TokenList token_list = tokenize(temp_allocator, &tokenizer, true);
-    if (tokenizer.err != T_ERR_NONE) {
-        msg = tokenizer_append_error_msg(msg, &tokenizer);
-        goto cleanup;
-    }
-
-    isize stack_size = token_list.len * sizeof(ParserSymbol);
-    parser_stack = cy_stack_init(a, stack_size);
-    CyAllocator stack_allocator = cy_stack_allocator(&parser_stack);
-    Parser parser = parser_init(stack_allocator, &token_list);
-
-    // TODO(cya): use pool allocator when implemented
-    Ast ast = parse(temp_allocator, &parser);
-    if (parser.err.kind != P_ERR_NONE) {
-        msg = parser_append_error_msg(msg, &parser);
-        goto cleanup;
-    }
-
-    CheckerStatus status = check(&ast);
-    if (status.err != C_ERR_NONE) {
-        msg = checker_append_error_msg(msg, &status);
-        goto cleanup;
-    }
-
-    IlGenerator generator = il_generator_init(a, stack_allocator, &ast);
-    code = il_generate(&generator);
-    msg = cy_string_append_c(msg, "programa compilado com sucesso");
-
-#ifdef CY_DEBUG
-    CyTicks elapsed = cy_ticks_elapsed(start, cy_ticks_query());
-    f64 elapsed_us = cy_ticks_to_time_unit(elapsed, CY_MICROSECONDS);
-    msg = cy_string_append_fmt(msg, " em %.01fμs", elapsed_us);
-#endif
-
-cleanup:
-    cy_stack_deinit(&parser_stack);
-    cy_arena_deinit(&tokenizer_arena);
-
-    return (CompilerOutput){
-        .code = code,
-        .msg = cy_string_shrink(msg),
-    };
-}
+#define CY_IMPLEMENTATION
+#include "cy.h"
+#include "compiler.h"
+
+#include <errno.h>
+#include <stdlib.h>
+
+typedef CyStringView String;
+
+#define STRING_ARG(s) (int)s.len, s.text
+
+/* ---------------------------- Tokenizer ----------------------------------- */
+#define TOKEN_KINDS \
+    TOKEN_KIND(C_TOKEN_INVALID, "símbolo inválido"), \
+    TOKEN_KIND(C_TOKEN_EOF, "EOF"), \
+\
+TOKEN_KIND(C_TOKEN__LITERAL_BEGIN, ""), \
+    TOKEN_KIND(C_TOKEN_IDENT, "identificador"), \
+    TOKEN_KIND(C_TOKEN_INTEGER, "constante_int"), \
+    TOKEN_KIND(C_TOKEN_FLOAT, "constante_float"), \
+    TOKEN_KIND(C_TOKEN_STRING, "constante_string"), \
+    TOKEN_KIND(C_TOKEN_COMMENT, "comentário"), \
+TOKEN_KIND(C_TOKEN__LITERAL_END, ""), \
+\
+TOKEN_KIND(C_TOKEN__OPERATOR_BEGIN, ""), \
+    TOKEN_KIND(C_TOKEN_EQUALS, "="), \
+    TOKEN_KIND(C_TOKEN_ADD, "+"), \
+    TOKEN_KIND(C_TOKEN_SUB, "-"), \
+    TOKEN_KIND(C_TOKEN_MUL, "*"), \
+    TOKEN_KIND(C_TOKEN_DIV, "/"), \
+    TOKEN_KIND(C_TOKEN_OR, "||"), \
+    TOKEN_KIND(C_TOKEN_AND, "&&"), \
+    TOKEN_KIND(C_TOKEN_NOT, "!"), \
+\
+TOKEN_KIND(C_TOKEN__COMPARISON_BEGIN, ""), \
+    TOKEN_KIND(C_TOKEN_CMP_EQ, "=="), \
+    TOKEN_KIND(C_TOKEN_CMP_NE, "!="), \
+    TOKEN_KIND(C_TOKEN_CMP_LT, "<"), \
+    TOKEN_KIND(C_TOKEN_CMP_GT, ">"), \
+TOKEN_KIND(C_TOKEN__COMPARISON_END, ""), \
+\
+    TOKEN_KIND(C_TOKEN_PAREN_OPEN, "("), \
+    TOKEN_KIND(C_TOKEN_PAREN_CLOSE, ")"), \
+    TOKEN_KIND(C_TOKEN_COMMA, ","), \
+    TOKEN_KIND(C_TOKEN_SEMICOLON, ";"), \
+TOKEN_KIND(C_TOKEN__OPERATOR_END, ""), \
+\
+TOKEN_KIND(C_TOKEN__KEYWORD_BEGIN, ""), \
+    TOKEN_KIND(C_TOKEN_MAIN, "main"), \
+    TOKEN_KIND(C_TOKEN_END, "end"), \
+    TOKEN_KIND(C_TOKEN_IF, "if"), \
+    TOKEN_KIND(C_TOKEN_ELIF, "elif"), \
+    TOKEN_KIND(C_TOKEN_ELSE, "else"), \
+    TOKEN_KIND(C_TOKEN_TRUE, "true"), \
+    TOKEN_KIND(C_TOKEN_FALSE, "false"), \
+    TOKEN_KIND(C_TOKEN_READ, "read"), \
+    TOKEN_KIND(C_TOKEN_WRITE, "write"), \
+    TOKEN_KIND(C_TOKEN_WRITELN, "writeln"), \
+    TOKEN_KIND(C_TOKEN_REPEAT, "repeat"), \
+    TOKEN_KIND(C_TOKEN_UNTIL, "until"), \
+    TOKEN_KIND(C_TOKEN_WHILE, "while"), \
+TOKEN_KIND(C_TOKEN__KEYWORD_END, ""), \
+    TOKEN_KIND(C_TOKEN_COUNT, "")
+
+#define KEYWORD_COUNT (C_TOKEN__KEYWORD_END - C_TOKEN__KEYWORD_BEGIN - 1)
+
+typedef enum {
+#define TOKEN_KIND(e, s) e
+    TOKEN_KINDS
+#undef TOKEN_KIND
+} TokenKind;
+
+const String g_token_strings[] = {
+#define TOKEN_KIND(e, s) {(const u8*)s, CY_STATIC_STR_LEN(s)}
+    TOKEN_KINDS
+#undef TOKEN_KIND
+};
+
+typedef struct {
+    i32 line;
+    i32 col;
+} TokenPos;
+
+/* Tokens only keep where their text is in the source, which is all it takes
+ * to get the text back (token_text) and, for diagnostics, the position
+ * (line_index_pos) */
+typedef struct {
+    u32 offset;
+    u32 len;
+    u8 kind; // NOTE(cya): TokenKind
+} Token;
+
+#define TOKEN_MAX_SRC_LEN ((isize)U32_MAX)
+
+static inline String token_text(const u8 *src, Token tok)
+{
+    return (String){ .text = src + tok.offset, .len = tok.len };
+}
+
+
+typedef enum {
+    T_ERR_OUT_OF_MEMORY = -1,
+    T_ERR_NONE,
+    T_ERR_INVALID_SYMBOL,
+    T_ERR_INVALID_KEYWORD,
+    T_ERR_INVALID_IDENT,
+    T_ERR_INVALID_STRING,
+    T_ERR_INVALID_COMMENT,
+    T_ERR_INT_OUT_OF_RANGE,
+    T_ERR_FLOAT_OUT_OF_RANGE,
+    T_ERR_INVALID_UTF8,
+} TokenizerError;
+
+/* Value of the last constante_int or constante_float read, worked out by the
+ * tokenizer as it lexes the number */
+typedef union {
+    isize i;
+    struct {
+        f64 val;
+        isize precision; // NOTE(cya): digits after the comma
+    } f;
+} TokenValue;
+
+/* Scanners that skip over the bodies of words, string literals and comments
+ * in bulk, returning the first byte in [s, end) the tokenizer has to look at.
+ * Literals can hold any valid UTF-8, so the string and comment scanners step
+ * over it themselves, stopping only at bytes that don't start a valid sequence
+ * (which then go through the rune decoder). The DFA backend doesn't decode
+ * runes, so the utf8 scanner checks the literals it lexes instead */
+#define SCAN_WORD_PROC(name) const u8 *name(const u8 *s, const u8 *end)
+#define SCAN_STRING_PROC(name) const u8 *name(const u8 *s, const u8 *end)
+#define SCAN_COMMENT_PROC(name) const u8 *name(const u8 *s, const u8 *end)
+#define SCAN_LINE_PROC(name) const u8 *name(const u8 *s, const u8 *end)
+#define SCAN_UTF8_PROC(name) const u8 *name(const u8 *s, const u8 *end)
+
+typedef SCAN_WORD_PROC(ScanWordProc);       // NOTE(cya): stops at [^A-Za-z0-9_]
+typedef SCAN_STRING_PROC(ScanStringProc);   // NOTE(cya): stops at ["%\n\0]
+typedef SCAN_COMMENT_PROC(ScanCommentProc); // NOTE(cya): stops at [@\0]
+typedef SCAN_LINE_PROC(ScanLineProc);       // NOTE(cya): stops at \n only
+typedef SCAN_UTF8_PROC(ScanUtf8Proc);       // NOTE(cya): stops at bad UTF-8
+
+typedef struct {
+    const char *name;
+    ScanWordProc *word;
+    ScanStringProc *string;
+    ScanCommentProc *comment;
+    ScanLineProc *line;
+    ScanUtf8Proc *utf8;
+} ScanKernels;
+
+/* The default backend steps through the source rune by rune (skipping some
+ * bodies with the scan kernels), the DFA one runs the tables generated from
+ * the lexical rules in compiler_gen.c */
+typedef enum {
+    TOKENIZER_BACKEND_RUNES,
+    TOKENIZER_BACKEND_DFA,
+} TokenizerBackend;
+
+/* Besides token kinds, the DFA accepts the whitespace it skips and each kind
+ * of lexical error (so that every input has a longest match) */
+typedef enum {
+    DFA_WHITESPACE = C_TOKEN_COUNT,
+    DFA_ERR_SYMBOL,
+    DFA_ERR_KEYWORD,
+    DFA_ERR_IDENT,
+    DFA_ERR_STRING_FORMAT,  // NOTE(cya): % not followed by x
+    DFA_ERR_STRING_NEWLINE,
+    DFA_ERR_STRING_EOF,
+    DFA_ERR_COMMENT,
+    DFA_LABEL_COUNT,
+} DfaLabel;
+
+typedef struct {
+    const u8 *start;
+    const u8 *end;
+    const u8 *cur;
+    const u8 *next;
+    const ScanKernels *scan;
+    TokenizerBackend backend;
+
+    Rune cur_rune;
+
+    TokenValue value;
+
+    TokenizerError err;
+    const u8 *err_desc;
+    Token bad_tok;
+} Tokenizer;
+
+/* Keywords are found with a perfect hash (over their first two chars, last
+ * char and length) generated by compiler_gen.c into compiler_keywords.h */
+#define KEYWORD_HASH_KEY(s) ( \
+    (u32)(s).text[0] | (u32)(s).text[1] << 8 | \
+    (u32)(s).text[(s).len - 1] << 16 | (u32)(s).len << 24 \
+)
+
+#if defined(COMPILER_GEN)
+// NOTE(cya): the generator can't use the table it's generating
+static inline TokenKind keyword_lookup(String word)
+{
+    for (isize i = C_TOKEN__KEYWORD_BEGIN + 1; i < C_TOKEN__KEYWORD_END; i++) {
+        if (cy_string_view_are_equal(word, g_token_strings[i])) {
+            return i;
+        }
+    }
+
+    return C_TOKEN_INVALID;
+}
+#else
+#include "compiler_keywords.h"
+
+CY_STATIC_ASSERT(C_TOKEN_COUNT <= U8_MAX);
+CY_STATIC_ASSERT(KEYWORD_GEN_BEGIN == C_TOKEN__KEYWORD_BEGIN);
+CY_STATIC_ASSERT(KEYWORD_GEN_COUNT == KEYWORD_COUNT);
+
+// NOTE(cya): C_TOKEN_INVALID unless word is a keyword
+static inline TokenKind keyword_lookup(String word)
+{
+    if (word.len < KEYWORD_GEN_MIN_LEN || word.len > KEYWORD_GEN_MAX_LEN) {
+        return C_TOKEN_INVALID;
+    }
+
+    u32 slot = (KEYWORD_HASH_KEY(word) * KEYWORD_HASH_MUL) >>
+        (32 - KEYWORD_HASH_BITS);
+    isize kind = g_keyword_slots[slot];
+    String keyword = g_token_strings[kind];
+    if (kind == 0 || keyword.len != word.len ||
+        cy_mem_compare(keyword.text, word.text, word.len) != 0) {
+        return C_TOKEN_INVALID;
+    }
+
+    return kind;
+}
+#endif
+
+#ifdef CY_DEBUG
+static void keyword_lookup_validate(void)
+{
+    for (isize i = C_TOKEN__KEYWORD_BEGIN + 1; i < C_TOKEN__KEYWORD_END; i++) {
+        String keyword = g_token_strings[i];
+        CY_ASSERT_MSG(
+            keyword_lookup(keyword) == (TokenKind)i,
+            "compiler_keywords.h is out of date (%.*s)", STRING_ARG(keyword)
+        );
+    }
+}
+#endif
+
+/* -------------------------------- UTF-8 ----------------------------------- */
+/* For each byte, how long a sequence it starts (low nibble, 0 if it can't
+ * start one) and which range its second byte has to be in (high nibble).
+ * That range is what rules out overlong forms, surrogates and runes past
+ * U+10FFFF; every later byte just has to be a continuation byte */
+typedef struct {
+    u8 lo, hi;
+} Utf8AcceptRange;
+
+static const Utf8AcceptRange g_utf8_accept_ranges[] = {
+    { 0x80, 0xBF }, { 0xA0, 0xBF }, { 0x80, 0x9F }, { 0x90, 0xBF },
+    { 0x80, 0x8F },
+};
+
+static const u8 g_utf8_first[256] = {
+#define U8_ASCII_ROW 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1
+#define U8_CONT_ROW 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+    U8_ASCII_ROW, U8_ASCII_ROW, U8_ASCII_ROW, U8_ASCII_ROW, // 0x00-0x3F
+    U8_ASCII_ROW, U8_ASCII_ROW, U8_ASCII_ROW, U8_ASCII_ROW, // 0x40-0x7F
+    U8_CONT_ROW, U8_CONT_ROW, U8_CONT_ROW, U8_CONT_ROW,     // 0x80-0xBF
+    0, 0, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,         // 0xC0-0xCF
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,         // 0xD0-0xDF
+    0x13, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 0x23, 3, 3,   // 0xE0-0xEF
+    0x34, 4, 4, 4, 0x44, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   // 0xF0-0xFF
+#undef U8_ASCII_ROW
+#undef U8_CONT_ROW
+};
+
+// NOTE(cya): length of the valid UTF-8 sequence at s, 0 if there isn't one
+static inline isize utf8_sequence_len(const u8 *s, const u8 *end)
+{
+    u8 first = g_utf8_first[*s];
+    isize len = first & 0xF;
+    if (len <= 1) {
+        return len;
+    } else if (end - s < len) {
+        return 0;
+    }
+
+    Utf8AcceptRange range = g_utf8_accept_ranges[first >> 4];
+    b32 valid = s[1] >= range.lo && s[1] <= range.hi;
+    for (isize i = 2; i < len; i++) {
+        valid &= (s[i] & 0xC0) == 0x80;
+    }
+
+    return valid ? len : 0;
+}
+
+/* Decodes the rune str starts with, returning how many bytes it takes. An
+ * invalid sequence decodes to CY_RUNE_INVALID with a width of 1 (a U+FFFD
+ * actually written in the source takes 3) */
+static inline isize utf8_decode(String str, Rune *rune_out)
+{
+    if (str.len < 1) {
+        return 0;
+    }
+
+    const u8 *s = str.text;
+    isize width = utf8_sequence_len(s, s + str.len);
+    if (width == 0) {
+        *rune_out = CY_RUNE_INVALID;
+        return 1;
+    } else if (width == 1) {
+        *rune_out = s[0];
+        return 1;
+    }
+
+    Rune rune = s[0] & (0x7F >> width);
+    for (isize i = 1; i < width; i++) {
+        rune = rune << 6 | (s[i] & 0x3F);
+    }
+
+    *rune_out = rune;
+    return width;
+}
+
+// NOTE(cya): code points in [s, end), invalid bytes counting as one each
+static inline isize utf8_rune_count(const u8 *s, const u8 *end)
+{
+    isize count = 0;
+    while (s < end) {
+        isize len = utf8_sequence_len(s, end);
+        s += len > 0 ? len : 1;
+        count += 1;
+    }
+
+    return count;
+}
+
+/* ---------------------------- Scan kernels -------------------------------- */
+static inline b32 scan_is_word_byte(u8 c)
+{
+    return ((u32)c | 0x20) - 'a' < 26 || (u32)c - '0' < 10 || c == '_';
+}
+
+static SCAN_WORD_PROC(scan_word_scalar)
+{
+    while (s < end && scan_is_word_byte(*s)) {
+        s += 1;
+    }
+
+    return s;
+}
+
+// NOTE(cya): where a literal's body goes on after the non-ASCII byte at s
+// (s itself if it doesn't start valid UTF-8)
+static inline const u8 *scan_skip_utf8(const u8 *s, const u8 *end)
+{
+    return s + utf8_sequence_len(s, end);
+}
+
+static SCAN_STRING_PROC(scan_string_scalar)
+{
+    while (s < end && *s != '"' && *s != '%' && *s != '\n' && *s != 0) {
+        const u8 *next = *s < 0x80 ? s + 1 : scan_skip_utf8(s, end);
+        if (next == s) {
+            break;
+        }
+
+        s = next;
+    }
+
+    return s;
+}
+
+static SCAN_COMMENT_PROC(scan_comment_scalar)
+{
+    while (s < end && *s != '@' && *s != 0) {
+        const u8 *next = *s < 0x80 ? s + 1 : scan_skip_utf8(s, end);
+        if (next == s) {
+            break;
+        }
+
+        s = next;
+    }
+
+    return s;
+}
+
+static SCAN_LINE_PROC(scan_line_scalar)
+{
+    while (s < end && *s != '\n') {
+        s += 1;
+    }
+
+    return s;
+}
+
+// NOTE(cya): ASCII is skipped 8 bytes at a time, only the rest is decoded
+static SCAN_UTF8_PROC(scan_utf8_scalar)
+{
+    while (s < end) {
+        u64 v;
+        if (end - s >= 8) {
+            cy_mem_copy(&v, s, sizeof(v));
+            if ((v & 0x8080808080808080ULL) == 0) {
+                s += 8;
+                continue;
+            }
+        }
+
+        isize len = utf8_sequence_len(s, end);
+        if (len == 0) {
+            break;
+        }
+
+        s += len;
+    }
+
+    return s;
+}
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define COMPILER_SCAN_X86 1
+#include <immintrin.h>
+
+#define SCAN_TARGET(isa) __attribute__((target(isa)))
+
+/* Goes through the bytes flagged in stop (a mask over the block of up to 32
+ * bytes at s), stepping over the ones that start valid UTF-8. Returns the
+ * first flagged byte that's ASCII or doesn't start a valid sequence, or NULL
+ * and where the scan goes on past the block (a sequence can cross into the
+ * next one) */
+static inline const u8 *scan_block_skip_utf8(
+    const u8 *s, const u8 *end, u32 stop, isize block_len, const u8 **next
+) {
+    *next = s + block_len;
+    while (stop != 0) {
+        const u8 *p = s + __builtin_ctz(stop);
+        isize len = *p < 0x80 ? 0 : utf8_sequence_len(p, end);
+        if (len == 0) {
+            return p;
+        }
+
+        isize skipped = p + len - s;
+        if (skipped >= block_len) {
+            *next = p + len;
+            break;
+        }
+
+        stop &= ~0U << skipped;
+    }
+
+    return NULL;
+}
+
+// NOTE(cya): 0xFF for the bytes of v in [lo, lo + n), there's no unsigned
+// compare in SSE2/AVX2 so both sides are flipped into signed range
+static inline SCAN_TARGET("sse2") __m128i scan_sse2_in_range(
+    __m128i v, u8 lo, u8 n
+) {
+    __m128i bias = _mm_set1_epi8((char)0x80);
+    __m128i off = _mm_xor_si128(_mm_sub_epi8(v, _mm_set1_epi8(lo)), bias);
+    return _mm_cmpgt_epi8(_mm_set1_epi8((char)(n ^ 0x80)), off);
+}
+
+static SCAN_TARGET("sse2") SCAN_WORD_PROC(scan_word_sse2)
+{
+    __m128i lower = _mm_set1_epi8(0x20), under = _mm_set1_epi8('_');
+    for (; end - s >= 16; s += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)s);
+        __m128i letter = scan_sse2_in_range(_mm_or_si128(v, lower), 'a', 26);
+        __m128i digit = scan_sse2_in_range(v, '0', 10);
+        __m128i word = _mm_or_si128(
+            _mm_or_si128(letter, digit), _mm_cmpeq_epi8(v, under)
+        );
+        u32 stop = ~(u32)_mm_movemask_epi8(word) & 0xFFFF;
+        if (stop != 0) {
+            return s + __builtin_ctz(stop);
+        }
+    }
+
+    return scan_word_scalar(s, end);
+}
+
+static SCAN_TARGET("sse2") SCAN_STRING_PROC(scan_string_sse2)
+{
+    __m128i quote = _mm_set1_epi8('"'), percent = _mm_set1_epi8('%');
+    __m128i lf = _mm_set1_epi8('\n'), zero = _mm_setzero_si128();
+    while (end - s >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)s);
+        __m128i hit = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, percent)),
+            _mm_or_si128(_mm_cmpeq_epi8(v, lf), _mm_cmpeq_epi8(v, zero))
+        );
+        // NOTE(cya): movemask of v itself flags the non-ASCII bytes
+        u32 stop = (u32)_mm_movemask_epi8(_mm_or_si128(hit, v));
+        if (stop == 0) {
+            s += 16;
+            continue;
+        } else if (s[__builtin_ctz(stop)] < 0x80) {
+            return s + __builtin_ctz(stop); // NOTE(cya): the usual stop
+        }
+
+        const u8 *next, *found = scan_block_skip_utf8(s, end, stop, 16, &next);
+        if (found != NULL) {
+            return found;
+        }
+
+        s = next;
+    }
+
+    return scan_string_scalar(s, end);
+}
+
+static SCAN_TARGET("sse2") SCAN_COMMENT_PROC(scan_comment_sse2)
+{
+    __m128i at = _mm_set1_epi8('@'), zero = _mm_setzero_si128();
+    while (end - s >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)s);
+        __m128i hit = _mm_or_si128(
+            _mm_cmpeq_epi8(v, at), _mm_cmpeq_epi8(v, zero)
+        );
+        u32 stop = (u32)_mm_movemask_epi8(_mm_or_si128(hit, v));
+        if (stop == 0) {
+            s += 16;
+            continue;
+        } else if (s[__builtin_ctz(stop)] < 0x80) {
+            return s + __builtin_ctz(stop); // NOTE(cya): the usual stop
+        }
+
+        const u8 *next, *found = scan_block_skip_utf8(s, end, stop, 16, &next);
+        if (found != NULL) {
+            return found;
+        }
+
+        s = next;
+    }
+
+    return scan_comment_scalar(s, end);
+}
+
+static SCAN_TARGET("sse2") SCAN_LINE_PROC(scan_line_sse2)
+{
+    __m128i lf = _mm_set1_epi8('\n');
+    for (; end - s >= 16; s += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)s);
+        u32 stop = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(v, lf));
+        if (stop != 0) {
+            return s + __builtin_ctz(stop);
+        }
+    }
+
+    return scan_line_scalar(s, end);
+}
+
+static SCAN_TARGET("sse2") SCAN_UTF8_PROC(scan_utf8_sse2)
+{
+    while (end - s >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)s);
+        u32 high = (u32)_mm_movemask_epi8(v);
+        const u8 *next, *found = scan_block_skip_utf8(s, end, high, 16, &next);
+        if (found != NULL) {
+            return found;
+        }
+
+        s = next;
+    }
+
+    return scan_utf8_scalar(s, end);
+}
+
+static inline SCAN_TARGET("avx2") __m256i scan_avx2_in_range(
+    __m256i v, u8 lo, u8 n
+) {
+    __m256i bias = _mm256_set1_epi8((char)0x80);
+    __m256i off = _mm256_xor_si256(
+        _mm256_sub_epi8(v, _mm256_set1_epi8(lo)), bias
+    );
+    return _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(n ^ 0x80)), off);
+}
+
+static SCAN_TARGET("avx2") SCAN_WORD_PROC(scan_word_avx2)
+{
+    __m256i lower = _mm256_set1_epi8(0x20), under = _mm256_set1_epi8('_');
+    for (; end - s >= 32; s += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)s);
+        __m256i letter = scan_avx2_in_range(
+            _mm256_or_si256(v, lower), 'a', 26
+        );
+        __m256i digit = scan_avx2_in_range(v, '0', 10);
+        __m256i word = _mm256_or_si256(
+            _mm256_or_si256(letter, digit), _mm256_cmpeq_epi8(v, under)
+        );
+        u32 stop = ~(u32)_mm256_movemask_epi8(word);
+        if (stop != 0) {
+            return s + __builtin_ctz(stop);
+        }
+    }
+
+    return scan_word_sse2(s, end);
+}
+
+static SCAN_TARGET("avx2") SCAN_STRING_PROC(scan_string_avx2)
+{
+    __m256i quote = _mm256_set1_epi8('"'), percent = _mm256_set1_epi8('%');
+    __m256i lf = _mm256_set1_epi8('\n'), zero = _mm256_setzero_si256();
+    while (end - s >= 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)s);
+        __m256i hit = _mm256_or_si256(
+            _mm256_or_si256(
+                _mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, percent)
+            ),
+            _mm256_or_si256(
+                _mm256_cmpeq_epi8(v, lf), _mm256_cmpeq_epi8(v, zero)
+            )
+        );
+        u32 stop = (u32)_mm256_movemask_epi8(_mm256_or_si256(hit, v));
+        if (stop == 0) {
+            s += 32;
+            continue;
+        } else if (s[__builtin_ctz(stop)] < 0x80) {
+            return s + __builtin_ctz(stop); // NOTE(cya): the usual stop
+        }
+
+        const u8 *next, *found = scan_block_skip_utf8(s, end, stop, 32, &next);
+        if (found != NULL) {
+            return found;
+        }
+
+        s = next;
+    }
+
+    return scan_string_sse2(s, end);
+}
+
+static SCAN_TARGET("avx2") SCAN_COMMENT_PROC(scan_comment_avx2)
+{
+    __m256i at = _mm256_set1_epi8('@'), zero = _mm256_setzero_si256();
+    while (end - s >= 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)s);
+        __m256i hit = _mm256_or_si256(
+            _mm256_cmpeq_epi8(v, at), _mm256_cmpeq_epi8(v, zero)
+        );
+        u32 stop = (u32)_mm256_movemask_epi8(_mm256_or_si256(hit, v));
+        if (stop == 0) {
+            s += 32;
+            continue;
+        } else if (s[__builtin_ctz(stop)] < 0x80) {
+            return s + __builtin_ctz(stop); // NOTE(cya): the usual stop
+        }
+
+        const u8 *next, *found = scan_block_skip_utf8(s, end, stop, 32, &next);
+        if (found != NULL) {
+            return found;
+        }
+
+        s = next;
+    }
+
+    return scan_comment_sse2(s, end);
+}
+
+static SCAN_TARGET("avx2") SCAN_LINE_PROC(scan_line_avx2)
+{
+    __m256i lf = _mm256_set1_epi8('\n');
+    for (; end - s >= 32; s += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)s);
+        u32 stop = (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, lf));
+        if (stop != 0) {
+            return s + __builtin_ctz(stop);
+        }
+    }
+
+    return scan_line_sse2(s, end);
+}
+
+static SCAN_TARGET("avx2") SCAN_UTF8_PROC(scan_utf8_avx2)
+{
+    while (end - s >= 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)s);
+        u32 high = (u32)_mm256_movemask_epi8(v);
+        const u8 *next, *found = scan_block_skip_utf8(s, end, high, 32, &next);
+        if (found != NULL) {
+            return found;
+        }
+
+        s = next;
+    }
+
+    return scan_utf8_sse2(s, end);
+}
+#endif
+
+/* Most words and strings are short enough that calling into a kernel costs
+ * more than it saves, so their first bytes are scanned inline */
+#define SCAN_INLINE_LEN 16
+
+static inline const u8 *scan_word(
+    const ScanKernels *k, const u8 *s, const u8 *end
+) {
+    const u8 *limit = s + CY_MIN(end - s, SCAN_INLINE_LEN);
+    while (s < limit && scan_is_word_byte(*s)) {
+        s += 1;
+    }
+
+    return s == limit && s < end ? k->word(s, end) : s;
+}
+
+static inline const u8 *scan_string(
+    const ScanKernels *k, const u8 *s, const u8 *end
+) {
+    const u8 *limit = s + CY_MIN(end - s, SCAN_INLINE_LEN);
+    while (s < limit && *s != '"' && *s != '%' && *s != '\n' &&
+        *s != 0 && *s < 0x80) {
+        s += 1;
+    }
+
+    // NOTE(cya): non-ASCII bytes are left to the kernel to check
+    b32 scanned = s < limit && *s < 0x80;
+    return !scanned && s < end ? k->string(s, end) : s;
+}
+
+typedef enum {
+    SCAN_KERNELS_SCALAR,
+#if defined(COMPILER_SCAN_X86)
+    SCAN_KERNELS_SSE2,
+    SCAN_KERNELS_AVX2,
+#endif
+    SCAN_KERNELS_COUNT,
+} ScanKernelsKind;
+
+static const ScanKernels g_scan_kernels[SCAN_KERNELS_COUNT] = {
+    [SCAN_KERNELS_SCALAR] = {
+        "scalar", scan_word_scalar, scan_string_scalar, scan_comment_scalar,
+        scan_line_scalar, scan_utf8_scalar,
+    },
+#if defined(COMPILER_SCAN_X86)
+    [SCAN_KERNELS_SSE2] = {
+        "sse2", scan_word_sse2, scan_string_sse2, scan_comment_sse2,
+        scan_line_sse2, scan_utf8_sse2,
+    },
+    [SCAN_KERNELS_AVX2] = {
+        "avx2", scan_word_avx2, scan_string_avx2, scan_comment_avx2,
+        scan_line_avx2, scan_utf8_avx2,
+    },
+#endif
+};
+
+static inline b32 scan_kernels_supported(ScanKernelsKind kind)
+{
+    switch (kind) {
+#if defined(COMPILER_SCAN_X86)
+    case SCAN_KERNELS_SSE2: return __builtin_cpu_supports("sse2");
+    case SCAN_KERNELS_AVX2: return __builtin_cpu_supports("avx2");
+#endif
+    default: return true;
+    }
+}
+
+// NOTE(cya): the widest kernels the running CPU supports
+static inline const ScanKernels *scan_kernels_best(void)
+{
+    isize kind = SCAN_KERNELS_COUNT - 1;
+    while (!scan_kernels_supported(kind)) {
+        kind -= 1;
+    }
+
+    return &g_scan_kernels[kind];
+}
+
+/* ---------------------------- Line index ---------------------------------- */
+/* Where each line of the source starts. Positions are only needed for
+ * diagnostics, so nothing is indexed until one asks for a position, and then
+ * only as far as that position (later ones pick up where it stopped) */
+typedef struct {
+    CyAllocator alloc;
+    const u8 *src;
+    const u8 *end;
+    const u8 *scanned; // NOTE(cya): line feeds before this are indexed
+    const ScanKernels *scan;
+
+    u32 *starts;
+    isize len;
+    isize cap;
+} LineIndex;
+
+#define LINE_INDEX_INIT_CAP 0x100
+
+static inline LineIndex line_index_init(CyAllocator a, String src)
+{
+    return (LineIndex){
+        .alloc = a,
+        .src = src.text,
+        .end = src.text + src.len,
+        .scanned = src.text,
+        .scan = scan_kernels_best(),
+    };
+}
+
+static inline b32 line_index_push(LineIndex *li, u32 start)
+{
+    if (li->len == li->cap) {
+        isize new_cap = CY_MAX(li->cap * 2, LINE_INDEX_INIT_CAP);
+        u32 *starts = cy_resize_array(
+            li->alloc, li->starts, u32, li->cap, new_cap
+        );
+        if (starts == NULL) {
+            return false;
+        }
+
+        li->starts = starts;
+        li->cap = new_cap;
+    }
+
+    li->starts[li->len++] = start;
+    return true;
+}
+
+// NOTE(cya): indexes every line feed before offset that isn't yet
+static void line_index_extend(LineIndex *li, u32 offset)
+{
+    if (li->len == 0 && !line_index_push(li, 0)) {
+        return;
+    }
+
+    const u8 *target = li->src + offset;
+    while (li->scanned < target) {
+        const u8 *lf = li->scan->line(li->scanned, li->end);
+        if (lf == li->end) {
+            li->scanned = li->end;
+            break;
+        } else if (!line_index_push(li, (u32)(lf + 1 - li->src))) {
+            break;
+        }
+
+        li->scanned = lf + 1;
+    }
+}
+
+/* Binary searches the index for the line offset is in. If the index couldn't
+ * grow (out of memory) the rest of the way is counted byte by byte */
+static TokenPos line_index_pos(LineIndex *li, u32 offset)
+{
+    line_index_extend(li, offset);
+
+    isize lo = 0, hi = li->len;
+    while (hi - lo > 1) {
+        isize mid = lo + (hi - lo) / 2;
+        if (li->starts[mid] <= offset) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    TokenPos pos = { .line = (i32)lo + 1 };
+    const u8 *line_start = li->src + (li->len > 0 ? li->starts[lo] : 0);
+    for (const u8 *s = line_start; s < li->src + offset; s++) {
+        if (*s == '\n') {
+            pos.line += 1;
+            line_start = s + 1;
+        }
+    }
+
+    pos.col = 1 + (i32)utf8_rune_count(line_start, li->src + offset);
+    return pos;
+}
+
+#if defined(__GNUC__)
+#define TOKENIZER_NOINLINE __attribute__((noinline))
+#else
+#define TOKENIZER_NOINLINE
+#endif
+
+/* Out of line so that stepping over ASCII (nearly every rune outside of
+ * literals, whose bodies the scan kernels skip) stays a leaf function */
+static TOKENIZER_NOINLINE void tokenizer_decode_rune(Tokenizer *t)
+{
+    Rune rune = CY_RUNE_INVALID;
+    isize width = utf8_decode((String){
+        .text = t->cur,
+        .len = t->end - t->cur
+    }, &rune);
+    t->next += width;
+    t->cur_rune = rune;
+}
+
+static void tokenizer_advance_to_next_rune(Tokenizer *t)
+{
+    if (t->next >= t->end) {
+        t->cur = t->end;
+        t->cur_rune = CY_RUNE_EOF;
+        return;
+    }
+
+    t->cur = t->next;
+    Rune rune = *t->cur;
+    if (rune & 0x80) {
+        // NOTE(cya): non-ASCII UTF-8 code unit
+        tokenizer_decode_rune(t);
+        return;
+    }
+
+    t->next += 1;
+    t->cur_rune = rune;
+}
+
+// NOTE(cya): a U+FFFD actually written in the source is 3 bytes wide
+static inline b32 tokenizer_at_invalid_utf8(const Tokenizer *t)
+{
+    return t->cur_rune == CY_RUNE_INVALID && t->next - t->cur == 1;
+}
+
+/* Moves the tokenizer to stop as if it had advanced rune by rune, where every
+ * byte in [t->next, stop) is part of a rune the tokenizer has no use for (as
+ * found by the scan kernels): ASCII, or valid UTF-8 inside a literal */
+static inline void tokenizer_skip_to(Tokenizer *t, const u8 *stop)
+{
+    if (stop > t->next) {
+        t->cur = stop - 1;
+        t->next = stop;
+        t->cur_rune = *t->cur;
+    }
+
+    tokenizer_advance_to_next_rune(t);
+}
+
+static inline Tokenizer tokenizer_init(String src)
+{
+#ifdef CY_DEBUG
+    keyword_lookup_validate();
+#endif
+
+    const u8 *start = (const u8*)src.text;
+    const u8 *end = start + src.len;
+    Tokenizer t = {
+        .start = start,
+        .end = end,
+        .cur = start,
+        .next = start,
+        .scan = scan_kernels_best(),
+    };
+
+    tokenizer_advance_to_next_rune(&t);
+    if (t.cur_rune == CY_RUNE_BOM) { // NOTE(cya): is this even necessary?
+        tokenizer_advance_to_next_rune(&t);
+    }
+
+    return t;
+}
+
+static inline b32 rune_is_letter(Rune r)
+{
+    if (r < 0x80) {
+        // NOTE(cya): (r >= 'a' && r <= 'z') || (r >= 'A' && r <= 'Z');
+        return ((u32)r | 0x20) - 0x61 < 26;
+    } else {
+        // TODO(cya): detect non-ascii unicode letters
+        return false;
+    }
+}
+
+static inline b32 rune_is_digit(Rune r)
+{
+    if (r < 0x80) {
+        return (u32)r - '0' < 10;
+    } else {
+        return false;
+    }
+}
+
+static inline b32 rune_is_alphanumeric(Rune r)
+{
+    return rune_is_letter(r) || rune_is_digit(r);
+}
+
+static inline b32 rune_is_uppercase(Rune r) {
+    return (u32)r - 0x41 < 26;
+}
+
+static inline b32 token_is_ident(String tok)
+{
+    if (tok.len < 3) {
+        return false;
+    }
+
+    const u8 *s = tok.text;
+    b32 has_prefix = (s[1] == '_' && (
+        s[0] == 'i' || s[0] == 'f' || s[0] == 'b' || s[0] == 's'
+    ));
+    if (!has_prefix || !rune_is_letter(s[2])) {
+        return false;
+    }
+
+    for (isize i = 2; i < tok.len; i++) {
+        Rune r = s[i];
+        if (!rune_is_alphanumeric(r)) {
+            return false;
+        }
+
+        b32 has_adjacent_uppercases = i < tok.len - 1 &&
+            rune_is_uppercase(r) && rune_is_uppercase(s[i + 1]);
+        if (has_adjacent_uppercases) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// NOTE(cya): maybe_keyword is false if the word has digits or underscores, or
+// starts with an uppercase letter
+static inline TokenKind token_kind_from_word(String word, b32 maybe_keyword)
+{
+    if (maybe_keyword) {
+        return keyword_lookup(word);
+    }
+
+    return token_is_ident(word) ? C_TOKEN_IDENT : C_TOKEN_INVALID;
+}
+
+static inline b32 is_whitespace(Rune r)
+{
+    return r == ' ' || r == '\t' ||
+        r == '\r' || r == '\n' ||
+        r == '\v' || r == '\f';
+}
+
+static inline void tokenizer_skip_whitespace(Tokenizer *t)
+{
+    while (is_whitespace(t->cur_rune)) {
+        tokenizer_advance_to_next_rune(t);
+    }
+}
+
+static inline String string_from_token_kind(TokenKind kind)
+{
+    if (kind < 0 || kind >= C_TOKEN_COUNT) {
+        return g_token_strings[C_TOKEN_INVALID];
+    } else if (kind > C_TOKEN__OPERATOR_BEGIN && kind < C_TOKEN__OPERATOR_END) {
+        return cy_string_view_create_c("símbolo especial");
+    } else if (kind > C_TOKEN__KEYWORD_BEGIN && kind < C_TOKEN__KEYWORD_END) {
+        return cy_string_view_create_c("palavra reservada");
+    }
+
+    return g_token_strings[kind];
+}
+
+static inline CyString cy_string_from_token_kind(CyAllocator a, TokenKind kind)
+{
+    return cy_string_create_view(a, string_from_token_kind(kind));
+}
+
+static inline TokenKind token_kind_from_string(String str)
+{
+    for (isize i = 0; i < C_TOKEN_COUNT; i++) {
+        if (cy_string_view_are_equal(str, g_token_strings[i])) {
+            return i;
+        }
+    }
+
+    return C_TOKEN_INVALID;
+}
+
+static inline void tokenizer_error(
+    Tokenizer *t, Token *bad_tok, TokenizerError err, const char *err_desc
+) {
+    if (bad_tok != NULL) {
+        t->bad_tok = *bad_tok;
+    }
+
+    t->err = err;
+    t->err_desc = (const u8*)err_desc;
+}
+
+// NOTE(cya): for errors about the rune the tokenizer is at, not the token
+static inline void tokenizer_error_at_rune(Tokenizer *t, TokenizerError err)
+{
+    Token bad_tok = {
+        .kind = C_TOKEN_INVALID,
+        .offset = (u32)(t->cur - t->start),
+        .len = (u32)(t->next - t->cur),
+    };
+    tokenizer_error(t, &bad_tok, err, NULL);
+}
+
+/* --------------------------- Numeric constants ---------------------------- */
+// NOTE(cya): the value of 8 ASCII digits at once (SWAR), first one highest
+static inline u32 parse_eight_digits(const u8 *s)
+{
+    u64 v;
+    cy_mem_copy(&v, s, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    v -= 0x3030303030303030ULL;
+    v = v * 10 + (v >> 8); // NOTE(cya): pairs of digits
+    v = ((v & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)) +
+        ((v >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32))) >> 32;
+    return (u32)v;
+}
+
+// NOTE(cya): appends len ASCII digits to acc (the result must fit in a u64)
+static inline u64 parse_digits(u64 acc, const u8 *s, isize len)
+{
+    for (; len >= 8; s += 8, len -= 8) {
+        acc = acc * 100000000 + parse_eight_digits(s);
+    }
+
+    for (; len > 0; s++, len--) {
+        acc = acc * 10 + (*s - '0');
+    }
+
+    return acc;
+}
+
+#define U64_MAX_DIGITS 19 // NOTE(cya): that always fit
+
+// NOTE(cya): false if the constant doesn't fit in an isize
+static inline b32 parse_int(String digits, isize *out)
+{
+    if (digits.len > U64_MAX_DIGITS) {
+        return false;
+    }
+
+    u64 val = parse_digits(0, digits.text, digits.len);
+    *out = (isize)val;
+    return val <= (u64)ISIZE_MAX;
+}
+
+static inline f64 f64_from_bits(u64 bits)
+{
+    f64 val;
+    cy_mem_copy(&val, &bits, sizeof(val));
+    return val;
+}
+
+#define F64_MANTISSA_BITS 52
+#define F64_INFINITE_POWER 0x7FF
+
+static inline isize leading_zeros_u64(u64 v)
+{
+#if defined(__GNUC__)
+    return v == 0 ? 64 : __builtin_clzll(v);
+#else
+    isize n = 0;
+    for (u64 bit = 1ULL << 63; bit != 0 && (v & bit) == 0; bit >>= 1) {
+        n += 1;
+    }
+
+    return n;
+#endif
+}
+
+// NOTE(cya): the full 128-bit product of a and b
+static inline void mul_u64_full(u64 a, u64 b, u64 *hi, u64 *lo)
+{
+    u64 a_lo = (u32)a, a_hi = a >> 32, b_lo = (u32)b, b_hi = b >> 32;
+    u64 p0 = a_lo * b_lo, p1 = a_lo * b_hi, p2 = a_hi * b_lo;
+    u64 mid = (p0 >> 32) + (u32)p1 + (u32)p2;
+    *lo = mid << 32 | (u32)p0;
+    *hi = a_hi * b_hi + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+}
+
+#if !defined(COMPILER_GEN)
+#include "compiler_pow5.h"
+
+/* Eisel-Lemire: w * 10^q rounded to the nearest f64 (ties to even), for any
+ * w that's exact (see Mushtak & Lemire, "Fast Number Parsing Without
+ * Fallback"). The significand of 10^q is w's times 5^q's, from the table */
+static inline f64 f64_from_decimal(u64 w, isize q)
+{
+    if (w == 0 || q < POW5_GEN_MIN_EXP) {
+        return 0.0;
+    } else if (q > POW5_GEN_MAX_EXP) {
+        return f64_from_bits((u64)F64_INFINITE_POWER << F64_MANTISSA_BITS);
+    }
+
+    isize lz = leading_zeros_u64(w);
+    w <<= lz;
+
+    const u64 *pow5 = g_pow5_128[q - POW5_GEN_MIN_EXP];
+    u64 hi, lo;
+    mul_u64_full(w, pow5[0], &hi, &lo);
+
+    // NOTE(cya): the low half only matters when the bits below the mantissa
+    // (and the rounding bits) could still carry
+    u64 precision_mask = U64_MAX >> (F64_MANTISSA_BITS + 3);
+    if ((hi & precision_mask) == precision_mask) {
+        u64 hi2, lo2;
+        mul_u64_full(w, pow5[1], &hi2, &lo2);
+        lo += hi2;
+        hi += hi2 > lo;
+    }
+
+    isize upper_bit = (isize)(hi >> 63);
+    isize shift = upper_bit + 64 - F64_MANTISSA_BITS - 3;
+    u64 mantissa = hi >> shift;
+
+    // NOTE(cya): floor(log2(10^q)) + 63, with (152170 + 65536) / 2^16 as
+    // log2(10)
+    isize power2 = (((152170 + 65536) * q) >> 16) + 63 + upper_bit - lz + 1023;
+    if (power2 <= 0) {
+        // NOTE(cya): subnormal (or zero)
+        if (-power2 + 1 >= 64) {
+            return 0.0;
+        }
+
+        mantissa >>= -power2 + 1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        power2 = mantissa < (1ULL << F64_MANTISSA_BITS) ? 0 : 1;
+        return f64_from_bits((u64)power2 << F64_MANTISSA_BITS | mantissa);
+    }
+
+    // NOTE(cya): exactly halfway between two floats (only possible when 5^q
+    // fits in 64 bits) rounds to even instead of up
+    if (lo <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 &&
+        (mantissa << shift) == hi) {
+        mantissa &= ~1ULL;
+    }
+
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >= (2ULL << F64_MANTISSA_BITS)) {
+        mantissa = 1ULL << F64_MANTISSA_BITS;
+        power2 += 1;
+    }
+
+    mantissa &= ~(1ULL << F64_MANTISSA_BITS);
+    if (power2 >= F64_INFINITE_POWER) {
+        power2 = F64_INFINITE_POWER;
+        mantissa = 0;
+    }
+
+    return f64_from_bits((u64)power2 << F64_MANTISSA_BITS | mantissa);
+}
+#endif
+
+#define FLOAT_SLOW_MAX_DIGITS 800
+
+/* Constants with more than 19 significant digits that round differently
+ * depending on the digits that didn't fit go through strtod. Halfway points
+ * between f64s have at most 767 digits, so any past the first 800 only
+ * matter as a nonzero (sticky) one */
+static f64 parse_float_slow(String text)
+{
+    char buf[FLOAT_SLOW_MAX_DIGITS + 0x20];
+    isize len = 0, exp = 0;
+    b32 after_comma = false, sticky = false;
+    for (isize i = 0; i < text.len; i++) {
+        char c = text.text[i];
+        if (c == ',') {
+            after_comma = true;
+        } else if (len == 0 && c == '0') {
+            exp -= after_comma;
+        } else if (len < FLOAT_SLOW_MAX_DIGITS) {
+            buf[len++] = c;
+            exp -= after_comma;
+        } else {
+            sticky |= c != '0';
+            exp += !after_comma;
+        }
+    }
+
+    if (len == 0) {
+        return 0.0;
+    } else if (sticky) {
+        buf[len++] = '1';
+        exp -= 1;
+    }
+
+    snprintf(buf + len, sizeof(buf) - len, "e%td", exp);
+    return strtod(buf, NULL);
+}
+
+// NOTE(cya): the powers of ten an f64 holds exactly
+static const f64 g_pow10_f64[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+    1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+/* text is a constante_float (digits, a comma and more digits). Its first 19
+ * significant digits go into w, and the value is w * 10^q correctly rounded.
+ * False if it's too large for an f64 */
+static inline b32 parse_float(String text, TokenValue *out)
+{
+    const u8 *s = text.text, *end = s + text.len, *comma = s;
+    while (*comma != ',') {
+        comma += 1;
+    }
+
+    isize frac_len = end - comma - 1;
+    const u8 *int_digits = s, *frac_digits = comma + 1;
+    while (int_digits < comma && *int_digits == '0') {
+        int_digits += 1;
+    }
+
+    if (int_digits == comma) {
+        while (frac_digits < end && *frac_digits == '0') {
+            frac_digits += 1;
+        }
+    }
+
+    isize int_len = comma - int_digits, sig_frac_len = end - frac_digits;
+    isize digits = int_len + sig_frac_len, q = -frac_len;
+    b32 truncated = digits > U64_MAX_DIGITS;
+    if (truncated) {
+        q += digits - U64_MAX_DIGITS;
+        int_len = CY_MIN(int_len, U64_MAX_DIGITS);
+        sig_frac_len = U64_MAX_DIGITS - int_len;
+    }
+
+    u64 w = parse_digits(0, int_digits, int_len);
+    w = parse_digits(w, frac_digits, sig_frac_len);
+
+    f64 val;
+    if (!truncated && q >= -22 && w <= (1ULL << 53)) {
+        // NOTE(cya): both w and 10^-q are exact, so one division rounds right
+        val = (f64)w / g_pow10_f64[-q];
+    } else {
+#if defined(COMPILER_GEN)
+        // NOTE(cya): the generator can't use the table it's generating
+        val = parse_float_slow(text);
+#else
+        val = f64_from_decimal(w, q);
+        if (truncated && f64_from_decimal(w + 1, q) != val) {
+            val = parse_float_slow(text);
+        }
+#endif
+    }
+
+    out->f.val = val;
+    out->f.precision = frac_len;
+    return val <= F64_MAX;
+}
+
+// NOTE(cya): token is a constante_int or constante_float, just lexed
+static inline void tokenizer_read_number(Tokenizer *t, Token *token)
+{
+    String text = token_text(t->start, *token);
+    TokenizerError err = T_ERR_NONE;
+    if (token->kind == C_TOKEN_INTEGER) {
+        if (!parse_int(text, &t->value.i)) {
+            err = T_ERR_INT_OUT_OF_RANGE;
+        }
+    } else if (!parse_float(text, &t->value)) {
+        err = T_ERR_FLOAT_OUT_OF_RANGE;
+    }
+
+    if (err != T_ERR_NONE) {
+        token->kind = C_TOKEN_INVALID;
+        tokenizer_error(t, token, err, NULL);
+    }
+}
+
+static inline void tokenizer_parse_numeric_constant(
+    Tokenizer *t, Token *token_out
+) {
+    if (t->cur_rune != '0') {
+        do {
+            tokenizer_advance_to_next_rune(t);
+        } while ((rune_is_digit(t->cur_rune)));
+    } else {
+        tokenizer_advance_to_next_rune(t);
+        t->cur_rune = t->cur_rune;
+    }
+
+    b32 is_float = t->cur_rune == ',' &&
+        t->next < t->end && rune_is_digit(*t->next);
+    if (is_float) {
+        token_out->kind = C_TOKEN_FLOAT;
+
+        tokenizer_advance_to_next_rune(t);
+        t->cur_rune = t->cur_rune;
+
+        const u8 *start = t->cur;
+        const u8 *end = start;
+        do {
+            end += 1;
+        } while (end < t->end && rune_is_digit(*end));
+
+        while (*(end - 1) == '0') {
+            end -= 1;
+        }
+
+        isize adv_len = end - start;
+        if (end == start && *start == '0') {
+            adv_len = 1;
+        }
+
+        while (adv_len-- > 0) {
+            tokenizer_advance_to_next_rune(t);
+            t->cur_rune = t->cur_rune;
+        }
+    } else {
+        token_out->kind = C_TOKEN_INTEGER;
+    }
+}
+
+static inline void tokenizer_parse_string_literal(
+    Tokenizer *t, Token *token_out
+) {
+    do {
+        const u8 *stop = scan_string(t->scan, t->next, t->end);
+        tokenizer_skip_to(t, stop);
+
+        if (t->cur_rune == '%' && t->next < t->end && *t->next != 'x') {
+            Token bad_tok = {
+                .kind = C_TOKEN_INVALID,
+                .offset = (u32)(t->cur - t->start),
+                .len = 1,
+            };
+            if (*t->next != '"') {
+                bad_tok.len += 1;
+            }
+
+            tokenizer_error(
+                t, &bad_tok, T_ERR_INVALID_STRING,
+                "especificador de formato inválido (%*)"
+            );
+            return;
+        } else if (t->cur_rune == '\n') {
+            tokenizer_error(
+                t, token_out, T_ERR_INVALID_STRING,
+                "quebra de linha ilegal dentro da literal"
+            );
+            return;
+        } else if (tokenizer_at_invalid_utf8(t)) {
+            tokenizer_error_at_rune(t, T_ERR_INVALID_UTF8);
+            return;
+        }
+    } while (t->cur < t->end && *t->cur != '"');
+
+    if (t->cur >= t->end) {
+        tokenizer_error(
+            t, token_out, T_ERR_INVALID_STRING, "feche-a com \""
+        );
+        return;
+    }
+
+    tokenizer_advance_to_next_rune(t);
+    token_out->kind = C_TOKEN_STRING;
+}
+
+static inline void tokenizer_parse_comment(Tokenizer *t, Token *token_out)
+{
+    const u8 *start = t->cur;
+    token_out->len += 1;
+
+    tokenizer_advance_to_next_rune(t);
+    tokenizer_advance_to_next_rune(t);
+
+    while (t->cur < t->end && t->cur_rune != '@') {
+        if (tokenizer_at_invalid_utf8(t)) {
+            tokenizer_error_at_rune(t, T_ERR_INVALID_UTF8);
+            return;
+        }
+
+        const u8 *stop = t->scan->comment(t->next, t->end);
+        tokenizer_skip_to(t, stop);
+    }
+
+    if (t->end - t->cur < 2) {
+        tokenizer_error(
+            t, token_out, T_ERR_INVALID_COMMENT,
+            "feche-o com uma quebra de linha seguida por @<"
+        );
+        return;
+    } else if (*t->next != '<') {
+        tokenizer_error(
+            t, token_out, T_ERR_INVALID_COMMENT, "@ ilegal dentro da literal"
+        );
+        return;
+    }
+
+    const u8 *end = t->next;
+    tokenizer_advance_to_next_rune(t);
+    tokenizer_advance_to_next_rune(t);
+
+    // NOTE(cya): should detect CR/LF/CRLF line endings correctly
+    b32 malformed =
+        (*(end - 2) != '\n' && *(end - 2) != '\r') ||
+        (*(start + 2) != '\r' && *(start + 2) != '\n');
+    if (malformed) {
+        tokenizer_error(t, token_out, T_ERR_INVALID_COMMENT, "mal formatado");
+        return;
+    }
+
+    token_out->kind = C_TOKEN_COMMENT;
+}
+
+static Token tokenizer_get_token(Tokenizer *t)
+{
+    tokenizer_skip_whitespace(t);
+
+    const u8 *start = t->cur;
+    Token token = {
+        .kind = C_TOKEN_INVALID,
+        .offset = (u32)(start - t->start),
+        .len = 1,
+    };
+
+    Rune cur_rune = t->cur_rune;
+    if (rune_is_letter(cur_rune)) {
+        const u8 *stop = scan_word(t->scan, t->next, t->end);
+        tokenizer_skip_to(t, stop);
+
+        String word = { .text = start, .len = t->cur - start };
+        token.len = (u32)word.len;
+
+        // NOTE(cya): keywords are made of letters only (and never start with
+        // an uppercase one), so anything else is checked as an identifier
+        b32 maybe_keyword = !rune_is_uppercase(cur_rune);
+        for (isize i = 1; maybe_keyword && i < word.len; i++) {
+            maybe_keyword = rune_is_letter(word.text[i]);
+        }
+
+        token.kind = token_kind_from_word(word, maybe_keyword);
+        if (token.kind == C_TOKEN_INVALID) {
+            TokenizerError err = maybe_keyword ?
+                T_ERR_INVALID_KEYWORD : T_ERR_INVALID_IDENT;
+            tokenizer_error(t, &token, err, NULL);
+        }
+
+        return token;
+    } else {
+        switch (cur_rune) {
+        case CY_RUNE_EOF: {
+            token.kind = C_TOKEN_EOF;
+        } break;
+        case '0':
+        case '1':
+        case '2':
+        case '3':
+        case '4':
+        case '5':
+        case '6':
+        case '7':
+        case '8':
+        case '9': {
+            tokenizer_parse_numeric_constant(t, &token);
+        } break;
+        case '"': {
+            tokenizer_parse_string_literal(t, &token);
+        } break;
+        case ';':
+        case ',':
+        case '(':
+        case ')':
+        case '<':
+        case '+':
+        case '-':
+        case '*':
+        case '/': {
+            String s = cy_string_view_create_len((const char*)t->cur, 1);
+            tokenizer_advance_to_next_rune(t);
+            token.kind = token_kind_from_string(s);
+            return token;
+        } break;
+        case '&':
+        case '|':
+        case '=':
+        case '!':
+        case '>': {
+            String s = cy_string_view_create_len((const char*)t->cur, 1);
+            if (t->next < t->end) {
+                Rune next_rune = *t->next;
+                b32 is_cmp = (cur_rune == '&' && next_rune == '&') ||
+                    (cur_rune == '|' && next_rune == '|') ||
+                    (cur_rune == '=' && next_rune == '=') ||
+                    (cur_rune == '!' && next_rune == '=');
+                b32 is_comment = (cur_rune == '>' && next_rune == '@');
+                if (is_cmp) {
+                    s.len += 1;
+                    tokenizer_advance_to_next_rune(t);
+                    tokenizer_advance_to_next_rune(t);
+                    token.kind = token_kind_from_string(s);
+                } else if (is_comment) {
+                    tokenizer_parse_comment(t, &token);
+                } else {
+                    b32 invalid = (cur_rune == '&' || cur_rune == '|') &&
+                        next_rune != cur_rune;
+                    if (invalid) {
+                        tokenizer_error(t, &token, T_ERR_INVALID_SYMBOL, NULL);
+                    } else {
+                        tokenizer_advance_to_next_rune(t);
+                        token.kind = token_kind_from_string(s);
+                    }
+                }
+            } else {
+                tokenizer_advance_to_next_rune(t);
+                token.kind = token_kind_from_string(s);
+                if (token.kind == C_TOKEN_INVALID) {
+                    tokenizer_error(t, &token, T_ERR_INVALID_SYMBOL, NULL);
+                }
+            }
+        } break;
+        default: {
+            if (tokenizer_at_invalid_utf8(t)) {
+                tokenizer_error(t, &token, T_ERR_INVALID_UTF8, NULL);
+            } else {
+                token.len = (u32)(t->next - t->cur);
+                tokenizer_error(t, &token, T_ERR_INVALID_SYMBOL, NULL);
+            }
+        } break;
+        }
+    }
+
+    token.len = (u32)(t->cur - start);
+    if (token.kind == C_TOKEN_INTEGER || token.kind == C_TOKEN_FLOAT) {
+        tokenizer_read_number(t, &token);
+    }
+
+    return token;
+}
+
+#if !defined(COMPILER_GEN)
+#include "compiler_dfa.h"
+
+CY_STATIC_ASSERT(DFA_GEN_LABEL_COUNT == DFA_LABEL_COUNT);
+
+#define DFA_DEAD 0
+#define DFA_START 1
+
+/* The DFA matches bytes, not runes, so the literals it lexes are checked for
+ * invalid UTF-8 afterwards, up to where the rune backend would have decoded
+ * them. Reports the first bad sequence in [from, to) */
+static b32 tokenizer_dfa_check_utf8(Tokenizer *t, u32 from, u32 to)
+{
+    const u8 *end = t->start + to;
+    const u8 *bad = t->scan->utf8(t->start + from, end);
+    if (bad == end) {
+        return true;
+    }
+
+    Token bad_tok = {
+        .kind = C_TOKEN_INVALID,
+        .offset = (u32)(bad - t->start),
+        .len = 1,
+    };
+    tokenizer_error(t, &bad_tok, T_ERR_INVALID_UTF8, NULL);
+    return false;
+}
+
+// NOTE(cya): reports the same errors (and bad tokens) as the rune backend
+static void tokenizer_dfa_error(Tokenizer *t, Token *token, DfaLabel label)
+{
+    u32 match_end = token->offset + token->len;
+    u32 checked_end = label == DFA_ERR_STRING_FORMAT ?
+        match_end - 1 : match_end;
+    b32 is_valid_utf8 = label == DFA_ERR_SYMBOL || // NOTE(cya): see below
+        tokenizer_dfa_check_utf8(t, token->offset, checked_end);
+    if (!is_valid_utf8) {
+        return;
+    }
+
+    TokenizerError err = T_ERR_INVALID_SYMBOL;
+    switch (label) {
+    case DFA_ERR_KEYWORD: {
+        err = T_ERR_INVALID_KEYWORD;
+    } break;
+    case DFA_ERR_IDENT: {
+        err = T_ERR_INVALID_IDENT;
+    } break;
+    case DFA_ERR_STRING_FORMAT: {
+        err = T_ERR_INVALID_STRING;
+        token->offset = match_end - 2;
+        token->len = t->start[match_end - 1] == '"' ? 1 : 2;
+    } break;
+    case DFA_ERR_STRING_NEWLINE:
+    case DFA_ERR_STRING_EOF: {
+        err = T_ERR_INVALID_STRING;
+        token->len = 1;
+    } break;
+    case DFA_ERR_COMMENT: {
+        err = T_ERR_INVALID_COMMENT;
+        token->len = 2;
+    } break;
+    default: {
+        // NOTE(cya): the catch-all rule matched one byte of a rune
+        const u8 *s = t->start + token->offset;
+        isize width = utf8_sequence_len(s, t->end);
+        if (width == 0) {
+            err = T_ERR_INVALID_UTF8;
+        } else {
+            token->len = (u32)width;
+        }
+    } break;
+    }
+
+    token->kind = C_TOKEN_INVALID;
+    tokenizer_error(t, token, err, NULL);
+}
+
+/* Takes the longest match from the current position (the catch-all symbol
+ * rule matches any single byte, so there always is one), skipping whitespace */
+static Token tokenizer_dfa_get_token(Tokenizer *t)
+{
+    for (;;) {
+        const u8 *start = t->cur;
+        Token token = {
+            .kind = C_TOKEN_EOF,
+            .offset = (u32)(start - t->start),
+        };
+        if (start >= t->end) {
+            return token;
+        }
+
+        isize state = DFA_START, label = 0;
+        const u8 *s = start, *match_end = start;
+        while (s < t->end) {
+            state = g_dfa_next[state][g_dfa_byte_class[*s]];
+            if (state == DFA_DEAD) {
+                break;
+            }
+
+            s += 1;
+            if (g_dfa_accept[state] != 0) {
+                label = g_dfa_accept[state];
+                match_end = s;
+            }
+        }
+
+        t->cur = match_end;
+        token.len = (u32)(match_end - start);
+        if (label == DFA_WHITESPACE) {
+            continue;
+        } else if (label >= C_TOKEN_COUNT) {
+            tokenizer_dfa_error(t, &token, label);
+        } else {
+            token.kind = label;
+            if (label == C_TOKEN_INTEGER || label == C_TOKEN_FLOAT) {
+                tokenizer_read_number(t, &token);
+            } else if (label == C_TOKEN_STRING || label == C_TOKEN_COMMENT) {
+                u32 end = token.offset + token.len;
+                if (!tokenizer_dfa_check_utf8(t, token.offset, end)) {
+                    token.kind = C_TOKEN_INVALID;
+                }
+            }
+        }
+
+        return token;
+    }
+}
+#endif
+
+static inline Token tokenizer_next_token(Tokenizer *t)
+{
+#if !defined(COMPILER_GEN)
+    if (t->backend == TOKENIZER_BACKEND_DFA) {
+        return tokenizer_dfa_get_token(t);
+    }
+#endif
+
+    return tokenizer_get_token(t);
+}
+
+// NOTE(cya): reads (and drops) tokens until the end of the source or an error
+static inline void tokenizer_skip_to_end(Tokenizer *t)
+{
+    while (t->err == T_ERR_NONE) {
+        if (tokenizer_next_token(t).kind == C_TOKEN_EOF) {
+            break;
+        }
+    }
+}
+
+/* --------------------------- Chunked tokenizer ---------------------------- */
+// NOTE(cya): TokenList (see compiler.h) holds whole token streams
+#define TOKEN_LIST_INIT_CAP 0x1000
+
+static inline Token token_list_get(const TokenList *l, isize i)
+{
+    return (Token){
+        .offset = l->offsets[i],
+        .len = l->lens[i],
+        .kind = l->kinds[i],
+    };
+}
+
+/* Lists only keep where tokens are, so the values of numeric constants are
+ * worked out again (they've already been checked while lexing) */
+static inline TokenValue token_list_value(const u8 *src, Token tok)
+{
+    TokenValue val = {0};
+    String text = token_text(src, tok);
+    if (tok.kind == C_TOKEN_INTEGER) {
+        parse_int(text, &val.i);
+    } else if (tok.kind == C_TOKEN_FLOAT) {
+        parse_float(text, &val);
+    }
+
+    return val;
+}
+
+void token_list_free(CyAllocator a, TokenList *l)
+{
+    cy_free(a, l->kinds);
+    cy_free(a, l->offsets);
+    cy_free(a, l->lens);
+    cy_mem_zero(l, sizeof(*l));
+}
+
+static b32 token_list_reserve(CyAllocator a, TokenList *l, isize cap)
+{
+    if (cap <= l->cap) {
+        return true;
+    }
+
+    u8 *kinds = cy_resize_array(a, l->kinds, u8, l->cap, cap);
+    if (kinds == NULL) {
+        return false;
+    }
+
+    l->kinds = kinds;
+    u32 *offsets = cy_resize_array(a, l->offsets, u32, l->cap, cap);
+    if (offsets == NULL) {
+        return false;
+    }
+
+    l->offsets = offsets;
+    u32 *lens = cy_resize_array(a, l->lens, u32, l->cap, cap);
+    if (lens == NULL) {
+        return false;
+    }
+
+    l->lens = lens;
+    l->cap = cap;
+    return true;
+}
+
+static inline b32 token_list_push(CyAllocator a, TokenList *l, Token tok)
+{
+    if (l->len == l->cap) {
+        isize new_cap = CY_MAX(l->cap * 2, TOKEN_LIST_INIT_CAP);
+        if (!token_list_reserve(a, l, new_cap)) {
+            return false;
+        }
+    }
+
+    l->kinds[l->len] = tok.kind;
+    l->offsets[l->len] = tok.offset;
+    l->lens[l->len] = tok.len;
+    l->len += 1;
+    return true;
+}
+
+// NOTE(cya): appends src's tokens (the caller has reserved room for them)
+static inline void token_list_append(TokenList *dst, const TokenList *src)
+{
+    isize len = src->len;
+    if (len == 0) {
+        return;
+    }
+
+    cy_mem_copy(dst->kinds + dst->len, src->kinds, len);
+    cy_mem_copy(dst->offsets + dst->len, src->offsets, len * sizeof(u32));
+    cy_mem_copy(dst->lens + dst->len, src->lens, len * sizeof(u32));
+    dst->len += len;
+}
+
+/* A copy of setup that starts lexing at offset. There's no state carried
+ * from one token to the next, so it gives the same tokens a tokenizer that
+ * got there on its own would (but, unlike tokenizer_init, skips no BOM) */
+static inline Tokenizer tokenizer_at(const Tokenizer *setup, isize offset)
+{
+    Tokenizer t = *setup;
+    t.cur = t.next = t.start + offset;
+    t.err = T_ERR_NONE;
+    tokenizer_advance_to_next_rune(&t);
+    if (offset == 0 && t.cur_rune == CY_RUNE_BOM) {
+        tokenizer_advance_to_next_rune(&t); // NOTE(cya): as tokenizer_init
+    }
+
+    return t;
+}
+
+/* A run of whole lines, lexed on its own. It's first lexed speculatively
+ * from its first line, as if no token from the chunk before spilled into it
+ * (only block comments can), and lexed again from where that token ended if
+ * one did */
+typedef struct {
+    isize begin;
+    isize stop;   // NOTE(cya): tokens starting from here on are the next's
+    isize resume; // NOTE(cya): where the last token kept ends
+    TokenList tokens;
+    Tokenizer t;  // NOTE(cya): holds the error lexing stopped at (if any)
+} TokenChunk;
+
+static void token_chunk_lex(
+    CyAllocator a, TokenChunk *c, const Tokenizer *setup, isize from
+) {
+    c->tokens.len = 0;
+    c->resume = from;
+    c->t = tokenizer_at(setup, from);
+
+    Tokenizer *t = &c->t;
+    for (;;) {
+        const u8 *tok_from = t->cur;
+        Token tok = tokenizer_next_token(t);
+        if (t->err != T_ERR_NONE) {
+            // NOTE(cya): an error past the stop is for the next chunk to find,
+            // unless the token it's in started before it (bad tokens never
+            // span lines, but a comment with bad UTF-8 in it can)
+            const u8 *tok_start = tok_from, *stop = t->start + c->stop;
+            while (tok_start < stop && is_whitespace(*tok_start)) {
+                tok_start += 1;
+            }
+
+            if (t->bad_tok.offset >= c->stop && tok_start >= stop) {
+                t->err = T_ERR_NONE;
+            }
+
+            break;
+        } else if (tok.offset >= c->stop) {
+            break;
+        } else if (!token_list_push(a, &c->tokens, tok)) {
+            tokenizer_error(t, NULL, T_ERR_OUT_OF_MEMORY, NULL);
+            break;
+        }
+
+        c->resume = t->cur - t->start;
+        if (tok.kind == C_TOKEN_EOF) {
+            break;
+        }
+    }
+}
+
+#define TOKENIZE_CHUNK_MIN_LEN (1024 * 1024)
+#define TOKENIZE_MAX_THREADS 64
+
+#if !defined(CY_OS_WINDOWS)
+#include <pthread.h>
+
+typedef struct {
+    TokenChunk *chunk;
+    const Tokenizer *setup;
+    pthread_t thread;
+    b32 started;
+} TokenizeWorker;
+
+static void *tokenize_worker_run(void *data)
+{
+    TokenizeWorker *w = data;
+    token_chunk_lex(cy_heap_allocator(), w->chunk, w->setup, w->chunk->begin);
+    return NULL;
+}
+
+/* Splits the source at line starts into one chunk per thread (of at least
+ * TOKENIZE_CHUNK_MIN_LEN bytes), lexes the chunks in parallel, then checks
+ * them in order, lexing again the ones that started inside a comment, and
+ * stitches their tokens (comments included) into out. out ends up with what
+ * tokenizer_next_token would return up to EOF (or the first lexical error),
+ * and t where it'd be after that. Returns the number of chunks, or 0 (with t
+ * untouched) if the source is too small to split */
+static isize tokenize_parallel(
+    CyAllocator a, Tokenizer *t, isize thread_count, TokenList *out
+) {
+    isize begin = t->cur - t->start, len = t->end - t->start;
+    isize count = CY_MIN(thread_count, (len - begin) / TOKENIZE_CHUNK_MIN_LEN);
+    count = CY_MIN(count, TOKENIZE_MAX_THREADS);
+    if (count < 2) {
+        return 0;
+    }
+
+    TokenChunk chunks[TOKENIZE_MAX_THREADS] = {0};
+    TokenizeWorker workers[TOKENIZE_MAX_THREADS] = {0};
+    isize chunk_len = (len - begin) / count;
+    for (isize i = 0; i < count; i++) {
+        TokenChunk *c = &chunks[i];
+        c->begin = i == 0 ? begin : chunks[i - 1].stop;
+        c->stop = len + 1; // NOTE(cya): so the last chunk keeps EOF
+        if (i < count - 1) {
+            isize target = CY_MAX(c->begin, begin + chunk_len * (i + 1));
+            const u8 *lf = t->scan->line(t->start + target, t->end);
+            c->stop = lf == t->end ? len : lf + 1 - t->start;
+        }
+    }
+
+    // NOTE(cya): the first chunk is lexed on this thread
+    for (isize i = 1; i < count; i++) {
+        TokenizeWorker *w = &workers[i];
+        *w = (TokenizeWorker){ .chunk = &chunks[i], .setup = t };
+        w->started = pthread_create(
+            &w->thread, NULL, tokenize_worker_run, w
+        ) == 0;
+    }
+
+    CyAllocator heap = cy_heap_allocator();
+    token_chunk_lex(heap, &chunks[0], t, begin);
+    for (isize i = 1; i < count; i++) {
+        TokenizeWorker *w = &workers[i];
+        if (w->started) {
+            pthread_join(w->thread, NULL);
+        } else {
+            tokenize_worker_run(w);
+        }
+    }
+
+    isize last = 0, token_count = 0;
+    for (; last < count; last++) {
+        TokenChunk *c = &chunks[last];
+        if (last > 0 && chunks[last - 1].resume > c->begin) {
+            token_chunk_lex(heap, c, t, chunks[last - 1].resume);
+        }
+
+        token_count += c->tokens.len;
+        if (c->t.err != T_ERR_NONE) {
+            break;
+        }
+    }
+
+    TokenizerError err = T_ERR_NONE;
+    if (!token_list_reserve(a, out, token_count)) {
+        err = T_ERR_OUT_OF_MEMORY;
+    }
+
+    for (isize i = 0; i < count; i++) {
+        TokenChunk *c = &chunks[i];
+        if (err == T_ERR_NONE && i <= last) {
+            token_list_append(out, &c->tokens);
+            if (c->t.err != T_ERR_NONE) {
+                err = c->t.err;
+                *t = c->t;
+            }
+        }
+
+        token_list_free(heap, &c->tokens);
+    }
+
+    if (err == T_ERR_NONE) {
+        t->cur = t->next = t->end;
+        t->cur_rune = CY_RUNE_EOF;
+    } else if (err == T_ERR_OUT_OF_MEMORY) {
+        tokenizer_error(t, NULL, T_ERR_OUT_OF_MEMORY, NULL);
+    }
+
+    return count;
+}
+#else
+// NOTE(cya): no threads to spread the chunks over
+static inline isize tokenize_parallel(
+    CyAllocator a, Tokenizer *t, isize thread_count, TokenList *out
+) {
+    CY_UNUSED(a), CY_UNUSED(t), CY_UNUSED(thread_count), CY_UNUSED(out);
+    return 0;
+}
+#endif
+
+/* -------------------------- Incremental tokenizer ------------------------- */
+CyString source_apply_edit(CyString src, SourceEdit edit)
+{
+    isize len = cy_string_len(src), delta = edit.text.len - edit.len;
+    CY_ASSERT(edit.offset >= 0 && edit.len >= 0);
+    CY_ASSERT(edit.offset + edit.len <= len);
+    if (delta > 0) {
+        src = cy_string_reserve_space_for(src, delta);
+        if (src == NULL) {
+            return NULL;
+        }
+    }
+
+    isize tail = edit.offset + edit.len;
+    cy_mem_move(src + tail + delta, src + tail, len - tail);
+    if (edit.text.len > 0) {
+        // NOTE(cya): deletions may come with no text at all (NULL)
+        cy_mem_copy(src + edit.offset, edit.text.text, edit.text.len);
+    }
+
+    cy__string_set_len(src, len + delta);
+    src[len + delta] = '\0';
+    return src;
+}
+
+// NOTE(cya): moves count tokens from index src to index dst
+static inline void token_list_move(
+    TokenList *l, isize dst, isize src, isize count
+) {
+    if (count == 0 || dst == src) {
+        return;
+    }
+
+    cy_mem_move(l->kinds + dst, l->kinds + src, count);
+    cy_mem_move(l->offsets + dst, l->offsets + src, count * sizeof(u32));
+    cy_mem_move(l->lens + dst, l->lens + src, count * sizeof(u32));
+}
+
+/* Brings l, the tokens of a source (as tokenize_parallel leaves them), up to
+ * date with the source t was set up on: the same one, with edit applied. Only
+ * the tokens from the one the edit starts in are lexed again, until a token
+ * starts where one did before the edit (from there on, the old tokens are
+ * kept, shifted). t ends up as if it had lexed the new source on its own, and
+ * the number of tokens lexed is returned */
+static isize tokenizer_edit(
+    CyAllocator a, Tokenizer *t, TokenList *l, SourceEdit edit
+) {
+    isize delta = edit.text.len - edit.len, len = t->end - t->start;
+    CY_ASSERT(edit.offset >= 0 && edit.len >= 0);
+    CY_ASSERT(edit.offset + edit.text.len <= len);
+
+    // NOTE(cya): a token can look past its end (a float's trailing zeros, or
+    // the rest of a word), but never past whitespace, so lexing starts after
+    // the last token that ends before some whitespace ahead of the edit
+    isize ws = edit.offset - 1;
+    while (ws >= 0 && !is_whitespace(t->start[ws])) {
+        ws -= 1;
+    }
+
+    isize lo = 0, hi = l->len;
+    while (lo < hi) {
+        isize mid = lo + (hi - lo) / 2;
+        if (l->offsets[mid] + l->lens[mid] <= ws) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    isize first = lo;
+    Tokenizer lex = *t;
+    if (first > 0) {
+        lex = tokenizer_at(t, l->offsets[first - 1] + l->lens[first - 1]);
+    }
+
+    isize tail = edit.offset + edit.text.len, old = first;
+    b32 synced = false;
+    TokenList fresh = {0};
+    for (;;) {
+        Token tok = tokenizer_next_token(&lex);
+        if (lex.err != T_ERR_NONE) {
+            break;
+        } else if (tok.offset >= tail) {
+            isize old_offset = tok.offset - delta;
+            while (old < l->len && l->offsets[old] < old_offset) {
+                old += 1;
+            }
+
+            synced = old < l->len && l->offsets[old] == old_offset;
+            if (synced) {
+                break;
+            }
+        }
+
+        if (!token_list_push(a, &fresh, tok)) {
+            tokenizer_error(&lex, NULL, T_ERR_OUT_OF_MEMORY, NULL);
+            break;
+        } else if (tok.kind == C_TOKEN_EOF) {
+            break;
+        }
+    }
+
+    isize kept = synced ? l->len - old : 0;
+    isize new_len = first + fresh.len + kept;
+    if (lex.err != T_ERR_OUT_OF_MEMORY && !token_list_reserve(a, l, new_len)) {
+        tokenizer_error(&lex, NULL, T_ERR_OUT_OF_MEMORY, NULL);
+    }
+
+    if (lex.err == T_ERR_OUT_OF_MEMORY) {
+        // NOTE(cya): the old tokens are of no use without the new ones
+        l->len = 0;
+        *t = lex;
+        token_list_free(a, &fresh);
+        return 0;
+    }
+
+    isize relexed = fresh.len;
+    token_list_move(l, first + fresh.len, old, kept);
+    for (isize i = first + fresh.len; i < new_len; i++) {
+        l->offsets[i] += delta;
+    }
+
+    l->len = first;
+    token_list_append(l, &fresh);
+    l->len = new_len;
+    token_list_free(a, &fresh);
+
+    *t = lex;
+    if (synced) {
+        // NOTE(cya): the kept tokens stop short of EOF only at a lexical
+        // error, which lexing after the last of them finds again
+        isize last = new_len - 1;
+        if (l->kinds[last] == C_TOKEN_EOF) {
+            *t = tokenizer_at(t, len);
+        } else {
+            *t = tokenizer_at(t, l->offsets[last] + l->lens[last]);
+            tokenizer_next_token(t);
+        }
+    }
+
+    return relexed;
+}
+
+String token_kind_name(u8 kind)
+{
+    CY_ASSERT(kind < C_TOKEN_COUNT);
+    return g_token_strings[kind];
+}
+
+b32 tokenize_source(CyAllocator a, String src, TokenList *out)
+{
+    Tokenizer t = tokenizer_init(src);
+    out->len = 0;
+    for (;;) {
+        Token tok = tokenizer_next_token(&t);
+        if (t.err != T_ERR_NONE) {
+            break;
+        } else if (!token_list_push(a, out, tok)) {
+            token_list_free(a, out);
+            return false;
+        }
+
+        if (tok.kind == C_TOKEN_EOF) {
+            break;
+        }
+    }
+
+    return true;
+}
+
+isize tokenize_edit(
+    CyAllocator a, String src, TokenList *tokens, SourceEdit edit
+) {
+    Tokenizer t = tokenizer_init(src);
+    isize relexed = tokenizer_edit(a, &t, tokens, edit);
+    return t.err == T_ERR_OUT_OF_MEMORY ? -1 : relexed;
+}
+
+/* ---------------------------- Lexical recovery ---------------------------- */
+/* A lexical error, as tokenize_recovering records it (its position is
+ * bad_tok's, found through the line index when it's reported) */
+typedef struct {
+    TokenizerError err;
+    const u8 *err_desc;
+    Token bad_tok;
+} LexDiagnostic;
+
+typedef struct {
+    LexDiagnostic *items;
+    isize len;
+    isize cap;
+} LexDiagnostics;
+
+#define LEX_DIAGNOSTICS_INIT_CAP 0x10
+
+static inline LexDiagnostic lex_diagnostic_from_tokenizer(const Tokenizer *t)
+{
+    return (LexDiagnostic){
+        .err = t->err,
+        .err_desc = t->err_desc,
+        .bad_tok = t->bad_tok,
+    };
+}
+
+static inline void lex_diagnostics_free(CyAllocator a, LexDiagnostics *d)
+{
+    cy_free(a, d->items);
+    cy_mem_zero(d, sizeof(*d));
+}
+
+static inline b32 lex_diagnostics_push(
+    CyAllocator a, LexDiagnostics *d, LexDiagnostic diag
+) {
+    if (d->len == d->cap) {
+        isize new_cap = CY_MAX(d->cap * 2, LEX_DIAGNOSTICS_INIT_CAP);
+        LexDiagnostic *items = cy_resize_array(
+            a, d->items, LexDiagnostic, d->cap, new_cap
+        );
+        if (items == NULL) {
+            return false;
+        }
+
+        d->items = items;
+        d->cap = new_cap;
+    }
+
+    d->items[d->len] = diag;
+    d->len += 1;
+    return true;
+}
+
+// NOTE(cya): the bytes tokens other than words and numbers start with
+static inline b32 is_symbol_start(u8 c)
+{
+    switch (c) {
+    case ';': case ',': case '(': case ')': case '<': case '>':
+    case '+': case '-': case '*': case '/': case '=': case '!':
+    case '&': case '|': case '"': {
+        return true;
+    } break;
+    default: {
+        return false;
+    } break;
+    }
+}
+
+/* Where lexing picks up again after an error in the token at offset start.
+ * Strings and comments are skipped whole (up to their closing quote or line
+ * break, and up to @<), since lexing their text as code would only bring up
+ * errors that aren't there. Anything else is skipped up to the first
+ * whitespace or symbol after the bad token */
+static isize tokenizer_recovery_point(const Tokenizer *t, isize start)
+{
+    const u8 *s = t->start + start, *end = t->end;
+    if (*s == '"') {
+        s += 1;
+        while (s < end && *s != '"' && *s != '\n') {
+            s += 1;
+        }
+
+        return (s < end && *s == '"' ? s + 1 : s) - t->start;
+    } else if (*s == '>' && end - s >= 2 && s[1] == '@') {
+        for (s += 2; end - s >= 2; s++) {
+            if (s[0] == '@' && s[1] == '<') {
+                return s + 2 - t->start;
+            }
+        }
+
+        return end - t->start;
+    }
+
+    isize bad_end = (isize)t->bad_tok.offset + t->bad_tok.len;
+    s = t->start + CY_MAX(bad_end, start + 1);
+    while (s < end && !is_whitespace(*s) && !is_symbol_start(*s)) {
+        s += 1;
+    }
+
+    return s - t->start;
+}
+
+/* Lexes the rest of t's source without stopping at lexical errors: each one is
+ * recorded into diags, and the text from the start of the token it's in to
+ * the recovery point comes out as a single C_TOKEN_INVALID token. out (if not
+ * NULL) gets every token up to EOF, so with no errors it ends up just like
+ * tokenize_parallel's. Returns false (with t->err set) if out of memory */
+static b32 tokenize_recovering(
+    CyAllocator a, Tokenizer *t, TokenList *out, LexDiagnostics *diags
+) {
+    for (;;) {
+        isize from = t->cur - t->start;
+        Token tok = tokenizer_next_token(t);
+        if (t->err != T_ERR_NONE) {
+            LexDiagnostic diag = lex_diagnostic_from_tokenizer(t);
+            if (!lex_diagnostics_push(a, diags, diag)) {
+                break;
+            }
+
+            // NOTE(cya): the bad token may be inside the one that failed
+            isize start = from, len = t->end - t->start;
+            while (start < len && is_whitespace(t->start[start])) {
+                start += 1;
+            }
+
+            isize resume = tokenizer_recovery_point(t, start);
+            tok = (Token){
+                .kind = C_TOKEN_INVALID,
+                .offset = (u32)start,
+                .len = (u32)(resume - start),
+            };
+            *t = tokenizer_at(t, resume);
+        }
+
+        if (out != NULL && !token_list_push(a, out, tok)) {
+            break;
+        } else if (tok.kind == C_TOKEN_EOF) {
+            return true;
+        }
+    }
+
+    tokenizer_error(t, NULL, T_ERR_OUT_OF_MEMORY, NULL);
+    return false;
+}
+
+static inline CyString append_error_prefix(
+    CyString str, LineIndex *lines, Token bad_tok
+) {
+    TokenPos err_pos = line_index_pos(lines, bad_tok.offset);
+    return cy_string_append_fmt(str, "Erro na linha %d – ", err_pos.line);
+}
+
+static CyString lex_diagnostic_append_msg(
+    CyString msg, LineIndex *lines, const u8 *src, const LexDiagnostic *d
+) {
+    if (d->err == T_ERR_OUT_OF_MEMORY) {
+        return msg; // NOTE(cya): since we're out of memory
+    }
+
+    msg = append_error_prefix(msg, lines, d->bad_tok);
+
+    TokenizerError err = d->err;
+    b32 shows_text = err != T_ERR_INVALID_STRING &&
+        err != T_ERR_INVALID_COMMENT && err != T_ERR_INVALID_UTF8;
+    if (shows_text) {
+        String bad_str = token_text(src, d->bad_tok);
+        msg = cy_string_append_fmt(msg, "%.*s ", STRING_ARG(bad_str));
+    }
+
+    const char *desc = NULL;
+    switch (err) {
+    case T_ERR_INVALID_SYMBOL: {
+        desc = "símbolo inválido";
+    } break;
+    case T_ERR_INVALID_KEYWORD: {
+        desc = "palavra reservada inválida";
+    } break;
+    case T_ERR_INVALID_IDENT: {
+        desc = "identificador inválido";
+    } break;
+    case T_ERR_INVALID_STRING: {
+        desc = "constante_string inválida";
+    } break;
+    case T_ERR_INVALID_COMMENT: {
+        desc = "comentário de bloco inválido ou não finalizado";
+    } break;
+    case T_ERR_INT_OUT_OF_RANGE: {
+        desc = "constante_int muito grande";
+    } break;
+    case T_ERR_FLOAT_OUT_OF_RANGE: {
+        desc = "constante_float muito grande";
+    } break;
+    case T_ERR_INVALID_UTF8: {
+        // NOTE(cya): the byte can't be shown, so say where it is instead
+        TokenPos pos = line_index_pos(lines, d->bad_tok.offset);
+        u8 byte = src[d->bad_tok.offset];
+        return cy_string_append_fmt(
+            msg, "byte 0x%02X inválido em UTF-8 (coluna %d)", byte, pos.col
+        );
+    } break;
+    default: {
+        desc = "(fatal) erro não reconhecido ao tokenizar código";
+    } break;
+    }
+
+    msg = cy_string_append_c(msg, desc);
+
+#if 0
+    if (d->err_desc != NULL) {
+        msg = cy_string_append_fmt(msg, " (%s)", d->err_desc);
+    }
+#endif
+
+    return msg;
+}
+
+static inline CyString tokenizer_append_error_msg(
+    CyString msg, LineIndex *lines, const Tokenizer *t
+) {
+    LexDiagnostic d = lex_diagnostic_from_tokenizer(t);
+    return lex_diagnostic_append_msg(msg, lines, t->start, &d);
+}
+
+// NOTE(cya): one line per error, in the order they're in the source
+static CyString lex_diagnostics_append_msg(
+    CyString msg, LineIndex *lines, const u8 *src, const LexDiagnostics *d
+) {
+    for (isize i = 0; i < d->len; i++) {
+        if (i > 0) {
+            msg = cy_string_append_c(msg, "\n");
+        }
+
+        msg = lex_diagnostic_append_msg(msg, lines, src, &d->items[i]);
+    }
+
+    return msg;
+}
+
+/* ----------------------------- Parser ------------------------------------- */
+#define NON_TERMINALS \
+    NON_TERMINAL(NT_START, "<inicio>"), \
+\
+NON_TERMINAL(NT__INSTRUCTION_BEGIN, ""), \
+    NON_TERMINAL(NT_INSTR_LIST, "<lista_instr>"), \
+    NON_TERMINAL(NT_INSTR_LIST_R, "<lista_instr_rep>"), \
+    NON_TERMINAL(NT_INSTRUCTION, "<instrucao>"), \
+    NON_TERMINAL(NT_DEC_OR_ASSIGN, "<dec_ou_atr>"), \
+    NON_TERMINAL(NT_ASSIGN_OPT, "<atr_opt>"), \
+    NON_TERMINAL(NT_ID_LIST, "<lista_id>"), \
+    NON_TERMINAL(NT_ID_LIST_R, "<lista_id_mul>"), \
+NON_TERMINAL(NT__INSTRUCTION_END, ""), \
+\
+NON_TERMINAL(NT__COMMAND_BEGIN, ""), \
+    NON_TERMINAL(NT_CMD, "<cmd>"), \
+    NON_TERMINAL(NT_CMD_ASSIGN, "<cmd_atr>"), \
+    NON_TERMINAL(NT_CMD_INPUT, "<cmd_entr>"), \
+    NON_TERMINAL(NT_INPUT_LIST, "<lista_entr>"), \
+    NON_TERMINAL(NT_INPUT_LIST_R, "<lista_entr_mul>"), \
+    NON_TERMINAL(NT_STRING_OPT, "<cte_str_opt>"), \
+    NON_TERMINAL(NT_CMD_OUTPUT, "<cmd_saida>"), \
+    NON_TERMINAL(NT_CMD_OUTPUT_KEYWORD, "<cmd_saida_tipo>"), \
+    NON_TERMINAL(NT_CMD_COND, "<cmd_sel>"), \
+    NON_TERMINAL(NT_ELIF, "<elif>"), \
+    NON_TERMINAL(NT_ELSE, "<else>"), \
+    NON_TERMINAL(NT_CMD_LIST, "<lista_cmd>"), \
+    NON_TERMINAL(NT_CMD_LIST_R, "<lista_cmd_mul>"), \
+    NON_TERMINAL(NT_CMD_LOOP, "<cmd_rep>"), \
+    NON_TERMINAL(NT_CMD_LOOP_KEYWORD, "<cmd_rep_tipo>"), \
+NON_TERMINAL(NT__COMMAND_END, ""), \
+\
+NON_TERMINAL(NT__EXPRESSION_BEGIN, ""), \
+    NON_TERMINAL(NT_EXPR_LIST, "<lista_expr>"), \
+    NON_TERMINAL(NT_EXPR_LIST_R, "<lista_expr_mul>"), \
+    NON_TERMINAL(NT_EXPR, "<expr>"), \
+    NON_TERMINAL(NT_EXPR_LOG, "<expr_log>"), \
+    NON_TERMINAL(NT_ELEMENT, "<elemento>"), \
+    NON_TERMINAL(NT_RELATIONAL, "<relacional>"), \
+    NON_TERMINAL(NT_RELATIONAL_R, "<relacional_mul>"), \
+    NON_TERMINAL(NT_RELATIONAL_OP, "<operador_relacional>"), \
+    NON_TERMINAL(NT_ARITHMETIC, "<aritmetica>"), \
+    NON_TERMINAL(NT_ARITHMETIC_R, "<aritmetica_mul>"), \
+    NON_TERMINAL(NT_TERM, "<termo>"), \
+    NON_TERMINAL(NT_TERM_R, "<termo_mul>"), \
+    NON_TERMINAL(NT_FACTOR, "<fator>"), \
+NON_TERMINAL(NT__EXPRESSION_END, ""), \
+    NON_TERMINAL(NT_COUNT, ""),
+
+#define NT_IS_OF_CLASS(n, c) (n > NT__##c##_BEGIN && n < NT__##c##_END)
+
+typedef enum {
+#define NON_TERMINAL(e, s) e
+    NON_TERMINALS
+#undef NON_TERMINAL
+} NonTerminal;
+
+const String g_non_terminal_strings[] = {
+#define NON_TERMINAL(e, s) {(const u8*)s, CY_STATIC_STR_LEN(s)}
+    NON_TERMINALS
+#undef NON_TERMINAL
+};
+
+static inline CyString reachable_terminals(CyAllocator a, NonTerminal n);
+
+static inline CyString non_terminal_description(CyAllocator a, NonTerminal n)
+{
+    return (NT_IS_OF_CLASS(n, EXPRESSION)) ?
+        cy_string_create(a, "expressão") : reachable_terminals(a, n);
+}
+
+/* The grammar (as in README.md). compiler_gen.c reads it to build the LL(1)
+ * table in compiler_ll1.h, and parse() has a case for each rule */
+#define GRAMMAR_RULES \
+    GRAMMAR_RULE(GR_0, NT_START, "main <lista_instr> end"), \
+    GRAMMAR_RULE(GR_1, NT_INSTR_LIST, "<instrucao> \";\" <lista_instr_rep>"), \
+    GRAMMAR_RULE(GR_2, NT_INSTR_LIST_R, "<lista_instr>"), \
+    GRAMMAR_RULE(GR_3, NT_INSTR_LIST_R, "î"), \
+    GRAMMAR_RULE(GR_4, NT_INSTRUCTION, "<dec_ou_atr>"), \
+    GRAMMAR_RULE(GR_5, NT_INSTRUCTION, "<cmd_entr>"), \
+    GRAMMAR_RULE(GR_6, NT_INSTRUCTION, "<cmd_saida>"), \
+    GRAMMAR_RULE(GR_7, NT_INSTRUCTION, "<cmd_rep>"), \
+    GRAMMAR_RULE(GR_8, NT_INSTRUCTION, "<cmd_sel>"), \
+    GRAMMAR_RULE(GR_9, NT_DEC_OR_ASSIGN, "<lista_id> <atr_opt>"), \
+    GRAMMAR_RULE(GR_10, NT_ASSIGN_OPT, "\"=\" <expr>"), \
+    GRAMMAR_RULE(GR_11, NT_ASSIGN_OPT, "î"), \
+    GRAMMAR_RULE(GR_12, NT_ID_LIST, "identificador <lista_id_mul>"), \
+    GRAMMAR_RULE(GR_13, NT_ID_LIST_R, "\",\" <lista_id>"), \
+    GRAMMAR_RULE(GR_14, NT_ID_LIST_R, "î"), \
+    GRAMMAR_RULE(GR_15, NT_CMD, "<cmd_atr>"), \
+    GRAMMAR_RULE(GR_16, NT_CMD, "<cmd_entr>"), \
+    GRAMMAR_RULE(GR_17, NT_CMD, "<cmd_saida>"), \
+    GRAMMAR_RULE(GR_18, NT_CMD, "<cmd_rep>"), \
+    GRAMMAR_RULE(GR_19, NT_CMD, "<cmd_sel>"), \
+    GRAMMAR_RULE(GR_20, NT_CMD_ASSIGN, "<lista_id> \"=\" <expr>"), \
+    GRAMMAR_RULE(GR_21, NT_CMD_INPUT, "read \"(\" <lista_entr> \")\""), \
+    GRAMMAR_RULE(GR_22, NT_INPUT_LIST, \
+        "<cte_str_opt> identificador <lista_entr_mul>"), \
+    GRAMMAR_RULE(GR_23, NT_INPUT_LIST_R, "\",\" <lista_entr>"), \
+    GRAMMAR_RULE(GR_24, NT_INPUT_LIST_R, "î"), \
+    GRAMMAR_RULE(GR_25, NT_STRING_OPT, "constante_string \",\""), \
+    GRAMMAR_RULE(GR_26, NT_STRING_OPT, "î"), \
+    GRAMMAR_RULE(GR_27, NT_CMD_OUTPUT, \
+        "<cmd_saida_tipo> \"(\" <lista_expr> \")\""), \
+    GRAMMAR_RULE(GR_28, NT_CMD_OUTPUT_KEYWORD, "write"), \
+    GRAMMAR_RULE(GR_29, NT_CMD_OUTPUT_KEYWORD, "writeln"), \
+    GRAMMAR_RULE(GR_30, NT_EXPR_LIST, "<expr> <lista_expr_mul>"), \
+    GRAMMAR_RULE(GR_31, NT_EXPR_LIST_R, "\",\" <lista_expr>"), \
+    GRAMMAR_RULE(GR_32, NT_EXPR_LIST_R, "î"), \
+    GRAMMAR_RULE(GR_33, NT_CMD_COND, \
+        "if <expr> <lista_cmd> <elif> <else> end"), \
+    GRAMMAR_RULE(GR_34, NT_ELIF, "elif <expr> <lista_cmd> <elif>"), \
+    GRAMMAR_RULE(GR_35, NT_ELIF, "î"), \
+    GRAMMAR_RULE(GR_36, NT_ELSE, "else <lista_cmd>"), \
+    GRAMMAR_RULE(GR_37, NT_ELSE, "î"), \
+    GRAMMAR_RULE(GR_38, NT_CMD_LIST, "<cmd> \";\" <lista_cmd_mul>"), \
+    GRAMMAR_RULE(GR_39, NT_CMD_LIST_R, "<lista_cmd>"), \
+    GRAMMAR_RULE(GR_40, NT_CMD_LIST_R, "î"), \
+    GRAMMAR_RULE(GR_41, NT_CMD_LOOP, \
+        "repeat <lista_cmd> <cmd_rep_tipo> <expr>"), \
+    GRAMMAR_RULE(GR_42, NT_CMD_LOOP_KEYWORD, "while"), \
+    GRAMMAR_RULE(GR_43, NT_CMD_LOOP_KEYWORD, "until"), \
+    GRAMMAR_RULE(GR_44, NT_EXPR, "<elemento> <expr_log>"), \
+    GRAMMAR_RULE(GR_45, NT_EXPR_LOG, "\"&&\" <elemento> <expr_log>"), \
+    GRAMMAR_RULE(GR_46, NT_EXPR_LOG, "\"||\" <elemento> <expr_log>"), \
+    GRAMMAR_RULE(GR_47, NT_EXPR_LOG, "î"), \
+    GRAMMAR_RULE(GR_48, NT_ELEMENT, "<relacional>"), \
+    GRAMMAR_RULE(GR_49, NT_ELEMENT, "true"), \
+    GRAMMAR_RULE(GR_50, NT_ELEMENT, "false"), \
+    GRAMMAR_RULE(GR_51, NT_ELEMENT, "\"!\" <elemento>"), \
+    GRAMMAR_RULE(GR_52, NT_RELATIONAL, "<aritmetica> <relacional_mul>"), \
+    GRAMMAR_RULE(GR_53, NT_RELATIONAL_R, \
+        "<operador_relacional> <aritmetica>"), \
+    GRAMMAR_RULE(GR_54, NT_RELATIONAL_R, "î"), \
+    GRAMMAR_RULE(GR_55, NT_RELATIONAL_OP, "\"==\""), \
+    GRAMMAR_RULE(GR_56, NT_RELATIONAL_OP, "\"!=\""), \
+    GRAMMAR_RULE(GR_57, NT_RELATIONAL_OP, "\"<\""), \
+    GRAMMAR_RULE(GR_58, NT_RELATIONAL_OP, "\">\""), \
+    GRAMMAR_RULE(GR_59, NT_ARITHMETIC, "<termo> <aritmetica_mul>"), \
+    GRAMMAR_RULE(GR_60, NT_ARITHMETIC_R, "\"+\" <termo> <aritmetica_mul>"), \
+    GRAMMAR_RULE(GR_61, NT_ARITHMETIC_R, "\"-\" <termo> <aritmetica_mul>"), \
+    GRAMMAR_RULE(GR_62, NT_ARITHMETIC_R, "î"), \
+    GRAMMAR_RULE(GR_63, NT_TERM, "<fator> <termo_mul>"), \
+    GRAMMAR_RULE(GR_64, NT_TERM_R, "\"*\" <fator> <termo_mul>"), \
+    GRAMMAR_RULE(GR_65, NT_TERM_R, "\"/\" <fator> <termo_mul>"), \
+    GRAMMAR_RULE(GR_66, NT_TERM_R, "î"), \
+    GRAMMAR_RULE(GR_67, NT_FACTOR, "identificador"), \
+    GRAMMAR_RULE(GR_68, NT_FACTOR, "constante_int"), \
+    GRAMMAR_RULE(GR_69, NT_FACTOR, "constante_float"), \
+    GRAMMAR_RULE(GR_70, NT_FACTOR, "constante_string"), \
+    GRAMMAR_RULE(GR_71, NT_FACTOR, "\"(\" <expr> \")\""), \
+    GRAMMAR_RULE(GR_72, NT_FACTOR, "\"+\" <fator>"), \
+    GRAMMAR_RULE(GR_73, NT_FACTOR, "\"-\" <fator>"), \
+
+typedef enum {
+    GR_NONE,
+#define GRAMMAR_RULE(e, n, s) e
+    GRAMMAR_RULES
+#undef GRAMMAR_RULE
+    GR_COUNT,
+} GrammarRule;
+
+CY_STATIC_ASSERT(GR_COUNT <= U8_MAX);
+
+#define RULE_IS_INVALID(r) (r <= GR_NONE || r >= GR_COUNT)
+
+// NOTE(cya): see g_ll1_derives_empty
+CY_STATIC_ASSERT(NT_COUNT <= 64);
+
+#if defined(COMPILER_GEN)
+// NOTE(cya): the generator can't use the tables it's generating (and it
+// never parses anything)
+#define LL1_ROW_COUNT 1
+#define LL1_COL_COUNT 1
+
+static const u8 g_ll1_row_from_kind[NT_COUNT] = {0};
+static const u8 g_ll1_col_from_kind[C_TOKEN_COUNT] = {0};
+static const u8 g_ll1_table[LL1_ROW_COUNT][LL1_COL_COUNT] = {{0}};
+static const char *const g_ll1_expected[LL1_ROW_COUNT] = {""};
+
+#define LL1_RHS_MAX_LEN 1
+
+static const u8 g_ll1_rhs_len[GR_COUNT] = {0};
+static const u16 g_ll1_rhs[GR_COUNT][LL1_RHS_MAX_LEN] = {{0}};
+
+#define LL1_CLOSURE_MAX_LEN 1
+
+static const u16 g_ll1_closure[LL1_ROW_COUNT][LL1_COL_COUNT] = {{0}};
+static const u16 g_ll1_closure_syms[1 + LL1_CLOSURE_MAX_LEN] = {0};
+static const u64 g_ll1_derives_empty[LL1_COL_COUNT] = {0};
+#else
+#include "compiler_ll1.h"
+
+CY_STATIC_ASSERT(LL1_GEN_RULE_COUNT == GR_COUNT - 1);
+CY_STATIC_ASSERT(LL1_GEN_NT_COUNT == NT_COUNT);
+CY_STATIC_ASSERT(LL1_GEN_TOKEN_COUNT == C_TOKEN_COUNT);
+#endif
+
+typedef struct {
+    f64 val;
+    isize precision;
+} AstFloat;
+
+typedef enum {
+    AST_ENT_INT,
+    AST_ENT_FLOAT,
+    AST_ENT_STRING,
+    AST_ENT_BOOL,
+} AstEntityKind;
+
+typedef struct {
+    AstEntityKind kind;
+    union {
+        isize i;
+        AstFloat f;
+        String s;
+        b32 b;
+    } u;
+} AstLiteral;
+
+#define AST_KINDS \
+    AST_KIND(IDENT, struct { \
+        Token tok; \
+        AstEntityKind kind; \
+    }) \
+    AST_KIND(LITERAL, struct { \
+        Token tok; \
+        AstLiteral val; \
+    }) \
+    AST_KIND(MAIN, struct { \
+        AstNode *body; \
+    }) \
+\
+AST_KIND(_LIST_BEGIN, isize) \
+    AST_KIND(IDENT_LIST, struct { \
+        AstList list; \
+    }) \
+    AST_KIND(INPUT_LIST, struct { \
+        AstList list; \
+    }) \
+    AST_KIND(EXPR_LIST, struct { \
+        AstList list; \
+    }) \
+    AST_KIND(STMT_LIST, struct { \
+        AstList list; \
+    }) \
+    AST_KIND(INPUT_ARG, struct { \
+        AstNode *prompt; \
+        AstNode *ident; \
+    }) \
+    AST_KIND(INPUT_PROMPT, struct { \
+        Token string; \
+    }) \
+    AST_KIND(VAR_DECL, struct { \
+        AstNode *ident_list; \
+    }) \
+AST_KIND(_LIST_END, isize) \
+\
+AST_KIND(_STMT_BEGIN, isize) \
+    AST_KIND(ASSIGN_STMT, struct { \
+        AstNode *ident_list; \
+        AstNode *expr; \
+    }) \
+    AST_KIND(READ_STMT, struct { \
+        AstNode *input_list; \
+    }) \
+    AST_KIND(WRITE_STMT, struct { \
+        Token keyword; \
+        AstNode *expr_list; \
+    }) \
+    AST_KIND(IF_STMT, struct { \
+        AstNode *body; \
+        AstNode *cond; \
+        AstNode *else_stmt; \
+        b32 is_root; \
+    }) \
+    AST_KIND(REPEAT_STMT, struct { \
+        AstNode *body; \
+        Token keyword; \
+        AstNode *expr; \
+    }) \
+AST_KIND(_STMT_END, isize) \
+\
+AST_KIND(_EXPR_BEGIN, isize) \
+    AST_KIND(BINARY_EXPR, struct { \
+        AstNode *left; \
+        AstNode *right; \
+        Token op; \
+    }) \
+    AST_KIND(UNARY_EXPR, struct { \
+        AstNode *expr; \
+        Token op; \
+    }) \
+    AST_KIND(PAREN_EXPR, struct { \
+        AstNode *expr; \
+    }) \
+AST_KIND(_EXPR_END, isize) \
+    AST_KIND(KIND_COUNT, isize)
+
+#define IS_IN_RANGE_IN(n, lo, hi) (n >= lo && n <= hi)
+#define IS_IN_RANGE_EX(n, lo, hi) (n > lo && n < hi)
+
+#define AST_KIND_IS_OF_CLASS(kind, c) \
+    IS_IN_RANGE_EX(kind, AST_KIND__##c##_BEGIN, AST_KIND__##c##_END)
+
+#define AST_KIND_PREFIX(t) AST_KIND_##t
+typedef enum {
+#define AST_KIND(e, ...) AST_KIND_PREFIX(e),
+    AST_KINDS
+#undef AST_KIND
+} AstKind;
+
+typedef struct AstNode AstNode;
+
+typedef struct {
+    CyAllocator alloc;
+    AstNode **data;
+    isize len;
+    isize cap;
+} AstList;
+
+#define AST_LIST_INIT_CAP 0x10
+
+#define AST_PREFIX(t) AST_##t
+#define AST_KIND(t, s) typedef s AST_PREFIX(t);
+    AST_KINDS
+#undef AST_KIND
+
+struct AstNode {
+    AstKind kind;
+    union {
+#define AST_KIND(t, ...) AST_PREFIX(t) t;
+        AST_KINDS
+#undef AST_KIND
+    } u;
+};
+
+typedef struct {
+    CyAllocator alloc;
+    AstNode *root;
+    const u8 *src; // NOTE(cya): the text of every token in the tree
+} Ast;
+
+#define AST_NODE_ALLOC(alloc, k) ast_node_alloc(alloc, AST_KIND_PREFIX(k))
+
+static inline AstNode *ast_node_alloc(CyAllocator a, AstKind kind)
+{
+    AstNode *node = cy_alloc(a, sizeof(AstNode));
+    CY_VALIDATE_PTR(node);
+
+    node->kind = kind;
+    return node;
+}
+
+static inline AstList ast_list_init(CyAllocator a)
+{
+    isize cap = AST_LIST_INIT_CAP;
+    AstNode **data = cy_alloc(a, cap * sizeof(AstNode*));
+    return (AstList){
+        .alloc = a,
+        .data = data,
+        .cap = data == NULL ? 0 : cap,
+    };
+}
+
+#define AST_LIST_CREATE(alloc, _list, new, _kind) { \
+    new = *_list; \
+    if (*_list == NULL) { \
+        new = AST_NODE_ALLOC(alloc, _kind); \
+        new->u._kind.list = ast_list_init(alloc); \
+        *_list = new; \
+    }  \
+} (void)0
+
+static inline void ast_list_append_node(AstList *l, AstNode *node)
+{
+    if (l->len == l->cap) {
+        isize new_cap = l->cap * 2;
+        AstNode **new = cy_resize(
+            l->alloc, l->data,
+            l->cap * sizeof(AstNode*), new_cap * sizeof(AstNode*)
+        );
+        l->data = new;
+        l->cap = new_cap;
+    }
+
+    l->data[l->len++] = node;
+}
+
+static inline AstNode *ast_list_get_last_node(AstList *l)
+{
+    return l->data[l->len - 1];
+}
+
+static inline void ast_list_shrink(AstList *l)
+{
+    if (l->len == l->cap) {
+        return;
+    }
+
+    isize new_cap = l->len;
+    AstNode **new = cy_resize(
+        l->alloc, l->data,
+        l->cap * sizeof(AstNode*), new_cap * sizeof(AstNode*)
+    );
+    l->data = new;
+    l->cap = new_cap;
+}
+
+// NOTE(cya): node is the statement (or list, or parentheses) expr is for
+static inline void ast_node_set_expr(AstNode *node, AstNode *expr)
+{
+    CY_ASSERT(
+        node->kind == AST_KIND_ASSIGN_STMT ||
+        node->kind == AST_KIND_IF_STMT ||
+        node->kind == AST_KIND_REPEAT_STMT ||
+        node->kind == AST_KIND_EXPR_LIST ||
+        node->kind == AST_KIND_PAREN_EXPR
+    );
+
+    switch (node->kind) {
+    case AST_KIND_ASSIGN_STMT: {
+        node->u.ASSIGN_STMT.expr = expr;
+    } break;
+    case AST_KIND_IF_STMT: {
+        node->u.IF_STMT.cond = expr;
+    } break;
+    case AST_KIND_REPEAT_STMT: {
+        node->u.REPEAT_STMT.expr = expr;
+    } break;
+    case AST_KIND_EXPR_LIST: {
+        ast_list_append_node(&node->u.EXPR_LIST.list, expr);
+    } break;
+    case AST_KIND_PAREN_EXPR: {
+        node->u.PAREN_EXPR.expr = expr;
+    } break;
+    default: break;
+    }
+}
+
+static inline void ast_expr_insert_node(AstNode *expr, AstNode *node)
+{
+    switch (expr->kind) {
+    case AST_KIND_UNARY_EXPR:
+    case AST_KIND_PAREN_EXPR: {
+        AST_PAREN_EXPR *e = &expr->u.PAREN_EXPR;
+        CY_ASSERT(e->expr == NULL);
+
+        e->expr = node;
+    } break;
+    case AST_KIND_BINARY_EXPR: {
+        AST_BINARY_EXPR *e = &expr->u.BINARY_EXPR;
+        CY_ASSERT(e->left == NULL || e->right == NULL);
+
+        if (e->left == NULL) {
+            e->left = node;
+        } else {
+            e->right = node;
+        }
+    } break;
+    default: break;
+    }
+}
+
+static inline AstEntityKind ast_entity_kind_from_ident(String ident)
+{
+    AstEntityKind kind = -1;
+    if (cy_string_view_has_prefix(ident, "i_")) {
+        kind = AST_ENT_INT;
+    } else if (cy_string_view_has_prefix(ident, "f_")) {
+        kind = AST_ENT_FLOAT;
+    } else if (cy_string_view_has_prefix(ident, "b_")) {
+        kind = AST_ENT_BOOL;
+    } else {
+        kind = AST_ENT_STRING;
+    }
+
+    return kind;
+}
+
+static inline AstEntityKind ast_expr_determine_kind(AstNode *expr)
+{
+    AstEntityKind kind = -1;
+    AstKind expr_kind = expr->kind;
+    switch (expr_kind) {
+    case AST_KIND_BINARY_EXPR: {
+        AstEntityKind lhs = ast_expr_determine_kind(expr->u.BINARY_EXPR.left);
+        AstEntityKind rhs = ast_expr_determine_kind(expr->u.BINARY_EXPR.right);
+
+        Token op = expr->u.BINARY_EXPR.op;
+        switch (op.kind) {
+        case C_TOKEN_ADD:
+        case C_TOKEN_SUB:
+        case C_TOKEN_MUL: {
+            if (lhs == AST_ENT_INT && rhs == AST_ENT_INT) {
+                kind = AST_ENT_INT;
+            } else {
+                kind = AST_ENT_FLOAT;
+            }
+        } break;
+        case C_TOKEN_DIV: {
+            kind = AST_ENT_FLOAT;
+        } break;
+        case C_TOKEN_CMP_EQ:
+        case C_TOKEN_CMP_NE:
+        case C_TOKEN_CMP_GT:
+        case C_TOKEN_CMP_LT: {
+            kind = lhs;
+        } break;
+        case C_TOKEN_AND:
+        case C_TOKEN_OR: {
+            kind = AST_ENT_BOOL;
+        } break;
+        default: break;
+        }
+    } break;
+    case AST_KIND_UNARY_EXPR: {
+        if (expr->u.UNARY_EXPR.op.kind == C_TOKEN_NOT) {
+            kind = AST_ENT_BOOL;
+        } else {
+            kind = ast_expr_determine_kind(expr->u.UNARY_EXPR.expr);
+        }
+    } break;
+    case AST_KIND_PAREN_EXPR: {
+        kind = ast_expr_determine_kind(expr->u.PAREN_EXPR.expr);
+    } break;
+    case AST_KIND_IDENT: {
+        kind = expr->u.IDENT.kind;
+    } break;
+    case AST_KIND_LITERAL: {
+        kind = expr->u.LITERAL.val.kind;
+    } break;
+    default: break;
+    }
+
+    return kind;
+}
+
+static isize ast_node_count(AstNode *node)
+{
+    if (node == NULL) {
+        return 0;
+    }
+
+    isize count = 1;
+    switch (node->kind) {
+    case AST_KIND_MAIN: {
+        count += ast_node_count(node->u.MAIN.body);
+    } break;
+    case AST_KIND_IDENT_LIST:
+    case AST_KIND_INPUT_LIST:
+    case AST_KIND_EXPR_LIST:
+    case AST_KIND_STMT_LIST: {
+        AstList *l = &node->u.STMT_LIST.list;
+        for (isize i = 0; i < l->len; i++) {
+            count += ast_node_count(l->data[i]);
+        }
+    } break;
+    case AST_KIND_INPUT_ARG: {
+        count += ast_node_count(node->u.INPUT_ARG.prompt);
+        count += ast_node_count(node->u.INPUT_ARG.ident);
+    } break;
+    case AST_KIND_VAR_DECL: {
+        count += ast_node_count(node->u.VAR_DECL.ident_list);
+    } break;
+    case AST_KIND_ASSIGN_STMT: {
+        count += ast_node_count(node->u.ASSIGN_STMT.ident_list);
+        count += ast_node_count(node->u.ASSIGN_STMT.expr);
+    } break;
+    case AST_KIND_READ_STMT: {
+        count += ast_node_count(node->u.READ_STMT.input_list);
+    } break;
+    case AST_KIND_WRITE_STMT: {
+        count += ast_node_count(node->u.WRITE_STMT.expr_list);
+    } break;
+    case AST_KIND_IF_STMT: {
+        count += ast_node_count(node->u.IF_STMT.cond);
+        count += ast_node_count(node->u.IF_STMT.body);
+        count += ast_node_count(node->u.IF_STMT.else_stmt);
+    } break;
+    case AST_KIND_REPEAT_STMT: {
+        count += ast_node_count(node->u.REPEAT_STMT.body);
+        count += ast_node_count(node->u.REPEAT_STMT.expr);
+    } break;
+    case AST_KIND_BINARY_EXPR: {
+        count += ast_node_count(node->u.BINARY_EXPR.left);
+        count += ast_node_count(node->u.BINARY_EXPR.right);
+    } break;
+    case AST_KIND_UNARY_EXPR: {
+        count += ast_node_count(node->u.UNARY_EXPR.expr);
+    } break;
+    case AST_KIND_PAREN_EXPR: {
+        count += ast_node_count(node->u.PAREN_EXPR.expr);
+    } break;
+    default: break;
+    }
+
+    return count;
+}
+
+static inline void ast_binary_expr_reduce(CyAllocator a, AstNode *expr)
+{
+    CY_ASSERT(expr->kind == AST_KIND_BINARY_EXPR);
+
+    AST_BINARY_EXPR *e = &expr->u.BINARY_EXPR;
+    CY_ASSERT(e->right == NULL);
+
+    AstNode *child = e->left;
+    // if (child->kind == AST_KIND_BINARY_EXPR) {
+    //     child->u.BINARY_EXPR.op = e->op;
+    // }
+
+    cy_mem_copy(expr, child, sizeof(*expr));
+    cy_free(a, child);
+}
+
+// NOTE(cya): val is tok's value, if it's a numeric constant
+static inline void ast_node_read_token(
+    AstNode *node, const u8 *src, Token *tok, TokenValue val
+) {
+    if (node == NULL) {
+        return;
+    }
+
+    String text = token_text(src, *tok);
+    Token *dest = NULL;
+    switch (node->kind) {
+    case AST_KIND_IDENT_LIST: {
+        if (tok->kind != C_TOKEN_IDENT) {
+            return;
+        }
+
+        AstNode *ident_node = ast_list_get_last_node(&node->u.IDENT_LIST.list);
+        ident_node->u.IDENT.kind = ast_entity_kind_from_ident(text);
+        dest = &ident_node->u.IDENT.tok;
+    } break;
+    case AST_KIND_INPUT_LIST: {
+        if (tok->kind != C_TOKEN_IDENT) {
+            return;
+        }
+
+        AstNode *arg_node = ast_list_get_last_node(&node->u.INPUT_LIST.list);
+        arg_node->u.INPUT_ARG.ident->u.IDENT.kind =
+            ast_entity_kind_from_ident(text);
+        dest = &arg_node->u.INPUT_ARG.ident->u.IDENT.tok;
+    } break;
+    case AST_KIND_INPUT_PROMPT: {
+        if (tok->kind != C_TOKEN_STRING) {
+            return;
+        }
+
+        dest = &node->u.INPUT_PROMPT.string;
+    } break;
+    case AST_KIND_WRITE_STMT: {
+        if (!IS_IN_RANGE_IN(tok->kind, C_TOKEN_WRITE, C_TOKEN_WRITELN)) {
+            return;
+        }
+
+        dest = &node->u.WRITE_STMT.keyword;
+    } break;
+    case AST_KIND_REPEAT_STMT: {
+        if (!IS_IN_RANGE_IN(tok->kind, C_TOKEN_UNTIL, C_TOKEN_WHILE)) {
+            return;
+        }
+
+        dest = &node->u.REPEAT_STMT.keyword;
+    } break;
+    case AST_KIND_LITERAL: {
+        switch (tok->kind) {
+        case C_TOKEN_INTEGER: {
+            node->u.LITERAL.val.kind = AST_ENT_INT;
+            node->u.LITERAL.val.u.i = val.i;
+        } break;
+        case C_TOKEN_FLOAT: {
+            node->u.LITERAL.val.kind = AST_ENT_FLOAT;
+            node->u.LITERAL.val.u.f = (AstFloat){
+                .val = val.f.val,
+                .precision = val.f.precision,
+            };
+        } break;
+        case C_TOKEN_STRING: {
+            node->u.LITERAL.val.kind = AST_ENT_STRING;
+            node->u.LITERAL.val.u.s = text;
+        } break;
+        case C_TOKEN_TRUE: {
+            node->u.LITERAL.val.kind = AST_ENT_BOOL;
+            node->u.LITERAL.val.u.b = true;
+        } break;
+        case C_TOKEN_FALSE: {
+            node->u.LITERAL.val.kind = AST_ENT_BOOL;
+            node->u.LITERAL.val.u.b = false;
+        } break;
+        default: return;
+        }
+
+        dest = &node->u.LITERAL.tok;
+    } break;
+    case AST_KIND_IDENT: {
+        if (tok->kind != C_TOKEN_IDENT) {
+            return;
+        }
+
+        node->u.IDENT.kind = ast_entity_kind_from_ident(text);
+        dest = &node->u.IDENT.tok;
+    } break;
+    case AST_KIND_UNARY_EXPR: {
+        // NOTE(cya): the ")" of -(x) is read with the unary node current too
+        b32 is_op = tok->kind == C_TOKEN_NOT || tok->kind == C_TOKEN_ADD ||
+            tok->kind == C_TOKEN_SUB;
+        if (!is_op) {
+            return;
+        }
+
+        dest = &node->u.UNARY_EXPR.op;
+    } break;
+    default: return;
+    }
+
+    cy_mem_copy(dest, tok, sizeof(*dest));
+}
+
+/* Stack symbols are 16-bit IDs: token kinds as they are, then non-terminals
+ * (from PARSER_SYMBOL_NON_TERMINAL on), with PARSER_SYMBOL_FRAME set on the
+ * non-terminals already expanded. The AST entry of each symbol is kept in a
+ * parallel stack */
+typedef u16 ParserSymbol;
+
+#define PARSER_SYMBOL_NON_TERMINAL C_TOKEN_COUNT
+#define PARSER_SYMBOL_FRAME 0x8000
+
+CY_STATIC_ASSERT(PARSER_SYMBOL_NON_TERMINAL + NT_COUNT < PARSER_SYMBOL_FRAME);
+
+static inline b32 parser_symbol_is_token(ParserSymbol s)
+{
+    return s < PARSER_SYMBOL_NON_TERMINAL;
+}
+
+static inline NonTerminal parser_symbol_non_terminal(ParserSymbol s)
+{
+    return (s & ~PARSER_SYMBOL_FRAME) - PARSER_SYMBOL_NON_TERMINAL;
+}
+
+/* Both stacks share one block (the nodes, then the symbols), grown as deep as
+ * the program nests */
+typedef struct {
+    CyAllocator alloc;
+    AstNode **nodes;
+    ParserSymbol *symbols;
+    isize len;
+    isize cap;
+    isize max_len;
+} ParserStack;
+
+#define PARSER_STACK_SLOT_SIZE (sizeof(AstNode*) + sizeof(ParserSymbol))
+#define PARSER_STACK_ALIGN (sizeof(AstNode*))
+#define PARSER_STACK_INIT_CAP 0x100
+
+typedef enum {
+    P_ERR_OUT_OF_MEMORY = -1,
+    P_ERR_NONE,
+    P_ERR_REACHED_EOF,
+    P_ERR_UNEXPECTED_TOKEN,
+    P_ERR_INVALID_RULE,
+    P_ERR_TOKENIZER, // NOTE(cya): see the tokenizer's error
+} ParserErrorKind;
+
+typedef struct {
+    ParserErrorKind kind;
+    ParserSymbol expected;
+    Token found;
+} ParserError;
+
+// NOTE(cya): the syntax errors a recovering parse found, in source order
+typedef struct {
+    ParserError *items;
+    isize len;
+    isize cap;
+} ParserErrors;
+
+#define PARSER_ERRORS_INIT_CAP 0x10
+
+/* The default backend parses expressions by precedence climbing (see
+ * parse_expr_climbing), the table one expands them through the LL(1) table
+ * like the rest of the program. Both build the same trees and report the same
+ * errors; the table is kept to compare against (compilador_bench --expr) */
+typedef enum {
+    PARSER_EXPR_CLIMBING,
+    PARSER_EXPR_TABLE,
+} ParserExprBackend;
+
+/* Tokens are pulled from the tokenizer as the parser needs them, so there's
+ * never more than the lookahead token in memory, unless they were all lexed
+ * up front (see tokenize_parallel) */
+typedef struct {
+    Tokenizer *tokenizer;
+    const TokenList *tokens; // NOTE(cya): NULL when pulling from the tokenizer
+    isize next_token;
+    Token read_tok;
+    isize token_count;
+    ParserStack stack;
+    ParserExprBackend expr_backend;
+    Ast ast;
+    AstNode *cur_node;
+    ParserError err; // NOTE(cya): the first error
+    b32 recover; // NOTE(cya): go on after a syntax error (see parser_recover)
+    ParserErrors errors;
+} Parser;
+
+static void parser_error(Parser *p, ParserErrorKind kind);
+
+static b32 parser_stack_grow(Parser *p)
+{
+    ParserStack *s = &p->stack;
+    isize old_size = s->cap * PARSER_STACK_SLOT_SIZE;
+    isize new_cap = s->cap * 2;
+    AstNode **nodes = cy_resize_align(
+        s->alloc, s->nodes, old_size, new_cap * PARSER_STACK_SLOT_SIZE,
+        PARSER_STACK_ALIGN
+    );
+    if (nodes == NULL) {
+        parser_error(p, P_ERR_OUT_OF_MEMORY);
+        return false;
+    }
+
+    // NOTE(cya): the symbols move up to make room for the new nodes
+    ParserSymbol *symbols = (ParserSymbol*)(nodes + new_cap);
+    cy_mem_move(symbols, nodes + s->cap, s->len * sizeof(*symbols));
+
+    s->nodes = nodes;
+    s->symbols = symbols;
+    s->cap = new_cap;
+    return true;
+}
+
+static inline void parser_stack_push(
+    Parser *p, ParserSymbol symbol, AstNode *ast_entry
+) {
+    ParserStack *s = &p->stack;
+    if (s->len == s->cap && !parser_stack_grow(p)) {
+        return;
+    }
+
+    s->symbols[s->len] = symbol;
+    s->nodes[s->len] = ast_entry == NULL ? p->cur_node : ast_entry;
+    s->len += 1;
+    if (s->len > s->max_len) {
+        s->max_len = s->len;
+    }
+}
+
+static inline void parser_stack_push_token(
+    Parser *p, TokenKind kind, AstNode *ast_entry
+) {
+    parser_stack_push(p, (ParserSymbol)kind, ast_entry);
+}
+
+static inline void parser_stack_push_non_terminal(
+    Parser *p, NonTerminal n, AstNode *ast_entry
+) {
+    ParserSymbol symbol = (ParserSymbol)(PARSER_SYMBOL_NON_TERMINAL + n);
+    parser_stack_push(p, symbol, ast_entry);
+}
+
+/* Pushes the symbols in order without their AST entries, for parsing that
+ * builds no tree (see parser_recognize) */
+static inline void parser_stack_push_symbols(
+    Parser *p, const ParserSymbol *symbols, isize count
+) {
+    ParserStack *s = &p->stack;
+    while (s->len + count > s->cap) {
+        if (!parser_stack_grow(p)) {
+            return;
+        }
+    }
+
+    cy_mem_copy(&s->symbols[s->len], symbols, count * sizeof(*symbols));
+    s->len += count;
+    if (s->len > s->max_len) {
+        s->max_len = s->len;
+    }
+}
+
+static inline void parser_stack_pop(Parser *p)
+{
+    if (p->stack.len > 0) {
+        p->stack.len -= 1;
+    }
+}
+
+static inline ParserSymbol parser_stack_peek(const Parser *p)
+{
+    return p->stack.symbols[p->stack.len - 1];
+}
+
+static inline b32 parser_stack_is_empty(Parser *p)
+{
+    return p->stack.len < 1;
+}
+
+/* The expanded non-terminal stays under its symbols, to bring back its AST
+ * entry once they're done. One that's last in its parent's rule (right on top
+ * of another frame) would only be popped right before the parent, so it's
+ * dropped instead, like a tail call: lists don't pile up a frame per element,
+ * and the stack only gets as deep as the program nests */
+static inline void parser_stack_begin_frame(Parser *p)
+{
+    ParserStack *s = &p->stack;
+    isize top = s->len - 1;
+    if (top > 0 && (s->symbols[top - 1] & PARSER_SYMBOL_FRAME)) {
+        s->len -= 1;
+    } else {
+        s->symbols[top] |= PARSER_SYMBOL_FRAME;
+    }
+}
+
+static inline void parser_error_expecting(
+    Parser *p, ParserErrorKind kind, ParserSymbol expected
+) {
+    p->err = (ParserError){
+        .kind = kind,
+        .expected = expected,
+        .found = p->read_tok,
+    };
+}
+
+static inline void parser_error(Parser *p, ParserErrorKind kind)
+{
+    if (p == NULL) {
+        return;
+    }
+
+    parser_error_expecting(
+        p, kind, parser_stack_peek(p) & ~PARSER_SYMBOL_FRAME
+    );
+}
+
+static inline GrammarRule parser_rule(NonTerminal n, TokenKind lookahead)
+{
+    u8 table_row = g_ll1_row_from_kind[n];
+    u8 table_col = g_ll1_col_from_kind[lookahead];
+    return g_ll1_table[table_row][table_col];
+}
+
+// NOTE(cya): whether s can go on with a lookahead of kind
+static inline b32 parser_symbol_accepts(ParserSymbol s, TokenKind kind)
+{
+    if (s & PARSER_SYMBOL_FRAME) {
+        return false; // NOTE(cya): already expanded
+    } else if (parser_symbol_is_token(s)) {
+        return s == kind;
+    }
+
+    return !RULE_IS_INVALID(parser_rule(parser_symbol_non_terminal(s), kind));
+}
+
+static inline b32 parser_errors_push(
+    CyAllocator a, ParserErrors *e, ParserError err
+) {
+    if (e->len == e->cap) {
+        isize new_cap = CY_MAX(e->cap * 2, PARSER_ERRORS_INIT_CAP);
+        ParserError *items = cy_resize_array(
+            a, e->items, ParserError, e->cap, new_cap
+        );
+        if (items == NULL) {
+            return false;
+        }
+
+        e->items = items;
+        e->cap = new_cap;
+    }
+
+    e->items[e->len] = err;
+    e->len += 1;
+    return true;
+}
+
+static CyString reachable_terminals(CyAllocator a, NonTerminal n)
+{
+    return cy_string_create(a, g_ll1_expected[g_ll1_row_from_kind[n]]);
+}
+
+static CyString parser_error_append_msg(
+    CyString msg, LineIndex *lines, const u8 *src, const ParserError *err
+) {
+    msg = append_error_prefix(msg, lines, err->found);
+
+    CyAllocator a = CY_STRING_HEADER(msg)->alloc;
+    Token found = err->found;
+    String found_str;
+    switch (found.kind) {
+    case C_TOKEN_EOF:
+    case C_TOKEN_STRING: {
+        found_str = g_token_strings[found.kind];
+    } break;
+    default: {
+        found_str = token_text(src, found);
+    } break;
+    }
+
+    ParserSymbol expected = err->expected;
+    CyString expected_str = NULL;
+    if (parser_symbol_is_token(expected)) {
+        switch (expected) {
+        case C_TOKEN_IDENT:
+        case C_TOKEN_INTEGER:
+        case C_TOKEN_FLOAT:
+        case C_TOKEN_STRING: {
+            expected_str = cy_string_from_token_kind(a, expected);
+        } break;
+        default: {
+            expected_str = cy_string_create_view(a, g_token_strings[expected]);
+        } break;
+        }
+    } else {
+        NonTerminal n = parser_symbol_non_terminal(expected);
+        expected_str = non_terminal_description(a, n);
+    }
+
+    msg = cy_string_append_fmt(
+        msg, "encontrado %.*s esperado %s",
+        STRING_ARG(found_str),
+        expected_str
+    );
+    cy_string_free(expected_str);
+
+    return msg;
+}
+
+static inline CyString parser_append_error_msg(
+    CyString msg, LineIndex *lines, const Parser *p
+) {
+    return parser_error_append_msg(msg, lines, p->tokenizer->start, &p->err);
+}
+
+// NOTE(cya): one line per error, like lex_diagnostics_append_msg
+static CyString parser_errors_append_msg(
+    CyString msg, LineIndex *lines, const Parser *p
+) {
+    const ParserErrors *e = &p->errors;
+    for (isize i = 0; i < e->len; i++) {
+        if (i > 0) {
+            msg = cy_string_append_c(msg, "\n");
+        }
+
+        msg = parser_error_append_msg(
+            msg, lines, p->tokenizer->start, &e->items[i]
+        );
+    }
+
+    return msg;
+}
+
+/* The value of read_tok, if it's a numeric constant. From a list, it's only
+ * worked out for the tokens that need it (the ones that make it into a tree) */
+static inline TokenValue parser_read_value(const Parser *p)
+{
+    const Tokenizer *t = p->tokenizer;
+    if (p->tokens == NULL) {
+        return t->value; // NOTE(cya): read_tok is the last one it lexed
+    }
+
+    return token_list_value(t->start, p->read_tok);
+}
+
+// NOTE(cya): reads the next token that isn't a comment
+static inline void parser_read_token(Parser *p)
+{
+    Tokenizer *t = p->tokenizer;
+    const TokenList *l = p->tokens;
+    b32 lexical_error = false;
+    do {
+        if (l == NULL) {
+            p->read_tok = tokenizer_next_token(t);
+            lexical_error = t->err != T_ERR_NONE;
+        } else if (p->next_token < l->len) {
+            p->read_tok = token_list_get(l, p->next_token++);
+        } else {
+            // NOTE(cya): the list only stops short of EOF at a lexical error
+            lexical_error = true;
+        }
+    } while (p->read_tok.kind == C_TOKEN_COMMENT && !lexical_error);
+
+    p->token_count += 1;
+    if (lexical_error) {
+        parser_error(p, P_ERR_TOKENIZER);
+    }
+}
+
+// NOTE(cya): tokens is NULL to pull them from t as the parse goes
+static Parser parser_init(
+    CyAllocator stack_allocator, Tokenizer *t, const TokenList *tokens,
+    isize stack_cap
+) {
+    isize cap = CY_MAX(stack_cap, 0x10);
+    isize size = cap * PARSER_STACK_SLOT_SIZE;
+    AstNode **nodes = cy_alloc_align(stack_allocator, size, PARSER_STACK_ALIGN);
+    if (nodes == NULL) {
+        return (Parser){ .err.kind = P_ERR_OUT_OF_MEMORY, };
+    }
+
+    Parser p = {
+        .tokenizer = t,
+        .tokens = tokens,
+        .stack = (ParserStack){
+            .alloc = stack_allocator,
+            .nodes = nodes,
+            .symbols = (ParserSymbol*)(nodes + cap),
+            .cap = cap,
+        },
+    };
+    parser_stack_push_token(&p, C_TOKEN_EOF, NULL);
+    parser_stack_push_non_terminal(&p, NT_START, NULL);
+    parser_read_token(&p);
+
+    return p;
+}
+
+/* How tightly each operator binds, from the loosest. Operators of the same
+ * precedence nest to the right (a - b - c is a - (b - c)), like the grammar's
+ * tails do, and a comparison can't be the operand of another */
+typedef enum {
+    EXPR_PREC_NONE,
+    EXPR_PREC_LOGICAL,
+    EXPR_PREC_NOT,
+    EXPR_PREC_RELATIONAL,
+    EXPR_PREC_ADDITIVE,
+    EXPR_PREC_MULTIPLICATIVE,
+    EXPR_PREC_SIGN,
+} ExprPrec;
+
+/* Once an operand is done, the lookahead goes through the tail of each level
+ * of the grammar, from the innermost: an operator continues that level, and
+ * its î rule moves on to the next */
+typedef struct {
+    ExprPrec prec;
+    NonTerminal tail;
+    GrammarRule empty;
+    NonTerminal operand; // NOTE(cya): what comes after the operator
+} ExprLevel;
+
+static const ExprLevel g_expr_levels[] = {
+    { EXPR_PREC_MULTIPLICATIVE, NT_TERM_R, GR_66, NT_FACTOR },
+    { EXPR_PREC_ADDITIVE, NT_ARITHMETIC_R, GR_62, NT_TERM },
+    { EXPR_PREC_RELATIONAL, NT_RELATIONAL_R, GR_54, NT_ARITHMETIC },
+    { EXPR_PREC_LOGICAL, NT_EXPR_LOG, GR_47, NT_ELEMENT },
+};
+
+#define EXPR_LEVEL_COUNT CY_STATIC_ARR_LEN(g_expr_levels)
+#define EXPR_LEVEL_ELEMENT (EXPR_LEVEL_COUNT - 1) // NOTE(cya): true and false
+
+// NOTE(cya): open parentheses don't bind at all
+static inline ExprPrec expr_node_prec(const AstNode *node)
+{
+    switch (node->kind) {
+    case AST_KIND_UNARY_EXPR: {
+        b32 is_not = node->u.UNARY_EXPR.op.kind == C_TOKEN_NOT;
+        return is_not ? EXPR_PREC_NOT : EXPR_PREC_SIGN;
+    } break;
+    case AST_KIND_BINARY_EXPR: {
+        TokenKind op = node->u.BINARY_EXPR.op.kind;
+        if (op == C_TOKEN_AND || op == C_TOKEN_OR) {
+            return EXPR_PREC_LOGICAL;
+        } else if (op == C_TOKEN_ADD || op == C_TOKEN_SUB) {
+            return EXPR_PREC_ADDITIVE;
+        } else if (op == C_TOKEN_MUL || op == C_TOKEN_DIV) {
+            return EXPR_PREC_MULTIPLICATIVE;
+        }
+
+        return EXPR_PREC_RELATIONAL;
+    } break;
+    default: return EXPR_PREC_NONE;
+    }
+}
+
+/* Hands operand to the operators on the stack (above base) that bind tighter
+ * than prec, returning the tree they make */
+static inline AstNode *parser_expr_reduce(
+    Parser *p, isize base, AstNode *operand, ExprPrec prec
+) {
+    ParserStack *s = &p->stack;
+    while (s->len > base && expr_node_prec(s->nodes[s->len - 1]) > prec) {
+        AstNode *node = s->nodes[s->len - 1];
+        if (node->kind == AST_KIND_BINARY_EXPR) {
+            node->u.BINARY_EXPR.right = operand;
+        } else {
+            node->u.UNARY_EXPR.expr = operand;
+        }
+
+        operand = node;
+        parser_stack_pop(p);
+    }
+
+    return operand;
+}
+
+// NOTE(cya): the tails from the outermost level down to from
+static inline void parser_expr_push_tails(
+    Parser *p, isize from, b32 compared
+) {
+    for (isize level = EXPR_LEVEL_COUNT - 1; level >= from; level--) {
+        const ExprLevel *l = &g_expr_levels[level];
+        if (l->prec != EXPR_PREC_RELATIONAL || !compared) {
+            parser_stack_push_non_terminal(p, l->tail, NULL);
+        }
+    }
+}
+
+/* Swaps the operators and open parentheses above base for the symbols the
+ * table-driven parse would have on the stack at the same syntax error, so
+ * both recover from it the same way (see parser_recover). Inside each pair of
+ * parentheses, that's the tail of every level its innermost operand is under
+ * (the relational one only until a comparison), and then the ")" */
+static void parser_expr_unwind(Parser *p, isize base)
+{
+    ParserStack *s = &p->stack;
+    isize len = s->len;
+    b32 compared = false;
+    for (isize i = base; i < len; i++) {
+        switch (expr_node_prec(s->nodes[i])) {
+        case EXPR_PREC_NONE: { // NOTE(cya): the parentheses are a <fator>
+            parser_expr_push_tails(p, 0, compared);
+            parser_stack_push_token(p, C_TOKEN_PAREN_CLOSE, NULL);
+            compared = false;
+        } break;
+        case EXPR_PREC_LOGICAL:
+        case EXPR_PREC_NOT: {
+            compared = false;
+        } break;
+        case EXPR_PREC_RELATIONAL: {
+            compared = true;
+        } break;
+        default: break;
+        }
+    }
+
+    // NOTE(cya): the error was either at a tail, at an operand (with the
+    // tails of the levels above it pending) or at a missing ")"
+    ParserSymbol expected = p->err.expected;
+    if (!parser_symbol_is_token(expected)) {
+        NonTerminal n = parser_symbol_non_terminal(expected);
+        isize level = 0;
+        while (level < EXPR_LEVEL_COUNT && g_expr_levels[level].tail != n &&
+            g_expr_levels[level].operand != n) {
+            level += 1;
+        }
+
+        parser_expr_push_tails(p, level, compared);
+        if (level == EXPR_LEVEL_COUNT || g_expr_levels[level].tail != n) {
+            parser_stack_push_non_terminal(p, n, NULL);
+        }
+    }
+
+    isize count = s->len - len;
+    cy_mem_move(&s->nodes[base], &s->nodes[len], count * sizeof(*s->nodes));
+    cy_mem_move(
+        &s->symbols[base], &s->symbols[len], count * sizeof(*s->symbols)
+    );
+    s->len = base + count;
+}
+
+static inline AstNode *parser_expr_error(
+    Parser *p, isize base, ParserErrorKind kind, ParserSymbol expected
+) {
+    parser_error_expecting(p, kind, expected);
+    parser_expr_unwind(p, base);
+    return NULL;
+}
+
+/* Precedence climbing, for the <expr> on top of the stack: it builds the same
+ * tree the table does, but with one node per operator and operand, where the
+ * table allocates a BINARY_EXPR for every level an operand goes through (and
+ * then folds the ones without an operator back into their operand). The
+ * operators waiting for their right operand, and the open parentheses, are
+ * kept on the parser stack. The lookahead is checked against the same table
+ * rows the table-driven parse would have expanded, so it stops at the same
+ * syntax errors. Returns NULL on any error */
+static AstNode *parse_expr_climbing(CyAllocator a, Parser *p)
+{
+    const u8 *src = p->tokenizer->start;
+    isize base = p->stack.len;
+    NonTerminal operand_nt = NT_EXPR;
+    for (;;) {
+        // NOTE(cya): prefix operators and open parentheses, then the operand
+        AstNode *operand = NULL;
+        isize level = 0;
+        while (operand == NULL) {
+            TokenKind kind = p->read_tok.kind;
+            if (RULE_IS_INVALID(parser_rule(operand_nt, kind))) {
+                ParserSymbol expected = PARSER_SYMBOL_NON_TERMINAL + operand_nt;
+                return parser_expr_error(p, base, P_ERR_INVALID_RULE, expected);
+            }
+
+            AstNode *node = NULL;
+            switch (kind) {
+            case C_TOKEN_IDENT: {
+                node = operand = AST_NODE_ALLOC(a, IDENT);
+            } break;
+            case C_TOKEN_INTEGER:
+            case C_TOKEN_FLOAT:
+            case C_TOKEN_STRING: {
+                node = operand = AST_NODE_ALLOC(a, LITERAL);
+            } break;
+            case C_TOKEN_TRUE:
+            case C_TOKEN_FALSE: {
+                node = operand = AST_NODE_ALLOC(a, LITERAL);
+                level = EXPR_LEVEL_ELEMENT;
+            } break;
+            case C_TOKEN_PAREN_OPEN: {
+                node = AST_NODE_ALLOC(a, PAREN_EXPR);
+                parser_stack_push_token(p, C_TOKEN_PAREN_CLOSE, node);
+                operand_nt = NT_EXPR;
+            } break;
+            default: { // NOTE(cya): !, or a sign
+                node = AST_NODE_ALLOC(a, UNARY_EXPR);
+                parser_stack_push_token(p, kind, node);
+                operand_nt = kind == C_TOKEN_NOT ? NT_ELEMENT : NT_FACTOR;
+            } break;
+            }
+
+            ast_node_read_token(
+                node, src, &p->read_tok, parser_read_value(p)
+            );
+            parser_read_token(p);
+            if (p->err.kind != P_ERR_NONE) {
+                return NULL;
+            }
+        }
+
+        for (;;) {
+            for (; level < EXPR_LEVEL_COUNT; level++) {
+                const ExprLevel *l = &g_expr_levels[level];
+                operand = parser_expr_reduce(p, base, operand, l->prec);
+
+                // NOTE(cya): the right side of a comparison has no tail
+                ParserStack *s = &p->stack;
+                b32 compared = s->len > base &&
+                    expr_node_prec(s->nodes[s->len - 1]) == l->prec;
+                if (l->prec == EXPR_PREC_RELATIONAL && compared) {
+                    continue;
+                }
+
+                GrammarRule rule = parser_rule(l->tail, p->read_tok.kind);
+                if (RULE_IS_INVALID(rule)) {
+                    return parser_expr_error(
+                        p, base, P_ERR_INVALID_RULE,
+                        PARSER_SYMBOL_NON_TERMINAL + l->tail
+                    );
+                } else if (rule != l->empty) {
+                    break;
+                }
+            }
+
+            if (level < EXPR_LEVEL_COUNT) {
+                break;
+            }
+
+            operand = parser_expr_reduce(p, base, operand, EXPR_PREC_NONE);
+            if (p->stack.len == base) {
+                return operand;
+            } else if (p->read_tok.kind != C_TOKEN_PAREN_CLOSE) {
+                return parser_expr_error(
+                    p, base, P_ERR_UNEXPECTED_TOKEN, C_TOKEN_PAREN_CLOSE
+                );
+            }
+
+            // NOTE(cya): the parentheses are an operand of their own
+            AstNode *paren = p->stack.nodes[p->stack.len - 1];
+            paren->u.PAREN_EXPR.expr = operand;
+            operand = paren;
+            parser_stack_pop(p);
+
+            parser_read_token(p);
+            if (p->err.kind != P_ERR_NONE) {
+                return NULL;
+            }
+
+            level = 0;
+        }
+
+        AstNode *node = AST_NODE_ALLOC(a, BINARY_EXPR);
+        node->u.BINARY_EXPR.left = operand;
+        node->u.BINARY_EXPR.op = p->read_tok;
+        parser_stack_push_token(p, p->read_tok.kind, node);
+        operand_nt = g_expr_levels[level].operand;
+
+        parser_read_token(p);
+        if (p->err.kind != P_ERR_NONE) {
+            return NULL;
+        }
+    }
+}
+
+/* Runs the LL(1) automaton over the tokens without building anything, until
+ * EOF is matched or an error. A non-terminal on top is swapped for what it
+ * expands to down to the lookahead in one go (see g_ll1_closure), and only
+ * expanded one rule at a time (from g_ll1_rhs) where that runs into an error,
+ * so it fails on the same symbol parse() would */
+static void parser_recognize(Parser *p)
+{
+    ParserStack *s = &p->stack;
+    if (p->err.kind != P_ERR_NONE) {
+        return;
+    }
+
+    for (;;) {
+        TokenKind kind = p->read_tok.kind;
+        u8 table_col = g_ll1_col_from_kind[kind];
+
+        // NOTE(cya): the tails left over from the last operand or statement
+        // mostly derive î, and go in a row
+        u64 derives_empty = g_ll1_derives_empty[table_col];
+        ParserSymbol stack_top = s->symbols[s->len - 1];
+        for (;;) {
+            u32 n = (u32)stack_top - PARSER_SYMBOL_NON_TERMINAL;
+            if (n >= NT_COUNT || (derives_empty >> n & 1) == 0) {
+                break;
+            }
+
+            s->len -= 1;
+            stack_top = s->symbols[s->len - 1];
+        }
+
+        if (parser_symbol_is_token(stack_top)) {
+            if (stack_top != kind) {
+                parser_error(p, P_ERR_UNEXPECTED_TOKEN);
+                return;
+            } else if (kind == C_TOKEN_EOF) {
+                return;
+            }
+
+            s->len -= 1;
+        } else if (stack_top & PARSER_SYMBOL_FRAME) {
+            s->len -= 1;
+            continue;
+        } else {
+            NonTerminal n = parser_symbol_non_terminal(stack_top);
+            u8 table_row = g_ll1_row_from_kind[n];
+            u16 closure = g_ll1_closure[table_row][table_col];
+            if (closure == 0) {
+                GrammarRule rule = parser_rule(n, kind);
+                if (RULE_IS_INVALID(rule)) {
+                    parser_error(p, P_ERR_INVALID_RULE);
+                    return;
+                }
+
+                s->len -= 1;
+                parser_stack_push_symbols(
+                    p, g_ll1_rhs[rule], g_ll1_rhs_len[rule]
+                );
+                if (p->err.kind != P_ERR_NONE) {
+                    return;
+                }
+
+                continue;
+            }
+
+            s->len -= 1;
+            if (s->len + LL1_CLOSURE_MAX_LEN > s->cap &&
+                !parser_stack_grow(p)) {
+                return;
+            }
+
+            // NOTE(cya): the last symbol is the lookahead, which is matched
+            // right away instead; copying a whole LL1_CLOSURE_MAX_LEN (the
+            // pool is padded for it) is cheaper than the exact count
+            isize count = g_ll1_closure_syms[closure];
+            CY_ASSERT(count > 0); // NOTE(cya): see g_ll1_derives_empty
+            cy_mem_copy(
+                &s->symbols[s->len], &g_ll1_closure_syms[closure + 1],
+                LL1_CLOSURE_MAX_LEN * sizeof(*s->symbols)
+            );
+            s->len += count - 1;
+            s->max_len = CY_MAX(s->max_len, s->len + 1);
+        }
+
+        parser_read_token(p);
+        if (p->err.kind != P_ERR_NONE) {
+            return;
+        }
+    }
+}
+
+// NOTE(cya): the non-terminal each rule expands
+static const u8 g_grammar_rule_lhs[GR_COUNT] = {
+#define GRAMMAR_RULE(e, n, s) [e] = n
+    GRAMMAR_RULES
+#undef GRAMMAR_RULE
+};
+
+/* The tokens panic mode resyncs on: the ; after each statement, and the
+ * FOLLOW set of the statement lists (what closes a block) */
+static inline b32 token_is_sync(TokenKind kind)
+{
+    switch (kind) {
+    case C_TOKEN_SEMICOLON:
+    case C_TOKEN_END:
+    case C_TOKEN_ELIF:
+    case C_TOKEN_ELSE:
+    case C_TOKEN_UNTIL:
+    case C_TOKEN_WHILE:
+    case C_TOKEN_EOF: return true;
+    default: return false;
+    }
+}
+
+/* Pops the stack down to the nearest symbol that goes on with the lookahead
+ * (a sync token), or to a non-terminal with a rule that has it, which is then
+ * expanded from there on: a <lista_cmd> that was still to come goes on from
+ * the ; of its first statement, the one the error was in. Returns false if
+ * nothing on the stack has a use for it */
+static b32 parser_sync(Parser *p)
+{
+    ParserStack *s = &p->stack;
+    TokenKind kind = p->read_tok.kind;
+    for (isize top = s->len - 1; top >= 0; top--) {
+        ParserSymbol symbol = s->symbols[top];
+        if (parser_symbol_accepts(symbol, kind)) {
+            s->len = top + 1;
+            return true;
+        } else if ((symbol & PARSER_SYMBOL_FRAME) ||
+            parser_symbol_is_token(symbol)) {
+            continue;
+        }
+
+        NonTerminal n = parser_symbol_non_terminal(symbol);
+        for (GrammarRule rule = GR_0; rule < GR_COUNT; rule++) {
+            isize at = g_ll1_rhs_len[rule] - 1;
+            while (at >= 0 && g_ll1_rhs[rule][at] != kind) {
+                at -= 1;
+            }
+
+            if (g_grammar_rule_lhs[rule] != n || at < 0) {
+                continue;
+            }
+
+            // NOTE(cya): the symbols are pushed the last one first
+            s->len = top;
+            parser_stack_push_symbols(p, g_ll1_rhs[rule], at + 1);
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Pops the stack down to a symbol still pending in the statement the error is
+ * in (above the sync token that ends it) that goes on with the lookahead,
+ * like the ) of writeln(i_a +); so that token isn't skipped only for that
+ * symbol to fail on the next one. Returns false if there's none, and the
+ * token is then a stray one */
+static b32 parser_pop_to_pending(Parser *p)
+{
+    ParserStack *s = &p->stack;
+    TokenKind kind = p->read_tok.kind;
+    for (isize top = s->len - 1; top >= 0; top--) {
+        ParserSymbol symbol = s->symbols[top];
+        if (!parser_symbol_is_token(symbol)) {
+            continue;
+        } else if (symbol == kind) {
+            s->len = top + 1;
+            return true;
+        } else if (token_is_sync((TokenKind)symbol)) {
+            break;
+        }
+    }
+
+    return false;
+}
+
+/* Panic mode, to report every syntax error in one pass: the tree is left as
+ * it was at the first one (it's never checked anyway) and the rest of the
+ * source is only recognized. At each error, tokens are skipped until one the
+ * symbol that failed can go on with (a stray token is just dropped), one a
+ * symbol pending in the same statement can (see parser_pop_to_pending), or a
+ * sync token, which the stack is popped down to (see parser_sync). An error
+ * on the same token as the last one is only that one cascading, and isn't
+ * recorded. Stops at the first lexical error, which gets reported instead */
+static void parser_recover(CyAllocator a, Parser *p)
+{
+    ParserError first = p->err;
+    for (;;) {
+        ParserErrors *e = &p->errors;
+        b32 is_new = e->len == 0 ||
+            e->items[e->len - 1].found.offset != p->err.found.offset;
+        if (is_new && !parser_errors_push(a, e, p->err)) {
+            break;
+        }
+
+        for (;;) {
+            TokenKind kind = p->read_tok.kind;
+            if (parser_symbol_accepts(parser_stack_peek(p), kind)) {
+                break;
+            } else if (token_is_sync(kind) && parser_sync(p)) {
+                break;
+            } else if (parser_pop_to_pending(p)) {
+                break;
+            }
+
+            // NOTE(cya): EOF always syncs, on the one at the bottom
+            parser_read_token(p);
+            if (p->err.kind == P_ERR_TOKENIZER) {
+                return;
+            }
+        }
+
+        p->err = (ParserError){0};
+        parser_recognize(p);
+
+        ParserErrorKind kind = p->err.kind;
+        if (kind != P_ERR_UNEXPECTED_TOKEN && kind != P_ERR_INVALID_RULE) {
+            break;
+        }
+    }
+
+    if (p->err.kind != P_ERR_TOKENIZER) {
+        p->err = first;
+    }
+}
+
+static Ast parse(CyAllocator a, Parser *p)
+{
+    p->ast = (Ast){.alloc = a, .src = p->tokenizer->start};
+    for (;;) {
+        if (p->err.kind != P_ERR_NONE) {
+            break;
+        }
+
+        ParserSymbol stack_top = parser_stack_peek(p);
+        if (parser_symbol_is_token(stack_top)) {
+            TokenKind kind = stack_top;
+            if (kind != p->read_tok.kind) {
+                parser_error(p, P_ERR_UNEXPECTED_TOKEN);
+                break;
+            } else if (kind == C_TOKEN_EOF) {
+                break;
+            }
+
+            ast_node_read_token(
+                p->cur_node, p->tokenizer->start, &p->read_tok,
+                parser_read_value(p)
+            );
+            parser_stack_pop(p);
+
+            parser_read_token(p);
+            continue;
+        } else if (stack_top & PARSER_SYMBOL_FRAME) {
+            parser_stack_pop(p);
+            if (!parser_stack_is_empty(p)) {
+                p->cur_node = p->stack.nodes[p->stack.len - 1];
+            }
+
+            continue;
+        }
+
+        NonTerminal n = parser_symbol_non_terminal(stack_top);
+        if (n == NT_EXPR && p->expr_backend == PARSER_EXPR_CLIMBING) {
+            AstNode *parent = p->cur_node;
+            parser_stack_begin_frame(p);
+
+            AstNode *expr = parse_expr_climbing(a, p);
+            if (expr == NULL) {
+                break;
+            }
+
+            ast_node_set_expr(parent, expr);
+            continue;
+        }
+
+        GrammarRule rule = parser_rule(n, p->read_tok.kind);
+        if (RULE_IS_INVALID(rule)) {
+            parser_error(p, P_ERR_INVALID_RULE);
+            break;
+        }
+
+        parser_stack_begin_frame(p);
+
+        AstNode *new_node = p->cur_node;
+        switch (rule) {
+        case GR_0: { // <inicio> ::= main <lista_instr> end
+            parser_stack_push_token(p, C_TOKEN_END, NULL);
+            parser_stack_push_non_terminal(p, NT_INSTR_LIST, NULL);
+            parser_stack_push_token(p, C_TOKEN_MAIN, NULL);
+
+            CY_ASSERT(p->cur_node == NULL);
+
+            new_node = AST_NODE_ALLOC(a, MAIN);
+            p->ast.root = new_node;
+        } break;
+        case GR_1: { // <lista_instr> ::= <instrucao> ";" <lista_instr_rep>
+            parser_stack_push_non_terminal(p, NT_INSTR_LIST_R, NULL);
+            parser_stack_push_token(p, C_TOKEN_SEMICOLON, NULL);
+            parser_stack_push_non_terminal(p, NT_INSTRUCTION, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_MAIN);
+
+            AstNode **body = &(p->cur_node->u.MAIN.body);
+            AST_LIST_CREATE(a, body, new_node, STMT_LIST);
+        } break;
+        case GR_2: { // <lista_instr_rep> ::= <lista_instr>
+            parser_stack_push_non_terminal(p, NT_INSTR_LIST, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_MAIN);
+        } break;
+        case GR_3: { // <lista_instr_rep> ::= î
+            CY_ASSERT(p->cur_node->kind == AST_KIND_MAIN);
+
+            AstList *l = &p->cur_node->u.MAIN.body->u.STMT_LIST.list;
+            ast_list_shrink(l);
+        } break;
+        case GR_4: { // <instrucao> ::= <dec_ou_atr>
+            parser_stack_push_non_terminal(p, NT_DEC_OR_ASSIGN, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_STMT_LIST);
+
+            // NOTE(cya): assuming assignment first
+            AstList *l = &p->cur_node->u.STMT_LIST.list;
+            new_node = AST_NODE_ALLOC(a, ASSIGN_STMT);
+            ast_list_append_node(l, new_node);
+        } break;
+        case GR_5: { // <instrucao> ::= <cmd_entr>
+            parser_stack_push_non_terminal(p, NT_CMD_INPUT, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_STMT_LIST);
+
+            AstList *l = &p->cur_node->u.STMT_LIST.list;
+            new_node = AST_NODE_ALLOC(a, READ_STMT);
+            ast_list_append_node(l, new_node);
+        } break;
+        case GR_6: { // <instrucao> ::= <cmd_saida>
+            parser_stack_push_non_terminal(p, NT_CMD_OUTPUT, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_STMT_LIST);
+
+            AstList *l = &p->cur_node->u.STMT_LIST.list;
+            new_node = AST_NODE_ALLOC(a, WRITE_STMT);
+            ast_list_append_node(l, new_node);
+        } break;
+        case GR_7: { // <instrucao> ::= <cmd_rep>
+            parser_stack_push_non_terminal(p, NT_CMD_LOOP, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_STMT_LIST);
+
+            AstList *l = &p->cur_node->u.STMT_LIST.list;
+            new_node = AST_NODE_ALLOC(a, REPEAT_STMT);
+            ast_list_append_node(l, new_node);
+        } break;
+        case GR_8: { // <instrucao> ::= <cmd_sel>
+            parser_stack_push_non_terminal(p, NT_CMD_COND, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_STMT_LIST);
+
+            AstList *l = &p->cur_node->u.STMT_LIST.list;
+            new_node = AST_NODE_ALLOC(a, IF_STMT);
+            ast_list_append_node(l, new_node);
+        } break;
+        case GR_9: { // <dec_ou_atr> ::= <lista_id> <atr_opt>
+            parser_stack_push_non_terminal(p, NT_ASSIGN_OPT, NULL);
+            parser_stack_push_non_terminal(p, NT_ID_LIST, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_ASSIGN_STMT);
+
+            AstNode **ident_list = &p->cur_node->u.ASSIGN_STMT.ident_list;
+            AST_LIST_CREATE(a, ident_list, new_node, IDENT_LIST);
+        } break;
+        case GR_10: { // <atr_opt> ::= "=" <expr>
+            parser_stack_push_non_terminal(p, NT_EXPR, NULL);
+            parser_stack_push_token(p, C_TOKEN_EQUALS, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_ASSIGN_STMT);
+        } break;
+        case GR_11: { // <atr_opt> ::= î
+            CY_ASSERT(p->cur_node->kind == AST_KIND_ASSIGN_STMT);
+
+            p->cur_node->kind = AST_KIND_VAR_DECL;
+        } break;
+        case GR_12: { // <lista_id> ::= identificador <lista_id_mul>
+            parser_stack_push_non_terminal(p, NT_ID_LIST_R, NULL);
+            parser_stack_push_token(p, C_TOKEN_IDENT, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_IDENT_LIST);
+
+            AstNode *ident_node = AST_NODE_ALLOC(a, IDENT);
+            AstList *l = &p->cur_node->u.IDENT_LIST.list;
+            ast_list_append_node(l, ident_node);
+        } break;
+        case GR_13: { // <lista_id_mul> ::= "," <lista_id>
+            parser_stack_push_non_terminal(p, NT_ID_LIST, NULL);
+            parser_stack_push_token(p, C_TOKEN_COMMA, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_IDENT_LIST);
+        } break;
+        case GR_14: { // <lista_id_mul> ::= î
+            CY_ASSERT(p->cur_node->kind == AST_KIND_IDENT_LIST);
+
+            AstList *l = &p->cur_node->u.IDENT_LIST.list;
+            ast_list_shrink(l);
+        } break;
+        case GR_15: { // <cmd> ::= <cmd_atr>
+            parser_stack_push_non_terminal(p, NT_CMD_ASSIGN, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_STMT_LIST);
+
+            AstList *l = &p->cur_node->u.STMT_LIST.list;
+            new_node = AST_NODE_ALLOC(a, ASSIGN_STMT);
+            ast_list_append_node(l, new_node);
+        } break;
+        case GR_16: { // <cmd> ::= <cmd_entr>
+            parser_stack_push_non_terminal(p, NT_CMD_INPUT, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_STMT_LIST);
+
+            AstList *l = &p->cur_node->u.STMT_LIST.list;
+            new_node = AST_NODE_ALLOC(a, READ_STMT);
+            ast_list_append_node(l, new_node);
+        } break;
+         case GR_17: { // <cmd> ::= <cmd_saida>
+            parser_stack_push_non_terminal(p, NT_CMD_OUTPUT, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_STMT_LIST);
+
+            AstList *l = &p->cur_node->u.STMT_LIST.list;
+            new_node = AST_NODE_ALLOC(a, WRITE_STMT);
+            ast_list_append_node(l, new_node);
+        } break;
+        case GR_18: { // <cmd> ::= <cmd_rep>
+            parser_stack_push_non_terminal(p, NT_CMD_LOOP, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_STMT_LIST);
+
+            AstList *l = &p->cur_node->u.STMT_LIST.list;
+            new_node = AST_NODE_ALLOC(a, REPEAT_STMT);
+            ast_list_append_node(l, new_node);
+        } break;
+        case GR_19: { // <cmd> ::= <cmd_sel>
+            parser_stack_push_non_terminal(p, NT_CMD_COND, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_STMT_LIST);
+
+            AstList *l = &p->cur_node->u.STMT_LIST.list;
+            new_node = AST_NODE_ALLOC(a, IF_STMT);
+            ast_list_append_node(l, new_node);
+        } break;
+        case GR_20: { // <cmd_atr> ::= <lista_id> "=" <expr>
+            parser_stack_push_non_terminal(p, NT_EXPR, NULL);
+            parser_stack_push_token(p, C_TOKEN_EQUALS, NULL);
+            parser_stack_push_non_terminal(p, NT_ID_LIST, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_ASSIGN_STMT);
+
+            AstNode **ident_list = &p->cur_node->u.ASSIGN_STMT.ident_list;
+            AST_LIST_CREATE(a, ident_list, new_node, IDENT_LIST);
+        } break;
+        case GR_21: { // <cmd_entr> ::= read "(" <lista_entr> ")"
+            parser_stack_push_token(p, C_TOKEN_PAREN_CLOSE, NULL);
+            parser_stack_push_non_terminal(p, NT_INPUT_LIST, NULL);
+            parser_stack_push_token(p, C_TOKEN_PAREN_OPEN, NULL);
+            parser_stack_push_token(p, C_TOKEN_READ, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_READ_STMT);
+
+            AstNode **input_list = &(p->cur_node->u.READ_STMT.input_list);
+            AST_LIST_CREATE(a, input_list, new_node, INPUT_LIST);
+        } break;
+        case GR_22: { // <lista_entr> ::= <cte_str_opt> id <lista_entr_mul>
+            parser_stack_push_non_terminal(p, NT_INPUT_LIST_R, NULL);
+            parser_stack_push_token(p, C_TOKEN_IDENT, NULL);
+            parser_stack_push_non_terminal(p, NT_STRING_OPT, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_INPUT_LIST);
+
+            new_node = AST_NODE_ALLOC(a, INPUT_ARG);
+            new_node->u.INPUT_ARG.ident = AST_NODE_ALLOC(a, IDENT);
+
+            AstList *l = &p->cur_node->u.INPUT_LIST.list;
+            ast_list_append_node(l, new_node);
+        } break;
+        case GR_23: { // <lista_entr_mul> ::= "," <lista_entr>
+            parser_stack_push_non_terminal(p, NT_INPUT_LIST, NULL);
+            parser_stack_push_token(p, C_TOKEN_COMMA, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_INPUT_LIST);
+        } break;
+        case GR_24: { // <lista_entr_mul> ::= î
+            CY_ASSERT(p->cur_node->kind == AST_KIND_INPUT_LIST);
+
+            AstList *l = &p->cur_node->u.INPUT_LIST.list;
+            ast_list_shrink(l);
+        } break;
+        case GR_25: { // <cte_str_opt> ::= constante_string ","
+            parser_stack_push_token(p, C_TOKEN_COMMA, NULL);
+            parser_stack_push_token(p, C_TOKEN_STRING, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_INPUT_ARG);
+
+            new_node = AST_NODE_ALLOC(a, INPUT_PROMPT);
+            p->cur_node->u.INPUT_ARG.prompt = new_node;
+        } break;
+        case GR_26: { // <cte_str_opt> ::= î
+            CY_ASSERT(p->cur_node->kind == AST_KIND_INPUT_ARG);
+        } break;
+        case GR_27: { // <cmd_saida> ::= <cmd_saida_tipo> "(" <lista_expr> ")"
+            parser_stack_push_token(p, C_TOKEN_PAREN_CLOSE, NULL);
+            parser_stack_push_non_terminal(p, NT_EXPR_LIST, NULL);
+            parser_stack_push_token(p, C_TOKEN_PAREN_OPEN, NULL);
+            parser_stack_push_non_terminal(p, NT_CMD_OUTPUT_KEYWORD, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_WRITE_STMT);
+        } break;
+        case GR_28: { // <cmd_saida_tipo> ::= write
+            parser_stack_push_token(p, C_TOKEN_WRITE, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_WRITE_STMT);
+        } break;
+        case GR_29: { // <cmd_saida_tipo> ::= writeln
+            parser_stack_push_token(p, C_TOKEN_WRITELN, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_WRITE_STMT);
+        } break;
+        case GR_30: { // <lista_expr> ::= <expr> <lista_expr_mul>
+            parser_stack_push_non_terminal(p, NT_EXPR_LIST_R, NULL);
+            parser_stack_push_non_terminal(p, NT_EXPR, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_WRITE_STMT);
+
+            AstNode **expr_list = &p->cur_node->u.WRITE_STMT.expr_list;
+            AST_LIST_CREATE(a, expr_list, new_node, EXPR_LIST);
+        } break;
+        case GR_31: { // <lista_expr_mul> ::= "," <lista_expr>
+            parser_stack_push_non_terminal(p, NT_EXPR_LIST, NULL);
+            parser_stack_push_token(p, C_TOKEN_COMMA, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_WRITE_STMT);
+        } break;
+        case GR_32: { // <lista_expr_mul> ::= î
+            CY_ASSERT(p->cur_node->kind == AST_KIND_WRITE_STMT);
+
+            AstList *l = &p->cur_node->u.WRITE_STMT.expr_list->u.EXPR_LIST.list;
+            ast_list_shrink(l);
+        } break;
+        case GR_33: { // <cmd_sel> ::= if <expr> <lista_cmd> <elif> <else> end
+            parser_stack_push_token(p, C_TOKEN_END, NULL);
+            parser_stack_push_non_terminal(p, NT_ELSE, NULL);
+            parser_stack_push_non_terminal(p, NT_ELIF, NULL);
+            parser_stack_push_non_terminal(p, NT_CMD_LIST, NULL);
+            parser_stack_push_non_terminal(p, NT_EXPR, NULL);
+            parser_stack_push_token(p, C_TOKEN_IF, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_IF_STMT);
+
+            p->cur_node->u.IF_STMT.is_root = true;
+        } break;
+        case GR_34: { // <elif> ::= elif <expr> <lista_cmd> <elif>
+            new_node = AST_NODE_ALLOC(a, IF_STMT);
+
+            parser_stack_push_non_terminal(p, NT_ELIF, new_node);
+            parser_stack_push_non_terminal(p, NT_CMD_LIST, new_node);
+            parser_stack_push_non_terminal(p, NT_EXPR, new_node);
+            parser_stack_push_token(p, C_TOKEN_ELIF, new_node);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_IF_STMT);
+
+            AstNode *else_stmt = p->cur_node->u.IF_STMT.else_stmt;
+            while (else_stmt != NULL) {
+                p->cur_node = else_stmt;
+                else_stmt = p->cur_node->u.IF_STMT.else_stmt;
+            }
+
+            p->cur_node->u.IF_STMT.else_stmt = new_node;
+        } break;
+        case GR_35: { // <elif> ::= î
+            CY_ASSERT(p->cur_node->kind == AST_KIND_IF_STMT);
+        } break;
+        case GR_36: { // <else> ::= else <lista_cmd>
+            new_node = AST_NODE_ALLOC(a, IF_STMT);
+
+            parser_stack_push_non_terminal(p, NT_CMD_LIST, new_node);
+            parser_stack_push_token(p, C_TOKEN_ELSE, new_node);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_IF_STMT);
+
+            AstNode *else_stmt = p->cur_node->u.IF_STMT.else_stmt;
+            while (else_stmt != NULL) {
+                p->cur_node = else_stmt;
+                else_stmt = p->cur_node->u.IF_STMT.else_stmt;
+            }
+
+            p->cur_node->u.IF_STMT.else_stmt = new_node;
+        } break;
+        case GR_37: { // <else> ::= î
+            CY_ASSERT(p->cur_node->kind == AST_KIND_IF_STMT);
+        } break;
+        case GR_38: { // <lista_cmd> ::= <cmd> ";" <lista_cmd_mul>
+            parser_stack_push_non_terminal(p, NT_CMD_LIST_R, NULL);
+            parser_stack_push_token(p, C_TOKEN_SEMICOLON, NULL);
+            parser_stack_push_non_terminal(p, NT_CMD, NULL);
+
+            CY_ASSERT(
+                p->cur_node->kind == AST_KIND_IF_STMT ||
+                p->cur_node->kind == AST_KIND_REPEAT_STMT
+            );
+
+            AstNode **body = &p->cur_node->u.IF_STMT.body;
+            AST_LIST_CREATE(a, body, new_node, STMT_LIST);
+        } break;
+        case GR_39: { // <lista_cmd_mul> ::= <lista_cmd>
+            parser_stack_push_non_terminal(p, NT_CMD_LIST, NULL);
+
+            CY_ASSERT(
+                p->cur_node->kind == AST_KIND_IF_STMT ||
+                p->cur_node->kind == AST_KIND_REPEAT_STMT
+            );
+        } break;
+        case GR_40: { // <lista_cmd_mul> ::= î
+            CY_ASSERT(
+                p->cur_node->kind == AST_KIND_IF_STMT ||
+                p->cur_node->kind == AST_KIND_REPEAT_STMT
+            );
+
+            AstList *l = &p->cur_node->u.IF_STMT.body->u.STMT_LIST.list;
+            ast_list_shrink(l);
+        } break;
+        case GR_41: { // <cmd_rep> ::= repeat <lista_cmd> <cmd_rep_tipo> <expr>
+            parser_stack_push_non_terminal(p, NT_EXPR, NULL);
+            parser_stack_push_non_terminal(p, NT_CMD_LOOP_KEYWORD, NULL);
+            parser_stack_push_non_terminal(p, NT_CMD_LIST, NULL);
+            parser_stack_push_token(p, C_TOKEN_REPEAT, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_REPEAT_STMT);
+        } break;
+        case GR_42: { // <cmd_rep_tipo> ::= while
+            parser_stack_push_token(p, C_TOKEN_WHILE, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_REPEAT_STMT);
+        } break;
+        case GR_43: { // <cmd_rep_tipo> ::= until
+            parser_stack_push_token(p, C_TOKEN_UNTIL, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_REPEAT_STMT);
+        } break;
+        case GR_44: { // <expr> ::= <elemento> <expr_log>
+            new_node = AST_NODE_ALLOC(a, BINARY_EXPR);
+
+            parser_stack_push_non_terminal(p, NT_EXPR_LOG, new_node);
+            parser_stack_push_non_terminal(p, NT_ELEMENT, new_node);
+
+            ast_node_set_expr(p->cur_node, new_node);
+        } break;
+        case GR_45: { // <expr_log> ::= "&&" <elemento> <expr_log>
+            new_node = AST_NODE_ALLOC(a, BINARY_EXPR);
+
+            parser_stack_push_non_terminal(p, NT_EXPR_LOG, new_node);
+            parser_stack_push_non_terminal(p, NT_ELEMENT, new_node);
+            parser_stack_push_token(p, C_TOKEN_AND, new_node);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
+
+            p->cur_node->u.BINARY_EXPR.op = p->read_tok;
+            ast_expr_insert_node(p->cur_node, new_node);
+        } break;
+        case GR_46: { // <expr_log> ::= "||" <elemento> <expr_log>
+            new_node = AST_NODE_ALLOC(a, BINARY_EXPR);
+
+            parser_stack_push_non_terminal(p, NT_EXPR_LOG, new_node);
+            parser_stack_push_non_terminal(p, NT_ELEMENT, new_node);
+            parser_stack_push_token(p, C_TOKEN_OR, new_node);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
+
+            p->cur_node->u.BINARY_EXPR.op = p->read_tok;
+            ast_expr_insert_node(p->cur_node, new_node);
+        } break;
+        case GR_47: { // <expr_log> ::= î
+            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
+
+            ast_binary_expr_reduce(a, p->cur_node);
+        } break;
+        case GR_48: { // <elemento> ::= <relacional>
+            parser_stack_push_non_terminal(p, NT_RELATIONAL, NULL);
+
+            CY_ASSERT(AST_KIND_IS_OF_CLASS(p->cur_node->kind, EXPR));
+        } break;
+        case GR_49: { // <elemento> ::= true
+            parser_stack_push_token(p, C_TOKEN_TRUE, NULL);
+
+            CY_ASSERT(AST_KIND_IS_OF_CLASS(p->cur_node->kind, EXPR));
+
+            new_node = AST_NODE_ALLOC(a, LITERAL);
+            ast_expr_insert_node(p->cur_node, new_node);
+        } break;
+        case GR_50: { // <elemento> ::= false
+            parser_stack_push_token(p, C_TOKEN_FALSE, NULL);
+
+            CY_ASSERT(AST_KIND_IS_OF_CLASS(p->cur_node->kind, EXPR));
+
+            new_node = AST_NODE_ALLOC(a, LITERAL);
+            ast_expr_insert_node(p->cur_node, new_node);
+        } break;
+        case GR_51: { // <elemento> ::= "!" <elemento>
+            new_node = AST_NODE_ALLOC(a, UNARY_EXPR);
+            parser_stack_push_non_terminal(p, NT_ELEMENT, new_node);
+            parser_stack_push_token(p, C_TOKEN_NOT, new_node);
+
+            CY_ASSERT(AST_KIND_IS_OF_CLASS(p->cur_node->kind, EXPR));
+
+            ast_expr_insert_node(p->cur_node, new_node);
+        } break;
+        case GR_52: { // <relacional> ::= <aritmetica> <relacional_mul>
+            new_node = AST_NODE_ALLOC(a, BINARY_EXPR);
+
+            parser_stack_push_non_terminal(p, NT_RELATIONAL_R, new_node);
+            parser_stack_push_non_terminal(p, NT_ARITHMETIC, new_node);
+
+            CY_ASSERT(AST_KIND_IS_OF_CLASS(p->cur_node->kind, EXPR));
+
+            ast_expr_insert_node(p->cur_node, new_node);
+        } break;
+        case GR_53: { // <relacional_mul> ::= <operador_relacional> <aritmetica>
+            parser_stack_push_non_terminal(p, NT_ARITHMETIC, NULL);
+            parser_stack_push_non_terminal(p, NT_RELATIONAL_OP, NULL);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
+        } break;
+        case GR_54: { // <relacional_mul> ::= î
+            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
+
+            ast_binary_expr_reduce(a, p->cur_node);
+        } break;
+        case GR_55: { // <operador_relacional> ::= "=="
+            parser_stack_push_token(p, C_TOKEN_CMP_EQ, NULL);
+
+            p->cur_node->u.BINARY_EXPR.op = p->read_tok;
+            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
+        } break;
+        case GR_56: { // <operador_relacional> ::= "!="
+            parser_stack_push_token(p, C_TOKEN_CMP_NE, NULL);
+
+            p->cur_node->u.BINARY_EXPR.op = p->read_tok;
+            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
+        } break;
+        case GR_57: { // <operador_relacional> ::= "<"
+            parser_stack_push_token(p, C_TOKEN_CMP_LT, NULL);
+
+            p->cur_node->u.BINARY_EXPR.op = p->read_tok;
+            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
+        } break;
+        case GR_58: { // <operador_relacional> ::= ">"
+            parser_stack_push_token(p, C_TOKEN_CMP_GT, NULL);
+
+            p->cur_node->u.BINARY_EXPR.op = p->read_tok;
+            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
+        } break;
+        case GR_59: { // <aritmetica> ::= <termo> <aritmetica_mul>
+            new_node = AST_NODE_ALLOC(a, BINARY_EXPR);
+
+            parser_stack_push_non_terminal(p, NT_ARITHMETIC_R, new_node);
+            parser_stack_push_non_terminal(p, NT_TERM, new_node);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
+
+            ast_expr_insert_node(p->cur_node, new_node);
+        } break;
+        case GR_60: { // <aritmetica_mul> ::= "+" <termo> <aritmetica_mul>
+            new_node = AST_NODE_ALLOC(a, BINARY_EXPR);
+
+            parser_stack_push_non_terminal(p, NT_ARITHMETIC_R, new_node);
+            parser_stack_push_non_terminal(p, NT_TERM, new_node);
+            parser_stack_push_token(p, C_TOKEN_ADD, new_node);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
+
+            p->cur_node->u.BINARY_EXPR.op = p->read_tok;
+            ast_expr_insert_node(p->cur_node, new_node);
+        } break;
+        case GR_61: { // <aritmetica_mul> ::= "-" <termo> <aritmetica_mul>
+            new_node = AST_NODE_ALLOC(a, BINARY_EXPR);
+
+            parser_stack_push_non_terminal(p, NT_ARITHMETIC_R, new_node);
+            parser_stack_push_non_terminal(p, NT_TERM, new_node);
+            parser_stack_push_token(p, C_TOKEN_SUB, new_node);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
+
+            p->cur_node->u.BINARY_EXPR.op = p->read_tok;
+            ast_expr_insert_node(p->cur_node, new_node);
+        } break;
+        case GR_62: { // <aritmetica_mul> ::= î
+            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
+
+            ast_binary_expr_reduce(a, p->cur_node);
+        } break;
+        case GR_63: { // <termo> ::= <fator> <termo_mul>
+            new_node = AST_NODE_ALLOC(a, BINARY_EXPR);
+
+            parser_stack_push_non_terminal(p, NT_TERM_R, new_node);
+            parser_stack_push_non_terminal(p, NT_FACTOR, new_node);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
+
+            ast_expr_insert_node(p->cur_node, new_node);
+        } break;
+        case GR_64: { // <termo_mul> ::= "*" <fator> <termo_mul>
+            new_node = AST_NODE_ALLOC(a, BINARY_EXPR);
+
+            parser_stack_push_non_terminal(p, NT_TERM_R, new_node);
+            parser_stack_push_non_terminal(p, NT_FACTOR, new_node);
+            parser_stack_push_token(p, C_TOKEN_MUL, new_node);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
+
+            p->cur_node->u.BINARY_EXPR.op = p->read_tok;
+            ast_expr_insert_node(p->cur_node, new_node);
+        } break;
+        case GR_65: { // <termo_mul> ::= "/" <fator> <termo_mul>
+            new_node = AST_NODE_ALLOC(a, BINARY_EXPR);
+
+            parser_stack_push_non_terminal(p, NT_TERM_R, new_node);
+            parser_stack_push_non_terminal(p, NT_FACTOR, new_node);
+            parser_stack_push_token(p, C_TOKEN_DIV, new_node);
+
+            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
+
+            p->cur_node->u.BINARY_EXPR.op = p->read_tok;
+            ast_expr_insert_node(p->cur_node, new_node);
+        } break;
+        case GR_66: { // <termo_mul> ::= î
+            CY_ASSERT(p->cur_node->kind == AST_KIND_BINARY_EXPR);
+
+            ast_binary_expr_reduce(a, p->cur_node);
+        } break;
+        case GR_67: { // <fator> ::= identificador
+            parser_stack_push_token(p, C_TOKEN_IDENT, NULL);
+
+            CY_ASSERT(AST_KIND_IS_OF_CLASS(p->cur_node->kind, EXPR));
+
+            new_node = AST_NODE_ALLOC(a, IDENT);
+            ast_expr_insert_node(p->cur_node, new_node);
+        } break;
+        case GR_68: { // <fator> ::= constante_int
+            parser_stack_push_token(p, C_TOKEN_INTEGER, NULL);
+
+            CY_ASSERT(AST_KIND_IS_OF_CLASS(p->cur_node->kind, EXPR));
+
+            new_node = AST_NODE_ALLOC(a, LITERAL);
+            ast_expr_insert_node(p->cur_node, new_node);
+        } break;
+        case GR_69: { // <fator> ::= constante_float
+            parser_stack_push_token(p, C_TOKEN_FLOAT, NULL);
+
+            CY_ASSERT(AST_KIND_IS_OF_CLASS(p->cur_node->kind, EXPR));
+
+            new_node = AST_NODE_ALLOC(a, LITERAL);
+            ast_expr_insert_node(p->cur_node, new_node);
+        } break;
+        case GR_70: { // <fator> ::= constante_string
+            parser_stack_push_token(p, C_TOKEN_STRING, NULL);
+
+            CY_ASSERT(AST_KIND_IS_OF_CLASS(p->cur_node->kind, EXPR));
+
+            new_node = AST_NODE_ALLOC(a, LITERAL);
+            ast_expr_insert_node(p->cur_node, new_node);
+        } break;
+        case GR_71: { // <fator> ::= "(" <expr> ")"
+            parser_stack_push_token(p, C_TOKEN_PAREN_CLOSE, NULL);
+            parser_stack_push_non_terminal(p, NT_EXPR, NULL);
+            parser_stack_push_token(p, C_TOKEN_PAREN_OPEN, NULL);
+
+            CY_ASSERT(AST_KIND_IS_OF_CLASS(p->cur_node->kind, EXPR));
+
+            new_node = AST_NODE_ALLOC(a, PAREN_EXPR);
+
+            ast_expr_insert_node(p->cur_node, new_node);
+        } break;
+        case GR_72: { // <fator> ::= "+" <fator>
+            parser_stack_push_non_terminal(p, NT_FACTOR, NULL);
+            parser_stack_push_token(p, C_TOKEN_ADD, NULL);
+
+            CY_ASSERT(AST_KIND_IS_OF_CLASS(p->cur_node->kind, EXPR));
+
+            new_node = AST_NODE_ALLOC(a, UNARY_EXPR);
+            ast_expr_insert_node(p->cur_node, new_node);
+        } break;
+        case GR_73: { // <fator> ::= "-" <fator>
+            parser_stack_push_non_terminal(p, NT_FACTOR, NULL);
+            parser_stack_push_token(p, C_TOKEN_SUB, NULL);
+
+            CY_ASSERT(AST_KIND_IS_OF_CLASS(p->cur_node->kind, EXPR));
+
+            new_node = AST_NODE_ALLOC(a, UNARY_EXPR);
+            ast_expr_insert_node(p->cur_node, new_node);
+        } break;
+        default: {
+        } break;
+        }
+
+        p->cur_node = new_node;
+    }
+
+    ParserErrorKind kind = p->err.kind;
+    if (p->recover &&
+        (kind == P_ERR_UNEXPECTED_TOKEN || kind == P_ERR_INVALID_RULE)) {
+        parser_recover(a, p);
+    }
+
+    return p->ast;
+}
+
+/* Checks the syntax only: the same automaton runs over the tokens, but with
+ * no AST (see parser_recognize), so nothing is allocated past the parser
+ * stack, unless there are errors to collect */
+static void parse_syntax_only(CyAllocator a, Parser *p)
+{
+    parser_recognize(p);
+
+    ParserErrorKind kind = p->err.kind;
+    if (p->recover &&
+        (kind == P_ERR_UNEXPECTED_TOKEN || kind == P_ERR_INVALID_RULE)) {
+        parser_recover(a, p);
+    }
+}
+
+/* ----------------------------- Checker ------------------------------------ */
+typedef enum {
+    C_ERR_NONE,
+    C_ERR_UNDECLARED_IDENT,
+    C_ERR_REDECLARED_IDENT,
+    C_ERR_INVALID_TYPE,
+} CheckerError;
+
+typedef struct {
+    CheckerError err;
+    Token tok;
+    Token op;
+} CheckerStatus;
+
+typedef struct {
+    const u8 *src;
+    AstList decl_idents;
+} Checker;
+
+static inline b32 is_declared(Checker *c, Token *ident)
+{
+    AstList *decl_idents = &c->decl_idents;
+    String tok = token_text(c->src, *ident);
+    for (isize i = 0; i < decl_idents->len; i++) {
+        Token *other_tok = &decl_idents->data[i]->u.IDENT.tok;
+        String other = token_text(c->src, *other_tok);
+        if (cy_string_view_are_equal(tok, other)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static inline CheckerStatus checker_error(CheckerError err, Token *tok)
+{
+    CheckerStatus status = { .err = err };
+    if (tok != NULL) {
+        status.tok = *tok;
+    }
+
+    return status;
+}
+
+static CheckerStatus check_expr(Checker *c, AstNode *expr)
+{
+    switch (expr->kind) {
+    case AST_KIND_BINARY_EXPR: {
+        CheckerStatus lhs = check_expr(c, expr->u.BINARY_EXPR.left);
+        if (lhs.err != C_ERR_NONE) {
+            return lhs;
+        }
+
+        CheckerStatus rhs = check_expr(c, expr->u.BINARY_EXPR.right);
+        if (rhs.err != C_ERR_NONE) {
+            return rhs;
+        }
+    } break;
+    case AST_KIND_UNARY_EXPR:
+    case AST_KIND_PAREN_EXPR: {
+        AstNode *sub = expr->u.UNARY_EXPR.expr;
+        if (AST_KIND_IS_OF_CLASS(sub->kind, EXPR)) {
+            return check_expr(c, sub);
+        } else switch (sub->kind) {
+        case AST_KIND_IDENT: {
+            return check_expr(c, sub);
+        } break;
+        default: break;
+        }
+    } break;
+    case AST_KIND_IDENT: {
+        Token *tok = &expr->u.IDENT.tok;
+        if (!is_declared(c, tok)) {
+            return checker_error(C_ERR_UNDECLARED_IDENT, tok);
+        }
+    } break;
+    default: break;
+    }
+
+    return checker_error(C_ERR_NONE, NULL);
+}
+
+static CheckerStatus check_stmt(Checker *c, AstNode *node)
+{
+    CheckerStatus status = {0};
+    switch (node->kind) {
+    case AST_KIND_VAR_DECL: {
+        AstList *idents = &node->u.VAR_DECL.ident_list->u.IDENT_LIST.list;
+        for (isize i = 0; i < idents->len; i++) {
+            AstNode *ident = idents->data[i];
+            Token *tok = &ident->u.IDENT.tok;
+            if (is_declared(c, tok)) {
+                return checker_error(C_ERR_REDECLARED_IDENT, tok);
+            }
+
+            ast_list_append_node(&c->decl_idents, ident);
+        }
+    } break;
+    case AST_KIND_ASSIGN_STMT: {
+        AstList *idents = &node->u.ASSIGN_STMT.ident_list->u.IDENT_LIST.list;
+        for (isize i = 0; i < idents->len; i++) {
+            AstNode *ident = idents->data[i];
+            Token *tok = &ident->u.IDENT.tok;
+            if (!is_declared(c, tok)) {
+                return checker_error(C_ERR_UNDECLARED_IDENT, tok);
+            }
+        }
+
+        return check_expr(c, node->u.ASSIGN_STMT.expr);
+    } break;
+    case AST_KIND_READ_STMT: {
+        AstList *inputs = &node->u.READ_STMT.input_list->u.INPUT_LIST.list;
+        for (isize i = 0; i < inputs->len; i++) {
+            Token *tok = &inputs->data[i]->u.INPUT_ARG.ident->u.IDENT.tok;
+            if (!is_declared(c, tok)) {
+                return checker_error(C_ERR_UNDECLARED_IDENT, tok);
+            }
+        }
+    } break;
+    case AST_KIND_WRITE_STMT: {
+        AstList *exprs = &node->u.WRITE_STMT.expr_list->u.EXPR_LIST.list;
+        for (isize i = 0; i < exprs->len; i++) {
+            AstNode *expr = exprs->data[i];
+            status = check_expr(c, expr);
+            if (status.err != C_ERR_NONE) {
+                return status;
+            }
+        }
+    } break;
+    case AST_KIND_IF_STMT: {
+        AstNode *cond = node->u.IF_STMT.cond;
+        if (cond != NULL) {
+            status = check_expr(c, cond);
+            if (status.err != C_ERR_NONE) {
+                return status;
+            }
+        }
+
+        AstList *stmts = &node->u.IF_STMT.body->u.STMT_LIST.list;
+        for (isize i = 0; i < stmts->len; i++) {
+            AstNode *stmt = stmts->data[i];
+            status = check_stmt(c, stmt);
+            if (status.err != C_ERR_NONE) {
+                return status;
+            }
+        }
+
+        AstNode *else_stmt = node->u.IF_STMT.else_stmt;
+        if (else_stmt != NULL) {
+            status = check_stmt(c, else_stmt);
+        }
+    } break;
+    case AST_KIND_REPEAT_STMT: {
+        AstNode *expr = node->u.REPEAT_STMT.expr;
+        if (expr != NULL) {
+            status = check_expr(c, expr);
+            if (status.err != C_ERR_NONE) {
+                return status;
+            }
+        }
+
+        AstList *stmts = &node->u.REPEAT_STMT.body->u.STMT_LIST.list;
+        for (isize i = 0; i < stmts->len; i++) {
+            AstNode *stmt = stmts->data[i];
+            status = check_stmt(c, stmt);
+            if (status.err != C_ERR_NONE) {
+                return status;
+            }
+        }
+    } break;
+    default: break;
+    }
+
+    return status;
+}
+
+static CheckerStatus check(Ast *a)
+{
+    CheckerStatus status = {0};
+    Checker c = {
+        .src = a->src,
+        .decl_idents = ast_list_init(a->alloc),
+    };
+
+    AstList *stmts = &a->root->u.MAIN.body->u.STMT_LIST.list;
+    for (isize i = 0; i < stmts->len; i++) {
+        AstNode *stmt = stmts->data[i];
+        status = check_stmt(&c, stmt);
+        if (status.err != C_ERR_NONE) {
+            break;
+        }
+    }
+
+    return status;
+}
+
+static inline CyString checker_append_error_msg(
+    CyString msg, LineIndex *lines, CheckerStatus *s
+) {
+    String tok = token_text(lines->src, s->tok);
+    msg = append_error_prefix(msg, lines, s->tok);
+    msg = cy_string_append_fmt(msg, "%.*s ", STRING_ARG(tok));
+
+    switch (s->err) {
+    case C_ERR_UNDECLARED_IDENT: {
+        msg = cy_string_append_c(msg, "não declarado");
+    } break;
+    case C_ERR_REDECLARED_IDENT: {
+        msg = cy_string_append_c(msg, "já declarado");
+    } break;
+    case C_ERR_INVALID_TYPE: {
+    } break;
+    case C_ERR_NONE: {
+    } break;
+    }
+
+    return msg;
+}
+
+/* ------------------------------ Output sinks ------------------------------ */
+#define IL_SINK_CHUNK_SIZE 0x10000
+
+typedef struct {
+    IlSinkBackend backend;
+    CyAllocator alloc;
+    u8 *buf;
+    isize len;
+    isize cap;
+    isize total;
+    b32 failed;
+} IlSink;
+
+static IL_SINK_WRITE_PROC(il_sink_string_write)
+{
+    CyString str = *(CyString*)data;
+    isize available = cy_string_available_space(str);
+    if (available < len) {
+        // NOTE(cya): cy_string_reserve_space_for grows to the exact size,
+        // which turns a long run of appends quadratic
+        isize extra = CY_MAX(len, cy_string_cap(str));
+        str = cy_string_reserve_space_for(str, extra);
+        if (str == NULL) {
+            return false;
+        }
+    }
+
+    *(CyString*)data = cy_string_append_len(str, (const char*)buf, len);
+    return true;
+}
+
+static IL_SINK_WRITE_PROC(il_sink_file_write)
+{
+    FILE *file = data;
+    return fwrite(buf, 1, len, file) == (usize)len;
+}
+
+IlSinkBackend il_sink_backend_string(CyString *str)
+{
+    return (IlSinkBackend){
+        .proc = il_sink_string_write,
+        .data = str,
+    };
+}
+
+IlSinkBackend il_sink_backend_file(FILE *file)
+{
+    return (IlSinkBackend){
+        .proc = il_sink_file_write,
+        .data = file,
+    };
+}
+
+#if !defined(CY_OS_WINDOWS)
+static IL_SINK_WRITE_PROC(il_sink_fd_write)
+{
+    int fd = (int)(intptr_t)data;
+    while (len > 0) {
+        isize bytes_written = write(fd, buf, len);
+        if (bytes_written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return false;
+        }
+
+        buf += bytes_written, len -= bytes_written;
+    }
+
+    return true;
+}
+
+IlSinkBackend il_sink_backend_fd(int fd)
+{
+    return (IlSinkBackend){
+        .proc = il_sink_fd_write,
+        .data = (void*)(intptr_t)fd,
+    };
+}
+#endif
+
+static inline IlSink il_sink_init(CyAllocator a, IlSinkBackend backend)
+{
+    isize cap = IL_SINK_CHUNK_SIZE;
+    u8 *buf = cy_alloc(a, cap);
+    return (IlSink){
+        .backend = backend,
+        .alloc = a,
+        .buf = buf,
+        .cap = buf != NULL ? cap : 0,
+        .failed = buf == NULL,
+    };
+}
+
+static void il_sink_flush(IlSink *s)
+{
+    if (s->len > 0 && !s->failed) {
+        s->failed = !s->backend.proc(s->backend.data, s->buf, s->len);
+    }
+
+    s->len = 0;
+}
+
+static inline void il_sink_write(IlSink *s, const void *data, isize len)
+{
+    if (len > s->cap - s->len) {
+        il_sink_flush(s);
+        if (len > s->cap) {
+            // NOTE(cya): too big to buffer, so hand it over as is
+            if (!s->failed) {
+                s->failed = !s->backend.proc(s->backend.data, data, len);
+            }
+
+            s->total += len;
+            return;
+        }
+    }
+
+    cy_mem_copy(s->buf + s->len, data, len);
+    s->len += len;
+    s->total += len;
+}
+
+static inline void il_sink_write_c(IlSink *s, const char *str)
+{
+    il_sink_write(s, str, strlen(str));
+}
+
+// NOTE(cya): decimal, zero-padded to at least min_digits
+static inline void il_sink_write_int(IlSink *s, isize val, isize min_digits)
+{
+    char buf[0x20];
+    char *end = buf + sizeof(buf), *p = end;
+    u64 mag = val < 0 ? -(u64)val : (u64)val;
+    do {
+        *--p = '0' + (char)(mag % 10);
+        mag /= 10;
+    } while (mag != 0 || end - p < min_digits);
+
+    if (val < 0) {
+        *--p = '-';
+    }
+
+    il_sink_write(s, p, end - p);
+}
+
+// NOTE(cya): flushes whatever is left; returns false if any write failed
+static b32 il_sink_deinit(IlSink *s)
+{
+    il_sink_flush(s);
+    cy_free(s->alloc, s->buf);
+
+    return !s->failed;
+}
+
+/* ------------------------- Code Generator (MSIL) -------------------------- */
+typedef struct {
+    CyAllocator alloc;
+    isize *items;
+    isize len;
+    isize cap;
+} LabelStack;
+
+typedef struct {
+    CyAllocator alloc;
+    Ast *ast;
+    IlSink *out;
+    LabelStack end_labels;
+    isize cur_label;
+} IlGenerator;
+
+static inline isize label_stack_peek(IlGenerator *g)
+{
+    return (g->end_labels.len > 0) ?
+        g->end_labels.items[g->end_labels.len - 1] : 0;
+}
+
+static inline isize label_stack_push(IlGenerator *g)
+{
+    if (g->end_labels.len == g->end_labels.cap) {
+        isize old_size = g->end_labels.cap * sizeof(*g->end_labels.items);
+        isize new_size = old_size * 2;
+        isize *items = cy_resize(
+            g->end_labels.alloc, g->end_labels.items,
+            old_size, new_size
+        );
+        if (items == NULL) {
+            return -1;
+        }
+
+        g->end_labels.items = items;
+        g->end_labels.cap *= 2;
+    }
+
+     isize item = ++g->cur_label;
+     g->end_labels.items[g->end_labels.len++] = item;
+     return item;
+}
+
+static inline isize label_stack_pop(IlGenerator *g)
+{
+    if (g->end_labels.len <= 0) {
+        return -1;
+    }
+
+    isize *top = &g->end_labels.items[--g->end_labels.len];
+    isize ret = *top;
+
+    cy_mem_set(top, 0, sizeof(*top));
+    return ret;
+}
+
+static inline IlGenerator il_generator_init(
+    CyAllocator a, CyAllocator stack_allocator, Ast *ast, IlSink *out
+) {
+    isize cap = 0x10;
+    isize *items = cy_alloc_array(stack_allocator, isize, cap);
+    return (IlGenerator){
+        .alloc = a,
+        .ast = ast,
+        .out = out,
+        .end_labels = (LabelStack){
+            .alloc = stack_allocator,
+            .items = items,
+            .cap = cap,
+        },
+    };
+}
+
+/* Typed emitters: every instruction is "\t\t<op>[ <operand>]\r\n", so the
+ * pieces are copied straight into the output chunk instead of going through
+ * printf-style formatting */
+static inline void il_emit_begin(IlGenerator *g, const char *op)
+{
+    il_sink_write(g->out, "\t\t", 2);
+    il_sink_write_c(g->out, op);
+}
+
+static inline void il_emit_end(IlGenerator *g)
+{
+    il_sink_write(g->out, "\r\n", 2);
+}
+
+static inline void il_emit_op(IlGenerator *g, const char *op)
+{
+    il_emit_begin(g, op);
+    il_emit_end(g);
+}
+
+static inline void il_emit_op_str(IlGenerator *g, const char *op, String s)
+{
+    il_emit_begin(g, op);
+    il_sink_write(g->out, " ", 1);
+    il_sink_write(g->out, s.text, s.len);
+    il_emit_end(g);
+}
+
+static inline void il_emit_op_local(IlGenerator *g, const char *op, String name)
+{
+    il_emit_op_str(g, op, name);
+}
+
+static inline void il_emit_op_int(IlGenerator *g, const char *op, isize val)
+{
+    il_emit_begin(g, op);
+    il_sink_write(g->out, " ", 1);
+    il_sink_write_int(g->out, val, 1);
+    il_emit_end(g);
+}
+
+static inline void il_emit_op_i4(IlGenerator *g, i32 val)
+{
+    il_emit_op_int(g, "ldc.i4", val);
+}
+
+static inline void il_emit_op_i8(IlGenerator *g, isize val)
+{
+    il_emit_op_int(g, "ldc.i8", val);
+}
+
+// NOTE(cya): labels are zero-padded to two digits (IL_01, ..., IL_100)
+static inline void il_emit_branch(IlGenerator *g, const char *op, isize label)
+{
+    il_emit_begin(g, op);
+    il_sink_write(g->out, " IL_", 4);
+    il_sink_write_int(g->out, label, 2);
+    il_emit_end(g);
+}
+
+static inline void il_emit_label(IlGenerator *g, isize label)
+{
+    il_sink_write(g->out, "IL_", 3);
+    il_sink_write_int(g->out, label, 2);
+    il_sink_write(g->out, ":\r\n", 3);
+}
+
+static inline void il_generator_append_ldstr(IlGenerator *g, String s);
+
+static inline void il_generator_append_expr(IlGenerator *g, AstNode *expr)
+{
+    AstKind expr_kind = expr->kind;
+    switch (expr_kind) {
+    case AST_KIND_BINARY_EXPR: {
+        il_generator_append_expr(g, expr->u.BINARY_EXPR.left);
+        il_generator_append_expr(g, expr->u.BINARY_EXPR.right);
+
+        const char *instr = NULL;
+        Token op = expr->u.BINARY_EXPR.op;
+        switch (op.kind) {
+        case C_TOKEN_ADD: {
+            instr = "add";
+        } break;
+        case C_TOKEN_SUB: {
+            instr = "sub";
+        } break;
+        case C_TOKEN_MUL: {
+            instr = "mul";
+        } break;
+        case C_TOKEN_DIV: {
+            instr = "div";
+        } break;
+        case C_TOKEN_CMP_EQ:
+        case C_TOKEN_CMP_NE: {
+            instr = "ceq";
+        } break;
+        case C_TOKEN_CMP_GT: {
+            instr = "cgt";
+        } break;
+        case C_TOKEN_CMP_LT: {
+            instr = "clt";
+        } break;
+        case C_TOKEN_AND: {
+            instr = "and";
+        } break;
+        case C_TOKEN_OR: {
+            instr = "or";
+        } break;
+        default: break;
+        }
+
+        il_emit_op(g, instr);
+        if (op.kind == C_TOKEN_CMP_NE) {
+            il_emit_op_i4(g, 1);
+            il_emit_op(g, "xor");
+        }
+    } break;
+    case AST_KIND_UNARY_EXPR: {
+        il_generator_append_expr(g, expr->u.UNARY_EXPR.expr);
+
+        Token op = expr->u.UNARY_EXPR.op;
+        if (op.kind == C_TOKEN_NOT) {
+            il_emit_op_i4(g, 1);
+            il_emit_op(g, "xor");
+        } else if (op.kind == C_TOKEN_SUB) {
+            il_emit_op_str(g, "ldc.r8", cy_string_view_create_c("-1.0"));
+            il_emit_op(g, "mul");
+        }
+    } break;
+    case AST_KIND_PAREN_EXPR: {
+        il_generator_append_expr(g, expr->u.PAREN_EXPR.expr);
+    } break;
+    case AST_KIND_IDENT: {
+        String name = token_text(g->ast->src, expr->u.IDENT.tok);
+        il_emit_op_local(g, "ldloc", name);
+        if (expr->u.IDENT.kind == AST_ENT_INT) {
+            il_emit_op(g, "conv.r8");
+        }
+    } break;
+    case AST_KIND_LITERAL: {
+        AstEntityKind kind = expr->u.LITERAL.val.kind;
+        if (kind== AST_ENT_STRING) {
+            String s = expr->u.LITERAL.val.u.s;
+            il_generator_append_ldstr(g, s);
+        } else {
+            switch (kind) {
+            case AST_ENT_INT: {
+                il_emit_op_i8(g, expr->u.LITERAL.val.u.i);
+                il_emit_op(g, "conv.r8");
+            } break;
+            case AST_ENT_FLOAT: {
+                // NOTE(cya): the only operand that still needs printf, since
+                // it has to round the same way the source was written
+                char buf[0x100];
+                f64 val = expr->u.LITERAL.val.u.f.val;
+                isize precision = expr->u.LITERAL.val.u.f.precision;
+                int len = snprintf(
+                    buf, sizeof(buf), "%.*lf", (int)precision, val
+                );
+                len = CY_MIN(len, (int)sizeof(buf) - 1);
+                String str = cy_string_view_create_len(buf, len);
+                il_emit_op_str(g, "ldc.r8", str);
+            } break;
+            case AST_ENT_BOOL: {
+                il_emit_op_i4(g, expr->u.LITERAL.val.u.b);
+            } break;
+            default: break;
+            }
+        }
+    } break;
+    default: break;
+    }
+}
+
+static inline const char *il_keyword_from_entity_kind(AstEntityKind kind)
+{
+    const char *keyword = NULL;
+    switch (kind) {
+    case AST_ENT_INT: {
+        keyword = "int64";
+    } break;
+    case AST_ENT_FLOAT: {
+        keyword = "float64";
+    } break;
+    case AST_ENT_BOOL: {
+        keyword = "bool";
+    } break;
+    case AST_ENT_STRING: {
+        keyword = "string";
+    } break;
+    }
+
+    return keyword;
+}
+
+static inline const char *il_class_from_entity_kind(AstEntityKind kind)
+{
+    const char *keyword = NULL;
+    switch (kind) {
+    case AST_ENT_INT: {
+        keyword = "Int64";
+    } break;
+    case AST_ENT_FLOAT: {
+        keyword = "Double";
+    } break;
+    case AST_ENT_BOOL: {
+        keyword = "Bool";
+    } break;
+    case AST_ENT_STRING: {
+        keyword = "string";
+    } break;
+    }
+
+    return keyword;
+}
+
+static inline void il_generator_append_ldstr(IlGenerator *g, String s)
+{
+    CyAllocator a = g->alloc;
+    CyString str = cy_string_create_view(a, s);
+
+#ifdef CY_OS_WINDOWS
+    isize utf16_len = MultiByteToWideChar(
+        CP_UTF8, 0, str, cy_string_len(str), NULL, 0
+    );
+    CyString16 utf16 = cy_string_16_create_reserve(a, utf16_len);
+    MultiByteToWideChar(CP_UTF8, 0, str, cy_string_len(str), utf16, utf16_len);
+
+    UINT cp = GetConsoleOutputCP();
+    const char *def_char = IS_IN_RANGE_IN(cp, CP_UTF7, CP_UTF8) ? NULL : "?";
+
+    isize ansi_len = WideCharToMultiByte(
+        cp, 0, utf16, utf16_len, NULL, 0, def_char, NULL
+    );
+    CyString ansi = cy_string_create_reserve(a, ansi_len);
+    WideCharToMultiByte(
+        cp, 0, utf16, utf16_len, ansi, ansi_len, def_char, NULL
+    );
+    cy__string_set_len(ansi, ansi_len);
+
+    cy_string_free(str);
+    cy_string_16_free(utf16);
+    str = ansi;
+#endif
+
+    il_emit_op_str(g, "ldstr", cy_string_view_create(str));
+    cy_string_free(str);
+}
+
+static inline void il_generator_append_stmt(IlGenerator *g, AstNode *stmt)
+{
+    switch (stmt->kind) {
+    case AST_KIND_VAR_DECL: {
+        AstList *idents = &stmt->u.VAR_DECL.ident_list->u.IDENT_LIST.list;
+        for (isize i = 0; i < idents->len; i++) {
+            AstNode *ident = idents->data[i];
+            const char *kind = il_keyword_from_entity_kind(ident->u.IDENT.kind);
+
+            String name = token_text(g->ast->src, ident->u.IDENT.tok);
+            il_emit_begin(g, ".locals (");
+            il_sink_write_c(g->out, kind);
+            il_sink_write(g->out, " ", 1);
+            il_sink_write(g->out, name.text, name.len);
+            il_sink_write(g->out, ")", 1);
+            il_emit_end(g);
+        }
+    } break;
+    case AST_KIND_ASSIGN_STMT: {
+        AstNode *expr = stmt->u.ASSIGN_STMT.expr;
+        AstEntityKind expr_kind = ast_expr_determine_kind(expr);
+        il_generator_append_expr(g, expr);
+        if (expr_kind == AST_ENT_INT) {
+            il_emit_op(g, "conv.i8");
+        }
+
+        AstList *idents = &stmt->u.ASSIGN_STMT.ident_list->u.IDENT_LIST.list;
+        for (isize i = 0; i < idents->len - 1; i++) {
+            il_emit_op(g, "dup");
+        }
+
+        for (isize i = 0; i < idents->len; i++) {
+            AstNode *ident = idents->data[i];
+            String name = token_text(g->ast->src, ident->u.IDENT.tok);
+            il_emit_op_local(g, "stloc", name);
+        }
+    } break;
+    case AST_KIND_READ_STMT: {
+        AstList *args = &stmt->u.READ_STMT.input_list->u.INPUT_LIST.list;
+        for (isize i = 0; i < args->len; i++) {
+            AstNode *arg = args->data[i];
+            if (arg->u.INPUT_ARG.prompt != NULL) {
+                Token prompt = arg->u.INPUT_ARG.prompt->u.INPUT_PROMPT.string;
+                String s = token_text(g->ast->src, prompt);
+                il_generator_append_ldstr(g, s);
+                il_emit_op(
+                    g, "call void [mscorlib]System.Console::Write(string)"
+                );
+            }
+
+            Token ident_tok = arg->u.INPUT_ARG.ident->u.IDENT.tok;
+            String ident = token_text(g->ast->src, ident_tok);
+            AstEntityKind kind = arg->u.INPUT_ARG.ident->u.IDENT.kind;
+            il_emit_op(g, "call string [mscorlib]System.Console::ReadLine()");
+            if (kind != AST_ENT_STRING) {
+                const char *keyword = il_keyword_from_entity_kind(kind);
+                const char *class = il_class_from_entity_kind(kind);
+                il_emit_begin(g, "call ");
+                il_sink_write_c(g->out, keyword);
+                il_sink_write_c(g->out, " [mscorlib]System.");
+                il_sink_write_c(g->out, class);
+                il_sink_write_c(g->out, "::Parse(string)");
+                il_emit_end(g);
+            }
+
+            il_emit_op_local(g, "stloc", ident);
+        }
+    } break;
+    case AST_KIND_WRITE_STMT: {
+        b32 writeln = stmt->u.WRITE_STMT.keyword.kind == C_TOKEN_WRITELN;
+        AstList *exprs = &stmt->u.WRITE_STMT.expr_list->u.EXPR_LIST.list;
+        for (isize i = 0; i < exprs->len; i++) {
+            AstNode *expr = exprs->data[i];
+            AstEntityKind expr_kind = ast_expr_determine_kind(expr);
+            il_generator_append_expr(g, expr);
+
+            const char *kind = il_keyword_from_entity_kind(expr_kind);
+            if (expr_kind == AST_ENT_INT) {
+                il_emit_op(g, "conv.i8");
+            }
+
+            const char *keyword = writeln && i == exprs->len - 1 ?
+                "WriteLine" : "Write";
+            il_emit_begin(g, "call void [mscorlib]System.Console::");
+            il_sink_write_c(g->out, keyword);
+            il_sink_write(g->out, "(", 1);
+            il_sink_write_c(g->out, kind);
+            il_sink_write(g->out, ")", 1);
+            il_emit_end(g);
+        }
+    } break;
+    case AST_KIND_IF_STMT: {
+        b32 is_root = stmt->u.IF_STMT.is_root;
+
+        isize if_label = ++g->cur_label;
+        isize end_label = is_root ? label_stack_push(g) : label_stack_peek(g);
+
+        AstNode *else_stmt = stmt->u.IF_STMT.else_stmt;
+        isize else_label = else_stmt == NULL ? end_label : ++g->cur_label;
+
+        AstNode *cond = stmt->u.IF_STMT.cond;
+        if (cond != NULL) {
+            il_generator_append_expr(g, cond);
+            il_emit_branch(g, "brtrue", if_label);
+            il_emit_branch(g, "br", else_label);
+
+            il_emit_label(g, if_label);
+        }
+
+        AstList *stmts = &stmt->u.IF_STMT.body->u.STMT_LIST.list;
+        for (isize i = 0; i < stmts->len; i++) {
+            il_generator_append_stmt(g, stmts->data[i]);
+        }
+
+        il_emit_branch(g, "br", end_label);
+
+        if (else_stmt != NULL) {
+            il_emit_label(g, else_label);
+            il_generator_append_stmt(g, else_stmt);
+        }
+
+        if (is_root) {
+            il_emit_label(g, end_label);
+            label_stack_pop(g);
+        }
+    } break;
+    case AST_KIND_REPEAT_STMT: {
+        isize label = ++g->cur_label;
+        il_emit_label(g, label);
+
+        AstList *stmts = &stmt->u.REPEAT_STMT.body->u.STMT_LIST.list;
+        for (isize i = 0; i < stmts->len; i++) {
+            il_generator_append_stmt(g, stmts->data[i]);
+        }
+
+        AstNode *expr = stmt->u.REPEAT_STMT.expr;
+        il_generator_append_expr(g, expr);
+
+        const char *instr = stmt->u.REPEAT_STMT.keyword.kind == C_TOKEN_WHILE ?
+            "brtrue" : "brfalse";
+        il_emit_branch(g, instr, label);
+    } break;
+    default: break;
+    }
+}
+
+static void il_generate(IlGenerator *g)
+{
+    AstList *stmts = &g->ast->root->u.MAIN.body->u.STMT_LIST.list;
+    const char *header =
+        ".assembly extern mscorlib {}\r\n"
+        ".assembly _obj_code {}\r\n"
+        ".module _obj_code.exe\r\n"
+        ".class public Main {\r\n"
+        "\t.method public static void main() {\r\n"
+        "\t\t.entrypoint\r\n";
+    il_sink_write_c(g->out, header);
+
+    for (isize i = 0; i < stmts->len; i++) {
+        AstNode *stmt = stmts->data[i];
+        il_generator_append_stmt(g, stmt);
+    }
+
+    const char *footer =
+        "\t\tret\r\n"
+        "\t}\r\n"
+        "}\r\n";
+    il_sink_write_c(g->out, footer);
+}
+
+/* -------------------------- Compiler interface ---------------------------- */
+void compiler_output_free(CompilerOutput *output)
+{
+    cy_string_free(output->msg);
+    cy_string_free(output->code);
+    cy_file_map_close(&output->src);
+    cy_mem_zero(output, sizeof(*output));
+}
+
+static inline f64 compiler_stats_lap(CyTicks *lap)
+{
+    CyTicks now = cy_ticks_query();
+    CyTicks elapsed = cy_ticks_elapsed(*lap, now);
+    *lap = now;
+
+    return cy_ticks_to_time_unit(elapsed, CY_MICROSECONDS);
+}
+
+CompilerContext compiler_context_init(CyAllocator a)
+{
+    return (CompilerContext){
+        .alloc = a,
+        .arena = cy_arena_init(a, 0x4000),
+        .tokenize_threads = 1,
+    };
+}
+
+void compiler_context_deinit(CompilerContext *ctx)
+{
+    if (ctx->parser_stack.state.first_node != NULL) {
+        cy_stack_deinit(&ctx->parser_stack);
+    }
+
+    cy_arena_deinit(&ctx->arena);
+    cy_mem_zero(ctx, sizeof(*ctx));
+}
+
+// NOTE(cya): keeps the largest block of each allocator around for next time
+static void compiler_context_reset(CompilerContext *ctx)
+{
+    if (!ctx->dirty) {
+        return;
+    }
+
+    cy_free_all(cy_arena_allocator(&ctx->arena));
+    if (ctx->parser_stack.state.first_node != NULL) {
+        cy_free_all(cy_stack_allocator(&ctx->parser_stack));
+    }
+
+    ctx->dirty = false;
+}
+
+// NOTE(cya): a NULL sink means the IL is built into output.code
+static CompilerOutput compile_internal(
+    CompilerContext *ctx, String src_code, const IlSinkBackend *sink,
+    CompilerStats *stats
+) {
+    CyTicks start = cy_ticks_query(), lap = start;
+    if (stats != NULL) {
+        cy_mem_zero(stats, sizeof(*stats));
+        stats->src_bytes = src_code.len;
+    }
+
+    // NOTE(cya): the context is reset lazily, so one-off compilations don't
+    // pay for clearing memory that's about to be freed
+    compiler_context_reset(ctx);
+    ctx->dirty = true;
+
+    CyAllocator a = ctx->alloc;
+    CyArena *tokenizer_arena = &ctx->arena;
+    CyAllocator temp_allocator = cy_arena_allocator(tokenizer_arena);
+
+    Parser parser = {0};
+
+    CyString code = NULL;
+    b32 ok = false;
+    isize init_cap = 0x100;
+    CyString msg = cy_string_create_reserve(a, init_cap);
+    if (src_code.len > TOKEN_MAX_SRC_LEN) {
+        msg = cy_string_append_c(
+            msg, "código fonte muito grande (o limite é de 4 GB)"
+        );
+        goto cleanup;
+    }
+
+    Tokenizer tokenizer = tokenizer_init(src_code);
+    if (ctx->dfa_tokenizer) {
+        tokenizer.backend = TOKENIZER_BACKEND_DFA;
+    }
+
+    LineIndex lines = line_index_init(temp_allocator, src_code);
+
+    // NOTE(cya): the token count isn't known up front anymore, and the
+    // parser stack only gets as deep as the program's nesting, so it starts
+    // small and doubles when needed
+    isize stack_cap = PARSER_STACK_INIT_CAP;
+    CyStack *parser_stack = &ctx->parser_stack;
+    if (parser_stack->state.first_node == NULL) {
+        isize stack_size = stack_cap * PARSER_STACK_SLOT_SIZE;
+        *parser_stack = cy_stack_init(a, stack_size);
+    }
+
+    // NOTE(cya): large sources can be lexed on several threads first; the
+    // tokenizer is left where it'd be after the parser pulled every token
+    TokenList tokens = {0};
+    isize chunk_count = 0;
+    if (ctx->tokenize_threads > 1) {
+        chunk_count = tokenize_parallel(
+            temp_allocator, &tokenizer, ctx->tokenize_threads, &tokens
+        );
+    }
+
+    CyAllocator stack_allocator = cy_stack_allocator(parser_stack);
+    parser = parser_init(
+        stack_allocator, &tokenizer, chunk_count > 0 ? &tokens : NULL,
+        stack_cap
+    );
+    parser.recover = ctx->all_errors;
+
+    Ast ast = {0};
+    if (ctx->syntax_only) {
+        parse_syntax_only(temp_allocator, &parser);
+    } else {
+        // TODO(cya): use pool allocator when implemented
+        ast = parse(temp_allocator, &parser);
+    }
+    if (parser.err.kind != P_ERR_NONE && tokenizer.err == T_ERR_NONE) {
+        // NOTE(cya): lexical errors are reported first, even if they come
+        // after the syntax error
+        tokenizer_skip_to_end(&tokenizer);
+    }
+    if (stats != NULL) {
+        stats->parse_us = compiler_stats_lap(&lap);
+        stats->token_count = parser.token_count;
+        stats->parser_stack_max_depth = parser.stack.max_len;
+    }
+    if (tokenizer.err != T_ERR_NONE) {
+        // NOTE(cya): the errors after the first are found by lexing the
+        // source again, which only the compilations that fail pay for
+        LexDiagnostics diags = {0};
+        Tokenizer recovery = tokenizer_at(&tokenizer, 0);
+        b32 all_found = ctx->all_errors &&
+            tokenizer.err != T_ERR_OUT_OF_MEMORY &&
+            tokenize_recovering(temp_allocator, &recovery, NULL, &diags);
+        if (all_found) {
+            msg = lex_diagnostics_append_msg(
+                msg, &lines, recovery.start, &diags
+            );
+        } else {
+            msg = tokenizer_append_error_msg(msg, &lines, &tokenizer);
+        }
+
+        goto cleanup;
+    } else if (parser.errors.len > 0) {
+        msg = parser_errors_append_msg(msg, &lines, &parser);
+        goto cleanup;
+    } else if (parser.err.kind != P_ERR_NONE) {
+        msg = parser_append_error_msg(msg, &lines, &parser);
+        goto cleanup;
+    } else if (ctx->syntax_only) {
+        ok = true;
+        msg = cy_string_append_c(msg, "programa sintaticamente correto");
+        goto cleanup;
+    }
+
+    if (stats != NULL) {
+        stats->ast_node_count = ast_node_count(ast.root);
+        lap = cy_ticks_query();
+    }
+
+    CheckerStatus status = check(&ast);
+    if (stats != NULL) {
+        stats->check_us = compiler_stats_lap(&lap);
+    }
+    if (status.err != C_ERR_NONE) {
+        msg = checker_append_error_msg(msg, &lines, &status);
+        goto cleanup;
+    }
+
+    IlSinkBackend backend;
+    if (sink != NULL) {
+        backend = *sink;
+    } else {
+        code = cy_string_create_reserve(a, IL_SINK_CHUNK_SIZE);
+        backend = il_sink_backend_string(&code);
+    }
+
+    IlSink out = il_sink_init(a, backend);
+    IlGenerator generator = il_generator_init(
+        a, stack_allocator, &ast, &out
+    );
+    il_generate(&generator);
+    ok = il_sink_deinit(&out);
+    if (stats != NULL) {
+        stats->il_generate_us = compiler_stats_lap(&lap);
+        stats->il_bytes = out.total;
+    }
+    if (!ok) {
+        cy_string_free(code);
+        code = NULL;
+        msg = cy_string_append_c(msg, "erro ao escrever o código objeto");
+        goto cleanup;
+    }
+
+    msg = cy_string_append_c(msg, "programa compilado com sucesso");
+
+cleanup:
+    if (stats != NULL) {
+        stats->arena_bytes = cy_arena_size_used(tokenizer_arena);
+        CyTicks elapsed = cy_ticks_elapsed(start, cy_ticks_query());
+        stats->total_us = cy_ticks_to_time_unit(elapsed, CY_MICROSECONDS);
+    }
+
+    return (CompilerOutput){
+        .code = code,
+        .ok = ok,
+        .msg = cy_string_shrink(msg),
+    };
+}
+
+/* Debug builds tell how long a successful compilation took. The time is added
+ * apart from compile_internal, so the cache never stores it with a message */
+static inline void compiler_output_append_time(
+    CompilerOutput *output, CyTicks start
+) {
+#ifdef CY_DEBUG
+    if (output->ok) {
+        CyTicks elapsed = cy_ticks_elapsed(start, cy_ticks_query());
+        f64 elapsed_us = cy_ticks_to_time_unit(elapsed, CY_MICROSECONDS);
+        output->msg = cy_string_append_fmt(
+            output->msg, " em %.01fμs", elapsed_us
+        );
+    }
+#else
+    CY_UNUSED(output), CY_UNUSED(start);
+#endif
+}
+
+static CompilerOutput compile_timed(
+    CompilerContext *ctx, String src_code, const IlSinkBackend *sink,
+    CompilerStats *stats
+) {
+    CyTicks start = cy_ticks_query();
+    CompilerOutput output = compile_internal(ctx, src_code, sink, stats);
+    compiler_output_append_time(&output, start);
+
+    return output;
+}
+
+static CompilerOutput compile_once(
+    CyAllocator a, String src_code, const IlSinkBackend *sink,
+    CompilerStats *stats
+) {
+    CompilerContext ctx = compiler_context_init(a);
+    CompilerOutput output = compile_timed(&ctx, src_code, sink, stats);
+    compiler_context_deinit(&ctx);
+
+    return output;
+}
+
+CompilerOutput compile_with_context(
+    CompilerContext *ctx, String src_code, const IlSinkBackend *sink,
+    CompilerStats *stats
+) {
+    return compile_timed(ctx, src_code, sink, stats);
+}
+
+CompilerOutput compile_with_stats(
+    CyAllocator a, String src_code, CompilerStats *stats
+) {
+    return compile_once(a, src_code, NULL, stats);
+}
+
+CompilerOutput compile_to_sink(
+    CyAllocator a, String src_code, IlSinkBackend sink, CompilerStats *stats
+) {
+    return compile_once(a, src_code, &sink, stats);
+}
+
+CompilerOutput compile_file_map(
+    CyAllocator a, CyFileMap src, const IlSinkBackend *sink,
+    CompilerStats *stats
+) {
+    String src_code = {.text = src.data, .len = src.size};
+    CompilerOutput output = compile_once(a, src_code, sink, stats);
+    output.src = src;
+
+    return output;
+}
+
+CompilerOutput compile(CyAllocator a, String src_code)
+{
+    return compile_with_stats(a, src_code, NULL);
+}
+
+/* ------------------------------ Compile cache ----------------------------- */
+#if !defined(CY_OS_WINDOWS)
+#include <dirent.h>
+#include <sys/file.h>
+
+#define COMPILE_CACHE_INDEX_MAGIC 0x58444E49 // NOTE(cya): "INDX"
+#define COMPILE_CACHE_ENTRY_MAGIC 0x59525445 // NOTE(cya): "ETRY"
+#define COMPILE_CACHE_SLOTS 0x1000
+#define COMPILE_CACHE_MAX_ENTRIES (COMPILE_CACHE_SLOTS / 4 * 3)
+// NOTE(cya): entries are named after their key (32 hex digits) and get an
+// extension of their own, so the cache can live next to other files
+#define COMPILE_CACHE_ENTRY_EXT ".cache"
+#define COMPILE_CACHE_KEY_DIGITS 32
+
+typedef struct {
+    u64 hi;
+    u64 lo;
+} CacheKey;
+
+typedef struct {
+    CacheKey key;
+    u64 size;      // NOTE(cya): zero marks an empty slot
+    u64 last_used; // NOTE(cya): index clock at the last lookup/store
+} CacheSlot;
+
+// NOTE(cya): open addressing (linear probing) keyed by key.hi
+struct CompileCacheIndex {
+    u32 magic;
+    u32 slot_count;
+    u64 clock;
+    u64 hits;
+    u64 misses;
+    u64 evictions;
+    u64 entry_count;
+    u64 total_bytes;
+    CacheSlot slots[COMPILE_CACHE_SLOTS];
+};
+
+// NOTE(cya): entry files are this header followed by the IL and the message
+typedef struct {
+    u32 magic;
+    u32 ok;
+    CacheKey key;
+    u64 src_len;
+    u64 code_len;
+    u64 msg_len;
+} CacheEntryHeader;
+
+/* Bumped whenever the compiler's output changes for some source (the code it
+ * generates, or its messages), so the entries of older builds are left alone.
+ * Builds of the same tree share their entries */
+#define COMPILE_CACHE_OUTPUT_VERSION "2"
+
+static const char g_compiler_build_id[] =
+    COMPILER_VERSION " " COMPILE_CACHE_OUTPUT_VERSION;
+
+// NOTE(cya): the context's options that change the output
+static inline u64 cache_options_from_context(const CompilerContext *ctx)
+{
+    return (u64)(ctx->all_errors != 0) | (u64)(ctx->syntax_only != 0) << 1;
+}
+
+static inline CacheKey cache_key_from_src(String src, u64 options)
+{
+    u64 seed = cy_hash_64(
+        g_compiler_build_id, sizeof(g_compiler_build_id) - 1,
+        COMPILE_CACHE_ENTRY_MAGIC ^ options
+    );
+    return (CacheKey){
+        .hi = cy_hash_64(src.text, src.len, seed),
+        .lo = cy_hash_64(src.text, src.len, ~seed),
+    };
+}
+
+static inline b32 cache_key_are_equal(CacheKey a, CacheKey b)
+{
+    return a.hi == b.hi && a.lo == b.lo;
+}
+
+static inline b32 cache_entry_path(
+    CompileCache *cache, CacheKey key, const char *ext,
+    char *buf, isize buf_size
+) {
+    int len = snprintf(
+        buf, buf_size, "%s/%016llx%016llx%s", cache->dir,
+        (unsigned long long)key.hi, (unsigned long long)key.lo, ext
+    );
+    return len > 0 && len < buf_size;
+}
+
+// NOTE(cya): keeps other processes out of the index
+static inline void cache_file_lock(CompileCache *cache)
+{
+    while (flock(cache->index_fd, LOCK_EX) != 0 && errno == EINTR);
+}
+
+static inline void cache_file_unlock(CompileCache *cache)
+{
+    flock(cache->index_fd, LOCK_UN);
+}
+
+/* flock locks the open file, which every thread of this process shares, so
+ * the threads take turns on the mutex first */
+static inline void cache_lock(CompileCache *cache)
+{
+    pthread_mutex_lock(&cache->lock);
+    cache_file_lock(cache);
+}
+
+static inline void cache_unlock(CompileCache *cache)
+{
+    cache_file_unlock(cache);
+    pthread_mutex_unlock(&cache->lock);
+}
+
+static isize cache_find_slot(CompileCacheIndex *index, CacheKey key)
+{
+    isize idx = key.hi % COMPILE_CACHE_SLOTS;
+    for (isize i = 0; i < COMPILE_CACHE_SLOTS; i++) {
+        CacheSlot *slot = &index->slots[idx];
+        if (slot->size == 0) {
+            break;
+        } else if (cache_key_are_equal(slot->key, key)) {
+            return idx;
+        }
+
+        idx = (idx + 1) % COMPILE_CACHE_SLOTS;
+    }
+
+    return -1;
+}
+
+// NOTE(cya): backward-shift deletion, so lookups never need tombstones
+static void cache_remove_slot(CompileCache *cache, isize idx)
+{
+    CompileCacheIndex *index = cache->index;
+    CacheSlot *slots = index->slots;
+
+    char path[0x500];
+    if (cache_entry_path(
+        cache, slots[idx].key, COMPILE_CACHE_ENTRY_EXT, path, sizeof(path)
+    )) {
+        unlink(path);
+    }
+
+    index->total_bytes -= slots[idx].size;
+    index->entry_count -= 1;
+
+    isize hole = idx;
+    for (;;) {
+        slots[hole].size = 0;
+
+        isize next = hole;
+        for (;;) {
+            next = (next + 1) % COMPILE_CACHE_SLOTS;
+            if (slots[next].size == 0) {
+                return;
+            }
+
+            isize home = slots[next].key.hi % COMPILE_CACHE_SLOTS;
+            b32 stays = hole <= next ?
+                hole < home && home <= next :
+                hole < home || home <= next;
+            if (!stays) {
+                break;
+            }
+        }
+
+        slots[hole] = slots[next];
+        hole = next;
+    }
+}
+
+static void cache_evict_lru(CompileCache *cache)
+{
+    CompileCacheIndex *index = cache->index;
+    isize lru = -1;
+    for (isize i = 0; i < COMPILE_CACHE_SLOTS; i++) {
+        CacheSlot *slot = &index->slots[i];
+        if (slot->size != 0 &&
+            (lru < 0 || slot->last_used < index->slots[lru].last_used)) {
+            lru = i;
+        }
+    }
+
+    if (lru >= 0) {
+        cache_remove_slot(cache, lru);
+        index->evictions += 1;
+    }
+}
+
+// NOTE(cya): must be called with the index locked
+static void cache_insert(CompileCache *cache, CacheKey key, isize size)
+{
+    CompileCacheIndex *index = cache->index;
+    isize existing = cache_find_slot(index, key);
+    if (existing >= 0) {
+        index->total_bytes -= index->slots[existing].size;
+        index->slots[existing].size = size;
+        index->slots[existing].last_used = ++index->clock;
+        index->total_bytes += size;
+        return;
+    }
+
+    while (index->entry_count > 0 &&
+        (index->entry_count >= COMPILE_CACHE_MAX_ENTRIES ||
+         (isize)index->total_bytes + size > cache->max_bytes)) {
+        cache_evict_lru(cache);
+    }
+
+    isize idx = key.hi % COMPILE_CACHE_SLOTS;
+    while (index->slots[idx].size != 0) {
+        idx = (idx + 1) % COMPILE_CACHE_SLOTS;
+    }
+
+    index->slots[idx] = (CacheSlot){
+        .key = key,
+        .size = size,
+        .last_used = ++index->clock,
+    };
+    index->entry_count += 1;
+    index->total_bytes += size;
+}
+
+// NOTE(cya): only names cache_entry_path could have produced are touched
+static inline b32 cache_entry_name_is_valid(const char *name)
+{
+    for (isize i = 0; i < COMPILE_CACHE_KEY_DIGITS; i++) {
+        char c = name[i];
+        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) {
+            return false;
+        }
+    }
+
+    return strcmp(
+        name + COMPILE_CACHE_KEY_DIGITS, COMPILE_CACHE_ENTRY_EXT
+    ) == 0;
+}
+
+// NOTE(cya): entries left behind by an index that had to be recreated
+static void cache_remove_orphans(CompileCache *cache)
+{
+    DIR *dir = opendir(cache->dir);
+    if (dir == NULL) {
+        return;
+    }
+
+    struct dirent *ent;
+    while ((ent = readdir(dir)) != NULL) {
+        if (cache_entry_name_is_valid(ent->d_name)) {
+            unlinkat(dirfd(dir), ent->d_name, 0);
+        }
+    }
+
+    closedir(dir);
+}
+
+b32 compile_cache_open(
+    const char *dir, isize max_bytes, CompileCache *cache_out
+) {
+    if (max_bytes <= 0) {
+        max_bytes = COMPILE_CACHE_DEFAULT_MAX_BYTES;
+    }
+
+    CompileCache cache = {.index_fd = -1, .max_bytes = max_bytes};
+    int len = snprintf(cache.dir, sizeof(cache.dir), "%s", dir);
+    if (len <= 0 || len >= (int)sizeof(cache.dir)) {
+        errno = ENAMETOOLONG;
+        return false;
+    }
+
+    if (mkdir(dir, 0755) != 0 && errno != EEXIST) {
+        return false;
+    }
+
+    char path[0x500];
+    snprintf(path, sizeof(path), "%s/index", dir);
+    cache.index_fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (cache.index_fd < 0) {
+        return false;
+    }
+
+    isize index_size = sizeof(*cache.index);
+    cache_file_lock(&cache);
+
+    struct stat st;
+    b32 fresh = fstat(cache.index_fd, &st) != 0 || st.st_size != index_size;
+    if (fresh && ftruncate(cache.index_fd, index_size) != 0) {
+        goto error;
+    }
+
+    void *mem = mmap(
+        NULL, index_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+        cache.index_fd, 0
+    );
+    if (mem == MAP_FAILED) {
+        goto error;
+    }
+
+    cache.index = mem;
+    if (fresh ||
+        cache.index->magic != COMPILE_CACHE_INDEX_MAGIC ||
+        cache.index->slot_count != COMPILE_CACHE_SLOTS) {
+        cy_mem_zero(cache.index, index_size);
+        cache.index->magic = COMPILE_CACHE_INDEX_MAGIC;
+        cache.index->slot_count = COMPILE_CACHE_SLOTS;
+        cache_remove_orphans(&cache);
+    }
+
+    cache_file_unlock(&cache);
+    *cache_out = cache;
+    pthread_mutex_init(&cache_out->lock, NULL);
+    return true;
+
+error:
+    cache_file_unlock(&cache);
+    close(cache.index_fd);
+    return false;
+}
+
+void compile_cache_close(CompileCache *cache)
+{
+    if (cache->index != NULL) {
+        munmap(cache->index, sizeof(*cache->index));
+    }
+    if (cache->index_fd >= 0) {
+        close(cache->index_fd);
+        pthread_mutex_destroy(&cache->lock);
+    }
+
+    cy_mem_zero(cache, sizeof(*cache));
+    cache->index_fd = -1;
+}
+
+CompileCacheStats compile_cache_stats(CompileCache *cache)
+{
+    cache_lock(cache);
+    CompileCacheIndex *index = cache->index;
+    CompileCacheStats stats = {
+        .hits = index->hits,
+        .misses = index->misses,
+        .evictions = index->evictions,
+        .entry_count = index->entry_count,
+        .total_bytes = index->total_bytes,
+    };
+    cache_unlock(cache);
+
+    return stats;
+}
+
+/* Maps the entry for key (if there's a valid one) and counts the lookup as a
+ * hit or a miss. The mapping stays valid even if the entry gets evicted */
+static b32 cache_lookup(
+    CompileCache *cache, CacheKey key, isize src_len,
+    CyFileMap *map_out, CacheEntryHeader *header_out
+) {
+    cache_lock(cache);
+    CompileCacheIndex *index = cache->index;
+
+    b32 found = false;
+    CyFileMap map = {0};
+    CacheEntryHeader header;
+    isize idx = cache_find_slot(index, key);
+    char path[0x500];
+    if (idx >= 0 && cache_entry_path(
+        cache, key, COMPILE_CACHE_ENTRY_EXT, path, sizeof(path)
+    ) && cy_file_map_open(path, &map)) {
+        if (map.size >= (isize)sizeof(header)) {
+            cy_mem_copy(&header, map.data, sizeof(header));
+            isize expected_size = sizeof(header) +
+                header.code_len + header.msg_len;
+            found = header.magic == COMPILE_CACHE_ENTRY_MAGIC &&
+                cache_key_are_equal(header.key, key) &&
+                header.src_len == (u64)src_len &&
+                map.size == expected_size;
+        }
+
+        if (!found) {
+            cy_file_map_close(&map);
+        }
+    }
+
+    if (found) {
+        index->slots[idx].last_used = ++index->clock;
+        index->hits += 1;
+    } else {
+        if (idx >= 0) {
+            cache_remove_slot(cache, idx);
+        }
+
+        index->misses += 1;
+    }
+
+    cache_unlock(cache);
+    if (found) {
+        *map_out = map;
+        *header_out = header;
+    }
+
+    return found;
+}
+
+typedef struct {
+    int fd;           // NOTE(cya): entry being written (-1 if it failed)
+    isize written;
+    IlSinkBackend to; // NOTE(cya): where the IL was going in the first place
+    b32 to_failed;
+} CacheTee;
+
+static IL_SINK_WRITE_PROC(cache_tee_write)
+{
+    CacheTee *tee = data;
+    if (tee->fd >= 0 && !il_sink_fd_write((void*)(intptr_t)tee->fd, buf, len)) {
+        close(tee->fd);
+        tee->fd = -1;
+    }
+
+    tee->written += len;
+    if (!tee->to.proc(tee->to.data, buf, len)) {
+        tee->to_failed = true;
+        return false;
+    }
+
+    return true;
+}
+
+CompilerOutput compile_cached(
+    CompileCache *cache, CyAllocator a, String src_code,
+    const IlSinkBackend *sink, CompilerStats *stats
+) {
+    CompilerContext ctx = compiler_context_init(a);
+    CompilerOutput output = compile_cached_with_context(
+        cache, &ctx, src_code, sink, stats
+    );
+    compiler_context_deinit(&ctx);
+
+    return output;
+}
+
+CompilerOutput compile_cached_with_context(
+    CompileCache *cache, CompilerContext *ctx, String src_code,
+    const IlSinkBackend *sink, CompilerStats *stats
+) {
+    CyAllocator a = ctx->alloc;
+    CyTicks start = cy_ticks_query();
+    CacheKey key = cache_key_from_src(
+        src_code, cache_options_from_context(ctx)
+    );
+
+    CyFileMap map;
+    CacheEntryHeader header;
+    if (cache_lookup(cache, key, src_code.len, &map, &header)) {
+        const u8 *code = map.data + sizeof(header);
+        const u8 *msg = code + header.code_len;
+
+        CompilerOutput output = {
+            .ok = header.ok,
+            .msg = cy_string_create_len(a, (const char*)msg, header.msg_len),
+        };
+        if (header.ok && sink != NULL) {
+            if (header.code_len > 0 &&
+                !sink->proc(sink->data, code, header.code_len)) {
+                output.ok = false;
+                output.msg = cy_string_set(
+                    output.msg, "erro ao escrever o código objeto"
+                );
+            }
+        } else if (header.ok) {
+            output.code = cy_string_create_len(
+                a, (const char*)code, header.code_len
+            );
+        }
+
+        cy_file_map_close(&map);
+        compiler_output_append_time(&output, start);
+        if (stats != NULL) {
+            cy_mem_zero(stats, sizeof(*stats));
+            stats->src_bytes = src_code.len;
+            stats->il_bytes = header.code_len;
+            stats->cache_hit = true;
+            CyTicks elapsed = cy_ticks_elapsed(start, cy_ticks_query());
+            stats->total_us = cy_ticks_to_time_unit(
+                elapsed, CY_MICROSECONDS
+            );
+        }
+
+        return output;
+    }
+
+    // NOTE(cya): the entry is written next to its final name and renamed
+    // into place, so other processes never see it half-written. The name
+    // is unique, as threads (and processes) may be storing the same source
+    char tmp_path[0x500], path[0x500];
+    CacheTee tee = {.fd = -1};
+    if (cache_entry_path(
+            cache, key, ".tmp.XXXXXX", tmp_path, sizeof(tmp_path)
+        ) && cache_entry_path(
+            cache, key, COMPILE_CACHE_ENTRY_EXT, path, sizeof(path)
+        )) {
+        tee.fd = mkstemp(tmp_path);
+    }
+
+    // NOTE(cya): mkstemp makes files only their owner can read
+    b32 tmp_created = tee.fd >= 0;
+    if (tee.fd >= 0 && fchmod(tee.fd, 0644) != 0) {
+        close(tee.fd);
+        tee.fd = -1;
+    }
+
+    header = (CacheEntryHeader){0};
+    if (tee.fd >= 0 && lseek(tee.fd, sizeof(header), SEEK_SET) < 0) {
+        close(tee.fd);
+        tee.fd = -1;
+    }
+
+    CyString code = NULL;
+    if (sink != NULL) {
+        tee.to = *sink;
+    } else {
+        code = cy_string_create_reserve(a, IL_SINK_CHUNK_SIZE);
+        tee.to = il_sink_backend_string(&code);
+    }
+
+    IlSinkBackend tee_backend = {.proc = cache_tee_write, .data = &tee};
+    CompilerOutput output = compile_internal(
+        ctx, src_code, &tee_backend, stats
+    );
+    if (sink == NULL && output.ok) {
+        output.code = code;
+    } else {
+        cy_string_free(code);
+    }
+
+    if (tee.fd < 0) {
+        if (tmp_created) {
+            unlink(tmp_path);
+        }
+
+        compiler_output_append_time(&output, start);
+        return output;
+    }
+
+    header = (CacheEntryHeader){
+        .magic = COMPILE_CACHE_ENTRY_MAGIC,
+        .ok = output.ok,
+        .key = key,
+        .src_len = src_code.len,
+        .code_len = tee.written,
+        .msg_len = cy_string_len(output.msg),
+    };
+    isize entry_size = sizeof(header) + header.code_len + header.msg_len;
+
+    // NOTE(cya): a failed write to the caller's sink says nothing about the
+    // source, so it isn't cached
+    b32 stored = !tee.to_failed &&
+        il_sink_fd_write(
+            (void*)(intptr_t)tee.fd, (const u8*)output.msg, header.msg_len
+        ) &&
+        pwrite(tee.fd, &header, sizeof(header), 0) == sizeof(header);
+    close(tee.fd);
+
+    if (stored && entry_size <= cache->max_bytes &&
+        rename(tmp_path, path) == 0) {
+        cache_lock(cache);
+        cache_insert(cache, key, entry_size);
+        cache_unlock(cache);
+    } else {
+        unlink(tmp_path);
+    }
+
+    compiler_output_append_time(&output, start);
+    return output;
+}
+#endif
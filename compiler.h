@@ -0,0 +1,191 @@
+#ifndef _COMPILER_H
+#define _COMPILER_H
+
+#include "cy.h"
+
+#define COMPILER_VERSION "1.0"
+
+/* ------------------------------ Output sinks ------------------------------ */
+/* The IL is buffered in fixed-size chunks and handed to the backend as each
+ * chunk fills up; returning false aborts code generation */
+#define IL_SINK_WRITE_PROC(name) b32 name(void *data, const u8 *buf, isize len)
+typedef IL_SINK_WRITE_PROC(IlSinkWriteProc);
+
+typedef struct {
+    IlSinkWriteProc *proc;
+    void *data;
+} IlSinkBackend;
+
+// NOTE(cya): appends to *str (growing it geometrically)
+CY_DEF IlSinkBackend il_sink_backend_string(CyString *str);
+CY_DEF IlSinkBackend il_sink_backend_file(FILE *file);
+#if !defined(CY_OS_WINDOWS)
+CY_DEF IlSinkBackend il_sink_backend_fd(int fd);
+#endif
+
+/* -------------------------- Compiler interface ---------------------------- */
+typedef struct {
+    CyString msg;
+    CyString code; // NOTE(cya): NULL unless compiled into memory successfully
+    b32 ok;
+    CyFileMap src; // NOTE(cya): mapped source (if any), released with output
+} CompilerOutput;
+
+/* Per-phase measurements (phases that didn't run are left zeroed). The parser
+ * pulls tokens from the tokenizer as it goes, so parse_us includes tokenizing
+ */
+typedef struct {
+    f64 parse_us;
+    f64 check_us;
+    f64 il_generate_us;
+    f64 total_us;
+
+    isize src_bytes;
+    isize token_count;
+    isize ast_node_count;
+    isize arena_bytes;
+    isize parser_stack_max_depth; // NOTE(cya): high-water mark (in symbols)
+    isize il_bytes;
+    b32 cache_hit; // NOTE(cya): see compile_cached()
+} CompilerStats;
+
+/* Scratch memory for compilations (tokens, AST and parser stack). Reusing a
+ * context keeps its memory warm between compilations. The compiler has no
+ * other mutable state, so threads can compile in parallel as long as each one
+ * has its own context */
+typedef struct {
+    CyAllocator alloc;
+    CyArena arena;
+    CyStack parser_stack; // NOTE(cya): sized on first use
+    /* Threads to lex sources of a few MB or more with (1 by default). The
+     * tokens come out the same either way */
+    isize tokenize_threads;
+    /* Report every lexical error in a source that has them (or, if it has
+     * none, every syntax error), one per line, instead of only the first one
+     * (false by default) */
+    b32 all_errors;
+    /* Only check the syntax, with no AST, checking or IL: output.code stays
+     * NULL and nothing goes to the sink (false by default) */
+    b32 syntax_only;
+    /* Lex with the DFA generated from the lexical rules (see compiler_gen.c)
+     * instead of rune by rune (false by default). The tokens and errors come
+     * out the same either way */
+    b32 dfa_tokenizer;
+    b32 dirty;
+} CompilerContext;
+
+CY_DEF CompilerContext compiler_context_init(CyAllocator a);
+CY_DEF void compiler_context_deinit(CompilerContext *ctx);
+
+// NOTE(cya): every string in the output is owned by the given allocator
+CY_DEF CompilerOutput compile(CyAllocator a, CyStringView src_code);
+// NOTE(cya): same as compile(), but also fills in stats_out (if not NULL)
+CY_DEF CompilerOutput compile_with_stats(
+    CyAllocator a, CyStringView src_code, CompilerStats *stats_out
+);
+// NOTE(cya): streams the IL to sink instead of building output.code
+CY_DEF CompilerOutput compile_to_sink(
+    CyAllocator a, CyStringView src_code, IlSinkBackend sink,
+    CompilerStats *stats_out
+);
+/* Compiles with ctx's memory (and allocator); the IL goes to sink, or to
+ * output.code if sink is NULL */
+CY_DEF CompilerOutput compile_with_context(
+    CompilerContext *ctx, CyStringView src_code, const IlSinkBackend *sink,
+    CompilerStats *stats_out
+);
+/* Compiles straight from a file mapping (see cy_file_map_open), without
+ * copying the source; the output takes ownership of the mapping. The IL goes
+ * to sink, or to output.code if sink is NULL */
+CY_DEF CompilerOutput compile_file_map(
+    CyAllocator a, CyFileMap src, const IlSinkBackend *sink,
+    CompilerStats *stats_out
+);
+CY_DEF void compiler_output_free(CompilerOutput *output);
+
+/* ------------------------- Incremental tokenizer -------------------------- */
+/* Whole token streams, with kinds, offsets and lengths in parallel arrays: 9
+ * bytes per token. Kinds are the compiler's token codes (see token_kind_name).
+ * A list ends with the EOF token, or stops right before the first lexical
+ * error of its source */
+typedef struct {
+    u8 *kinds;
+    u32 *offsets;
+    u32 *lens;
+    isize len;
+    isize cap;
+} TokenList;
+
+// NOTE(cya): replaces len bytes at offset with text
+typedef struct {
+    isize offset;
+    isize len;
+    CyStringView text;
+} SourceEdit;
+
+CY_DEF CyStringView token_kind_name(u8 kind);
+CY_DEF void token_list_free(CyAllocator a, TokenList *l);
+/* Lexes src into out (reusing its memory); false if out of memory, in which
+ * case out is freed */
+CY_DEF b32 tokenize_source(CyAllocator a, CyStringView src, TokenList *out);
+// NOTE(cya): applies edit to src in place (growing it); NULL if out of memory
+CY_DEF CyString source_apply_edit(CyString src, SourceEdit edit);
+/* Brings tokens, the list of a source before edit, up to date with src, the
+ * same source with edit applied. Only the tokens around the edit are lexed
+ * again (their count is returned); the rest are kept, shifted. Returns -1 if
+ * out of memory, in which case tokens is left empty */
+CY_DEF isize tokenize_edit(
+    CyAllocator a, CyStringView src, TokenList *tokens, SourceEdit edit
+);
+
+/* ------------------------------ Compile cache ----------------------------- */
+#if !defined(CY_OS_WINDOWS)
+#include <pthread.h>
+
+#define COMPILE_CACHE_DEFAULT_MAX_BYTES (64 * 1024 * 1024)
+
+typedef struct CompileCacheIndex CompileCacheIndex;
+
+/* On-disk cache of compiler outputs (IL and message), keyed by a hash of the
+ * source, of the compiler version and of the options. Each entry is a file in
+ * the cache directory, found through a memory-mapped index that can be shared
+ * (under a file lock) by concurrent processes, and one cache can be used by
+ * several threads at once; least recently used entries are evicted once the
+ * entries add up to more than max_bytes */
+typedef struct {
+    char dir[0x400];
+    int index_fd;
+    CompileCacheIndex *index;
+    isize max_bytes;
+    pthread_mutex_t lock; // NOTE(cya): threads sharing the cache take turns
+} CompileCache;
+
+typedef struct {
+    isize hits;
+    isize misses;
+    isize evictions;
+    isize entry_count;
+    isize total_bytes;
+} CompileCacheStats;
+
+// NOTE(cya): creates the directory if needed; max_bytes <= 0 uses the default
+CY_DEF b32 compile_cache_open(
+    const char *dir, isize max_bytes, CompileCache *cache_out
+);
+CY_DEF void compile_cache_close(CompileCache *cache);
+CY_DEF CompileCacheStats compile_cache_stats(CompileCache *cache);
+/* Same as compile_to_sink() (or compile_with_stats() if sink is NULL), but
+ * a source that's already in the cache isn't compiled again */
+CY_DEF CompilerOutput compile_cached(
+    CompileCache *cache, CyAllocator a, CyStringView src_code,
+    const IlSinkBackend *sink, CompilerStats *stats_out
+);
+/* Same as compile_with_context(), through the cache. The context's options
+ * that change the output (all_errors and syntax_only) are part of the key */
+CY_DEF CompilerOutput compile_cached_with_context(
+    CompileCache *cache, CompilerContext *ctx, CyStringView src_code,
+    const IlSinkBackend *sink, CompilerStats *stats_out
+);
+#endif
+
+#endif // _COMPILER_H
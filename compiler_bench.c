@@ -0,0 +1,1634 @@
+#include "compiler.c"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+/* ------------------------- Workload generator ----------------------------- */
+#define BENCH_SHAPES \
+    BENCH_SHAPE(BENCH_DECLS, "decls"), \
+    BENCH_SHAPE(BENCH_WRITELN, "writeln"), \
+    BENCH_SHAPE(BENCH_NESTED_IF, "nested_if"), \
+    BENCH_SHAPE(BENCH_REPEAT, "repeat"), \
+    BENCH_SHAPE(BENCH_EXPR, "expr"), \
+    BENCH_SHAPE(BENCH_STRINGS, "strings"), \
+    BENCH_SHAPE(BENCH_COMMENTS, "comments"), \
+    BENCH_SHAPE(BENCH_SHAPE_COUNT, "")
+
+typedef enum {
+#define BENCH_SHAPE(e, s) e
+    BENCH_SHAPES
+#undef BENCH_SHAPE
+} BenchShape;
+
+static const char *g_bench_shape_names[] = {
+#define BENCH_SHAPE(e, s) s
+    BENCH_SHAPES
+#undef BENCH_SHAPE
+};
+
+typedef struct {
+    isize writeln_args;  // NOTE(cya): expressions per writeln
+    isize nesting_depth; // NOTE(cya): if/elif/else levels per block
+    isize repeat_body;   // NOTE(cya): statements per repeat
+    isize expr_terms;    // NOTE(cya): terms per assigned expression
+    isize string_len;    // NOTE(cya): characters per string literal
+    isize comment_lines; // NOTE(cya): lines per block comment
+} BenchParams;
+
+static const BenchParams g_default_params = {
+    .writeln_args = 64,
+    .nesting_depth = 32,
+    .repeat_body = 1000,
+    .expr_terms = 2000,
+    .string_len = 200,
+    .comment_lines = 8,
+};
+
+// NOTE(cya): cy_string_append_fmt zeroes a 4KB buffer on every call, which
+// would dominate generation time for the larger sizes
+static CyString bench_append_fmt(CyString str, const char *fmt, ...)
+{
+    va_list va;
+    va_start(va, fmt);
+
+    char buf[0x100];
+    isize len = vsnprintf(buf, sizeof(buf), fmt, va);
+
+    va_end(va);
+    return cy_string_append_len(str, buf, CY_MIN(len, (isize)sizeof(buf) - 1));
+}
+
+static CyString bench_append_nested_if(CyString src, isize depth, isize level)
+{
+    src = bench_append_fmt(src, "if i_a > %td\n", level);
+    if (level + 1 < depth) {
+        src = bench_append_nested_if(src, depth, level + 1);
+    } else {
+        src = cy_string_append_c(src, "writeln(i_a, \"fundo\");\n");
+    }
+
+    src = bench_append_fmt(src, "elif i_a < %td\n", level);
+    src = cy_string_append_c(src, "writeln(\"elif\");\n");
+    src = cy_string_append_c(src, "else\n");
+    src = cy_string_append_c(src, "i_a = i_a + 1;\n");
+    return cy_string_append_c(src, "end;\n");
+}
+
+static CyString bench_generate(
+    CyAllocator a, BenchShape shape, isize target_size, const BenchParams *p
+) {
+    const char *footer = "end\n";
+    isize footer_len = cy_str_len(footer);
+
+    CyString src = cy_string_create_reserve(a, target_size + 0x100);
+    src = cy_string_append_c(src, "main\n");
+    if (shape != BENCH_DECLS) {
+        src = cy_string_append_c(src, "i_a, i_b;\nf_c;\ns_d;\nb_e;\n");
+    }
+
+    isize chunk = 0;
+    while (cy_string_len(src) + footer_len < target_size) {
+        switch (shape) {
+        case BENCH_DECLS: {
+            src = bench_append_fmt(src, "i_v%td, f_v%td;\n", chunk, chunk);
+        } break;
+        case BENCH_WRITELN: {
+            src = cy_string_append_c(src, "writeln(\"linha\"");
+            const char *args[] = {
+                ", i_a", ", f_c", ", s_d", ", 42", ", \"texto %x\"",
+            };
+            for (isize i = 0; i < p->writeln_args; i++) {
+                isize arg = i % CY_STATIC_ARR_LEN(args);
+                src = cy_string_append_c(src, args[arg]);
+            }
+
+            src = cy_string_append_c(src, ");\n");
+        } break;
+        case BENCH_NESTED_IF: {
+            src = bench_append_nested_if(src, p->nesting_depth, 0);
+        } break;
+        case BENCH_REPEAT: {
+            src = cy_string_append_c(src, "repeat\n");
+            for (isize i = 0; i < p->repeat_body; i++) {
+                src = (i & 1) ?
+                    cy_string_append_c(src, "writeln(i_a, f_c);\n") :
+                    bench_append_fmt(src, "i_a = i_a + %td;\n", i);
+            }
+
+            src = cy_string_append_c(src, "until i_a > 1000;\n");
+        } break;
+        case BENCH_EXPR: {
+            src = cy_string_append_c(src, "f_c = i_a");
+            for (isize i = 1; i < p->expr_terms; i++) {
+                const char *ops[] = { " + ", " - ", " * ", " / " };
+                src = cy_string_append_c(src, ops[i & 3]);
+                src = (i % 3 == 0) ?
+                    bench_append_fmt(src, "(i_b - %td)", i) :
+                    cy_string_append_c(src, (i & 1) ? "f_c" : "i_b");
+            }
+
+            src = cy_string_append_c(src, ";\n");
+        } break;
+        case BENCH_STRINGS: {
+            const char *text = "o rato roeu a roupa do rei de roma %x ";
+            isize text_len = cy_str_len(text);
+            src = cy_string_append_c(src, "writeln(\"");
+            for (isize i = 0; i < p->string_len; i += text_len) {
+                isize len = CY_MIN(text_len, p->string_len - i);
+                if (len > 1 && text[len - 1] == '%') {
+                    len -= 1; // NOTE(cya): never split a %x
+                }
+
+                src = cy_string_append_len(src, text, len);
+            }
+
+            src = cy_string_append_c(src, "\", s_d);\n");
+        } break;
+        case BENCH_COMMENTS: {
+            src = cy_string_append_c(src, ">@\n");
+            for (isize i = 0; i < p->comment_lines; i++) {
+                src = bench_append_fmt(
+                    src, "linha %td do comentário de bloco, que descreve "
+                    "o código logo abaixo\n", i
+                );
+            }
+
+            src = cy_string_append_c(src, "@<\ni_a = i_a + 1;\n");
+        } break;
+        default: break;
+        }
+
+        if (src == NULL) {
+            return NULL;
+        }
+
+        chunk += 1;
+    }
+
+    return cy_string_append_c(src, footer);
+}
+
+/* ----------------------------- Benchmark ---------------------------------- */
+#define BENCH_MIN_TIME_US 250000.0
+#define BENCH_MAX_ITERS 1000
+
+typedef struct {
+    CompilerStats best; // NOTE(cya): fastest time of each phase
+    isize iters;
+} BenchResult;
+
+static b32 bench_run(CyAllocator a, String src, BenchResult *res_out)
+{
+    BenchResult res = {0};
+    f64 elapsed_us = 0.0;
+    while (elapsed_us < BENCH_MIN_TIME_US && res.iters < BENCH_MAX_ITERS) {
+        CompilerStats s;
+        CompilerOutput output = compile_with_stats(a, src, &s);
+        b32 ok = output.code != NULL;
+        if (!ok) {
+            cy_printf_err("erro no programa gerado: %s\n", output.msg);
+        }
+
+        compiler_output_free(&output);
+        if (!ok) {
+            return false;
+        }
+
+        if (res.iters == 0) {
+            res.best = s;
+        } else {
+            res.best.parse_us = CY_MIN(res.best.parse_us, s.parse_us);
+            res.best.check_us = CY_MIN(res.best.check_us, s.check_us);
+            res.best.il_generate_us =
+                CY_MIN(res.best.il_generate_us, s.il_generate_us);
+            res.best.total_us = CY_MIN(res.best.total_us, s.total_us);
+        }
+
+        elapsed_us += s.total_us;
+        res.iters += 1;
+    }
+
+    *res_out = res;
+    return true;
+}
+
+static inline f64 size_in_mb(isize bytes)
+{
+    return (f64)bytes / (1024.0 * 1024.0);
+}
+
+static void bench_print_header(void)
+{
+    printf(
+        "%-10s %8s %10s %4s | %-19s | %-19s | %-19s | %-8s\n",
+        "shape", "size", "tokens", "it",
+        "tokenize+parse", "check", "il_generate", "total"
+    );
+    printf(
+        "%-10s %8s %10s %4s | %8s %10s | %8s %10s | %8s %10s | %8s\n",
+        "", "", "", "",
+        "MB/s", "ns/token", "MB/s", "ns/token", "MB/s", "ns/token", "MB/s"
+    );
+}
+
+static void bench_print_phase(isize bytes, isize tokens, f64 us)
+{
+    f64 mb_per_s = us > 0.0 ? size_in_mb(bytes) / (us / 1e6) : 0;
+    f64 ns_per_tok = tokens > 0 ? us * 1000.0 / tokens : 0;
+    printf(" | %8.1f %10.2f", mb_per_s, ns_per_tok);
+}
+
+static void bench_print_row(BenchShape shape, const BenchResult *r)
+{
+    const CompilerStats *s = &r->best;
+    isize bytes = s->src_bytes;
+    f64 size = (f64)bytes;
+    const char *unit = "B";
+    if (size >= 1024.0 * 1024.0) {
+        size /= 1024.0 * 1024.0, unit = "M";
+    } else if (size >= 1024.0) {
+        size /= 1024.0, unit = "K";
+    }
+
+    printf(
+        "%-10s %7.1f%s %10td %4td", g_bench_shape_names[shape],
+        size, unit, s->token_count, r->iters
+    );
+    bench_print_phase(bytes, s->token_count, s->parse_us);
+    bench_print_phase(bytes, s->token_count, s->check_us);
+    bench_print_phase(bytes, s->token_count, s->il_generate_us);
+
+    f64 total_s = s->total_us / 1e6;
+    printf(" | %8.1f\n", total_s > 0 ? size_in_mb(bytes) / total_s : 0);
+    fflush(stdout);
+}
+
+/* ------------------------- Word classification ---------------------------- */
+#define BENCH_WORD_COUNT 0x4000
+#define BENCH_LEGACY_SLOTS (KEYWORD_COUNT * 3)
+
+// NOTE(cya): the keyword table the tokenizer used before compiler_keywords.h
+static isize g_legacy_keyword_slots[BENCH_LEGACY_SLOTS];
+
+static isize legacy_keyword_hash(String key)
+{
+    if (key.len < 2) {
+        return -1;
+    }
+
+    u16 l = (u16)key.text[0] << 8, r = key.text[key.len - 2];
+    return (isize)((l | r) * key.len) % BENCH_LEGACY_SLOTS;
+}
+
+static void legacy_keyword_init(void)
+{
+    for (isize i = C_TOKEN__KEYWORD_BEGIN + 1; i < C_TOKEN__KEYWORD_END; i++) {
+        g_legacy_keyword_slots[legacy_keyword_hash(g_token_strings[i])] = i;
+    }
+}
+
+static TokenKind legacy_classify_word(String word)
+{
+    b32 not_keyword = rune_is_uppercase(word.text[0]) ||
+        cy_string_view_contains(word, "_0123456789");
+    if (not_keyword) {
+        return token_is_ident(word) ? C_TOKEN_IDENT : C_TOKEN_INVALID;
+    }
+
+    isize idx = legacy_keyword_hash(word);
+    if (idx == -1) {
+        return C_TOKEN_INVALID;
+    }
+
+    isize kind = g_legacy_keyword_slots[idx];
+    String keyword = g_token_strings[kind];
+    if (*word.text != *keyword.text ||
+        !cy_string_view_are_equal(word, keyword)) {
+        return C_TOKEN_INVALID;
+    }
+
+    return kind;
+}
+
+// NOTE(cya): same work as the word loop in tokenizer_get_token
+static TokenKind current_classify_word(String word)
+{
+    b32 maybe_keyword = !rune_is_uppercase(word.text[0]);
+    for (isize i = 0; i < word.len; i++) {
+        maybe_keyword &= rune_is_letter(word.text[i]);
+    }
+
+    return token_kind_from_word(word, maybe_keyword);
+}
+
+typedef TokenKind (*BenchClassifyProc)(String word);
+
+// NOTE(cya): keeps the classification loops from being optimized out
+static volatile isize g_bench_sink;
+
+// NOTE(cya): best time per word (in ns) over repeated passes
+static f64 bench_classify(
+    BenchClassifyProc classify, const String *words, isize count, isize *sum
+) {
+    f64 best_ns = F64_MAX, elapsed_us = 0.0;
+    for (isize pass = 0; elapsed_us < BENCH_MIN_TIME_US; pass++) {
+        CyTicks start = cy_ticks_query();
+        for (isize i = 0; i < count; i++) {
+            *sum += classify(words[i]);
+        }
+
+        CyTicks elapsed = cy_ticks_elapsed(start, cy_ticks_query());
+        f64 us = cy_ticks_to_time_unit(elapsed, CY_MICROSECONDS);
+        best_ns = CY_MIN(best_ns, us * 1000.0 / count);
+        elapsed_us += us;
+    }
+
+    return best_ns;
+}
+
+static b32 bench_classification(CyAllocator a)
+{
+    const char *idents[] = {
+        "i_a", "f_valor", "s_nomeCompleto", "b_ok", "i_contador2",
+        "f_x1y2", "s_textoLongoDeExemplo", "i_b",
+    };
+    const char *invalid[] = { "mai", "whilee", "i_AB", "x_1", "Main" };
+    const char *mixes[] = { "keywords", "idents", "mixed", "invalid" };
+
+    legacy_keyword_init();
+    String *words = cy_alloc_array(a, String, BENCH_WORD_COUNT);
+    if (words == NULL) {
+        return false;
+    }
+
+    printf(
+        "%-10s %12s %12s %9s\n",
+        "words", "legacy ns", "current ns", "speedup"
+    );
+    for (isize mix = 0; mix < CY_STATIC_ARR_LEN(mixes); mix++) {
+        for (isize i = 0; i < BENCH_WORD_COUNT; i++) {
+            isize kind = C_TOKEN__KEYWORD_BEGIN + 1 + i % KEYWORD_COUNT;
+            const char *ident = idents[i % CY_STATIC_ARR_LEN(idents)];
+            b32 use_keyword = mix == 0 || (mix == 2 && (i & 1));
+            if (mix == 3) {
+                ident = invalid[i % CY_STATIC_ARR_LEN(invalid)];
+            }
+
+            words[i] = use_keyword ?
+                g_token_strings[kind] : cy_string_view_create_c(ident);
+            if (legacy_classify_word(words[i]) !=
+                current_classify_word(words[i])) {
+                cy_printf_err(
+                    "erro: classificação diferente para %.*s\n",
+                    STRING_ARG(words[i])
+                );
+                return false;
+            }
+        }
+
+        isize sum = 0;
+        f64 legacy_ns = bench_classify(
+            legacy_classify_word, words, BENCH_WORD_COUNT, &sum
+        );
+        f64 current_ns = bench_classify(
+            current_classify_word, words, BENCH_WORD_COUNT, &sum
+        );
+        printf(
+            "%-10s %12.2f %12.2f %8.2fx\n", mixes[mix],
+            legacy_ns, current_ns, legacy_ns / current_ns
+        );
+        g_bench_sink = sum;
+    }
+
+    cy_free(a, words);
+    return true;
+}
+
+/* --------------------------- Tokenizer backends --------------------------- */
+/* The parser pulls its tokens one at a time, so a whole token stream (a
+ * TokenList) is only kept here, to compare backends, and by the chunked and
+ * incremental tokenizers. Like theirs, the list stops at a lexical error */
+static TokenList tokenize(CyAllocator a, Tokenizer *t)
+{
+    TokenList list = {0};
+    for (;;) {
+        Token tok = tokenizer_next_token(t);
+        if (t->err != T_ERR_NONE) {
+            break;
+        } else if (!token_list_push(a, &list, tok)) {
+            tokenizer_error(t, NULL, T_ERR_OUT_OF_MEMORY, NULL);
+            token_list_free(a, &list);
+            break;
+        }
+
+        if (tok.kind == C_TOKEN_EOF) {
+            break;
+        }
+    }
+
+    return list;
+}
+
+static b32 token_lists_are_equal(const TokenList *x, const TokenList *y)
+{
+    isize len = x->len;
+    return len == y->len &&
+        cy_mem_compare(x->kinds, y->kinds, len) == 0 &&
+        cy_mem_compare(x->offsets, y->offsets, len * sizeof(u32)) == 0 &&
+        cy_mem_compare(x->lens, y->lens, len * sizeof(u32)) == 0;
+}
+
+// NOTE(cya): best tokenize time (in us) with a copy of the set up tokenizer,
+// checking that every pass gives the same tokens as the reference list
+static b32 bench_tokenize(
+    CyAllocator a, const Tokenizer *setup, const TokenList *reference,
+    f64 *best_us_out
+) {
+    CyArena arena = cy_arena_init(a, 0);
+    CyAllocator temp = cy_arena_allocator(&arena);
+
+    b32 ok = true;
+    f64 best_us = F64_MAX, elapsed_us = 0.0;
+    for (isize i = 0; ok && elapsed_us < BENCH_MIN_TIME_US; i++) {
+        Tokenizer t = *setup;
+
+        CyTicks start = cy_ticks_query();
+        TokenList list = tokenize(temp, &t);
+        CyTicks elapsed = cy_ticks_elapsed(start, cy_ticks_query());
+        f64 us = cy_ticks_to_time_unit(elapsed, CY_MICROSECONDS);
+        best_us = CY_MIN(best_us, us);
+        elapsed_us += us;
+
+        ok = t.err == T_ERR_NONE && token_lists_are_equal(&list, reference);
+
+        cy_free_all(temp);
+    }
+
+    cy_arena_deinit(&arena);
+    *best_us_out = best_us;
+    return ok;
+}
+
+// NOTE(cya): tokens from the scalar rune backend, which the others must match
+static b32 bench_reference_tokens(CyAllocator a, String src, TokenList *out)
+{
+    Tokenizer t = tokenizer_init(src);
+    t.scan = &g_scan_kernels[SCAN_KERNELS_SCALAR];
+    *out = tokenize(a, &t);
+    if (t.err != T_ERR_NONE) {
+        cy_printf_err("erro no programa gerado\n");
+        return false;
+    }
+
+    return true;
+}
+
+static void bench_print_tokenize_row(
+    BenchShape shape, String src, const char *name, f64 us, f64 base_us
+) {
+    printf(
+        "%-10s %8.1fK %8s %10.1f %8.2fx\n", g_bench_shape_names[shape],
+        src.len / 1024.0, name, size_in_mb(src.len) / (us / 1e6), base_us / us
+    );
+    fflush(stdout);
+}
+
+static b32 bench_scan_kernels(CyAllocator a, BenchShape shape, String src)
+{
+    TokenList reference;
+    if (!bench_reference_tokens(a, src, &reference)) {
+        return false;
+    }
+
+    f64 scalar_us = 0.0;
+    for (isize kind = 0; kind < SCAN_KERNELS_COUNT; kind++) {
+        if (!scan_kernels_supported(kind)) {
+            continue;
+        }
+
+        Tokenizer setup = tokenizer_init(src);
+        setup.scan = &g_scan_kernels[kind];
+        f64 us;
+        if (!bench_tokenize(a, &setup, &reference, &us)) {
+            cy_printf_err("erro: tokens diferentes com %s\n", setup.scan->name);
+            token_list_free(a, &reference);
+            return false;
+        }
+
+        if (kind == SCAN_KERNELS_SCALAR) {
+            scalar_us = us;
+        }
+
+        bench_print_tokenize_row(shape, src, setup.scan->name, us, scalar_us);
+    }
+
+    token_list_free(a, &reference);
+    return true;
+}
+
+// NOTE(cya): the rune backend (with the best scan kernels) against the DFA
+static b32 bench_dfa(CyAllocator a, BenchShape shape, String src)
+{
+    TokenList reference;
+    if (!bench_reference_tokens(a, src, &reference)) {
+        return false;
+    }
+
+    const char *names[] = { "runes", "dfa" };
+    TokenizerBackend backends[] = {
+        TOKENIZER_BACKEND_RUNES, TOKENIZER_BACKEND_DFA,
+    };
+    f64 runes_us = 0.0;
+    for (isize i = 0; i < CY_STATIC_ARR_LEN(backends); i++) {
+        Tokenizer setup = tokenizer_init(src);
+        setup.backend = backends[i];
+        f64 us;
+        if (!bench_tokenize(a, &setup, &reference, &us)) {
+            cy_printf_err("erro: tokens diferentes com %s\n", names[i]);
+            token_list_free(a, &reference);
+            return false;
+        }
+
+        if (backends[i] == TOKENIZER_BACKEND_RUNES) {
+            runes_us = us;
+        }
+
+        bench_print_tokenize_row(shape, src, names[i], us, runes_us);
+    }
+
+    token_list_free(a, &reference);
+    return true;
+}
+
+// NOTE(cya): best tokenize time (in us) with chunks lexed on thread_count
+// threads (or sequentially, if there'd be a single chunk)
+static b32 bench_tokenize_chunked(
+    CyAllocator a, String src, const TokenList *reference, isize thread_count,
+    f64 *best_us_out, isize *chunk_count_out
+) {
+    CyArena arena = cy_arena_init(a, 0);
+    CyAllocator temp = cy_arena_allocator(&arena);
+
+    b32 ok = true;
+    f64 best_us = F64_MAX, elapsed_us = 0.0;
+    for (isize i = 0; ok && elapsed_us < BENCH_MIN_TIME_US; i++) {
+        Tokenizer t = tokenizer_init(src);
+
+        CyTicks start = cy_ticks_query();
+        TokenList list = {0};
+        isize chunk_count = tokenize_parallel(temp, &t, thread_count, &list);
+        if (chunk_count == 0) {
+            chunk_count = 1;
+            list = tokenize(temp, &t);
+        }
+
+        CyTicks elapsed = cy_ticks_elapsed(start, cy_ticks_query());
+        f64 us = cy_ticks_to_time_unit(elapsed, CY_MICROSECONDS);
+        best_us = CY_MIN(best_us, us);
+        elapsed_us += us;
+
+        ok = t.err == T_ERR_NONE && token_lists_are_equal(&list, reference);
+        *chunk_count_out = chunk_count;
+
+        cy_free_all(temp);
+    }
+
+    cy_arena_deinit(&arena);
+    *best_us_out = best_us;
+    return ok;
+}
+
+static b32 bench_tokenize_scaling(
+    CyAllocator a, BenchShape shape, String src, isize max_threads
+) {
+    Tokenizer setup = tokenizer_init(src);
+    TokenList reference = tokenize(a, &setup);
+    if (setup.err != T_ERR_NONE) {
+        cy_printf_err("erro no programa gerado\n");
+        return false;
+    }
+
+    f64 base_us = 0.0;
+    for (isize threads = 1, next; threads <= max_threads; threads = next) {
+        f64 us;
+        isize chunks;
+        b32 ok = bench_tokenize_chunked(
+            a, src, &reference, threads, &us, &chunks
+        );
+        if (!ok) {
+            cy_printf_err("erro: tokens diferentes com %td threads\n", threads);
+            token_list_free(a, &reference);
+            return false;
+        }
+
+        if (threads == 1) {
+            base_us = us;
+        }
+
+        printf(
+            "%-10s %8.1fK %8td %8td %10.1f %8.2fx\n",
+            g_bench_shape_names[shape], src.len / 1024.0, threads, chunks,
+            size_in_mb(src.len) / (us / 1e6), base_us / us
+        );
+        fflush(stdout);
+
+        next = threads * 2;
+        if (threads < max_threads && next > max_threads) {
+            next = max_threads;
+        }
+    }
+
+    token_list_free(a, &reference);
+    return true;
+}
+
+/* -------------------------- Expression parsers ---------------------------- */
+// NOTE(cya): counts what the parser asks of the allocator it wraps
+typedef struct {
+    CyAllocator backing;
+    isize allocs;
+    isize frees;
+} BenchCountingAllocator;
+
+static CY_ALLOCATOR_PROC(bench_counting_allocator_proc)
+{
+    BenchCountingAllocator *c = allocator_data;
+    switch (type) {
+    case CY_ALLOCATION_ALLOC: {
+        c->allocs += 1;
+    } break;
+    case CY_ALLOCATION_FREE: {
+        c->frees += 1;
+    } break;
+    default: break;
+    }
+
+    return c->backing.proc(
+        c->backing.data, type, size, align, old_mem, old_size, flags
+    );
+}
+
+typedef struct {
+    f64 best_us;
+    isize allocs; // NOTE(cya): of a single parse
+    isize frees;
+    isize nodes; // NOTE(cya): in the finished tree
+    CyString il;
+} BenchExprResult;
+
+/* Parses the already lexed tokens with one expression backend, keeping the
+ * best time, and then checks and generates the IL of the tree once, so the
+ * backends can be compared by their output */
+static b32 bench_expr_backend(
+    CyAllocator a, String src, const TokenList *tokens,
+    ParserExprBackend backend, BenchExprResult *res_out
+) {
+    CyArena arena = cy_arena_init(a, 0);
+    CyAllocator temp = cy_arena_allocator(&arena);
+
+    BenchExprResult res = { .best_us = F64_MAX };
+    b32 ok = true;
+    f64 elapsed_us = 0.0;
+    for (isize i = 0; ok && elapsed_us < BENCH_MIN_TIME_US; i++) {
+        BenchCountingAllocator counting = { .backing = temp };
+        CyAllocator ast_allocator = {
+            .proc = bench_counting_allocator_proc,
+            .data = &counting,
+        };
+        Tokenizer t = tokenizer_init(src);
+
+        CyTicks start = cy_ticks_query();
+        Parser p = parser_init(temp, &t, tokens, PARSER_STACK_INIT_CAP);
+        p.expr_backend = backend;
+        Ast ast = parse(ast_allocator, &p);
+        CyTicks elapsed = cy_ticks_elapsed(start, cy_ticks_query());
+        f64 us = cy_ticks_to_time_unit(elapsed, CY_MICROSECONDS);
+        res.best_us = CY_MIN(res.best_us, us);
+        elapsed_us += us;
+
+        ok = p.err.kind == P_ERR_NONE;
+        if (ok && i == 0) {
+            res.allocs = counting.allocs;
+            res.frees = counting.frees;
+            res.nodes = ast_node_count(ast.root);
+
+            res.il = cy_string_create_reserve(a, IL_SINK_CHUNK_SIZE);
+            IlSink out = il_sink_init(temp, il_sink_backend_string(&res.il));
+            ok = check(&ast).err == C_ERR_NONE;
+            if (ok) {
+                IlGenerator gen = il_generator_init(temp, temp, &ast, &out);
+                il_generate(&gen);
+            }
+
+            ok = il_sink_deinit(&out) && ok && res.il != NULL;
+        }
+
+        cy_free_all(temp);
+    }
+
+    cy_arena_deinit(&arena);
+    if (!ok) {
+        cy_string_free(res.il);
+        res.il = NULL;
+    }
+
+    *res_out = res;
+    return ok;
+}
+
+// NOTE(cya): the LL(1) table against precedence climbing for expressions
+static b32 bench_expr(CyAllocator a, BenchShape shape, String src)
+{
+    TokenList tokens;
+    if (!bench_reference_tokens(a, src, &tokens)) {
+        return false;
+    }
+
+    const char *names[] = { "table", "climbing" };
+    ParserExprBackend backends[] = {
+        PARSER_EXPR_TABLE, PARSER_EXPR_CLIMBING,
+    };
+    BenchExprResult results[CY_STATIC_ARR_LEN(backends)] = {0};
+    b32 ok = true;
+    for (isize i = 0; ok && i < CY_STATIC_ARR_LEN(backends); i++) {
+        BenchExprResult *r = &results[i];
+        ok = bench_expr_backend(a, src, &tokens, backends[i], r);
+        if (!ok) {
+            cy_printf_err("erro no programa gerado com %s\n", names[i]);
+            break;
+        }
+
+        if (i > 0 && !cy_string_are_equal(r->il, results[0].il)) {
+            cy_printf_err("erro: código diferente com %s\n", names[i]);
+            ok = false;
+            break;
+        }
+
+        printf(
+            "%-10s %8.1fK %8s %10td %10td %10td %10.1f %8.2fx\n",
+            g_bench_shape_names[shape], src.len / 1024.0, names[i],
+            r->allocs, r->frees, r->nodes,
+            size_in_mb(src.len) / (r->best_us / 1e6),
+            results[0].best_us / r->best_us
+        );
+        fflush(stdout);
+    }
+
+    for (isize i = 0; i < CY_STATIC_ARR_LEN(results); i++) {
+        cy_string_free(results[i].il);
+    }
+
+    token_list_free(a, &tokens);
+    return ok;
+}
+
+/* ---------------------------- Syntax-only parse --------------------------- */
+typedef struct {
+    const char *name;
+    b32 syntax_only;
+    b32 pre_lexed; // NOTE(cya): or pulled from the tokenizer as it goes
+} BenchSyntaxMode;
+
+static const BenchSyntaxMode g_bench_syntax_modes[] = {
+    { "parse", false, true },
+    { "syntax", true, true },
+    { "lex+syn", true, false },
+};
+
+/* Best time (in us) to parse the source in one mode, and what a single parse
+ * asks of the allocator besides the parser stack */
+static b32 bench_syntax_mode(
+    CyAllocator a, String src, const TokenList *tokens,
+    const BenchSyntaxMode *mode, f64 *best_us_out, isize *allocs_out
+) {
+    CyArena arena = cy_arena_init(a, 0);
+    CyAllocator temp = cy_arena_allocator(&arena);
+
+    b32 ok = true;
+    f64 best_us = F64_MAX, elapsed_us = 0.0;
+    for (isize i = 0; ok && elapsed_us < BENCH_MIN_TIME_US; i++) {
+        BenchCountingAllocator counting = { .backing = temp };
+        CyAllocator ast_allocator = {
+            .proc = bench_counting_allocator_proc,
+            .data = &counting,
+        };
+        Tokenizer t = tokenizer_init(src);
+        const TokenList *list = mode->pre_lexed ? tokens : NULL;
+
+        CyTicks start = cy_ticks_query();
+        Parser p = parser_init(temp, &t, list, PARSER_STACK_INIT_CAP);
+        if (mode->syntax_only) {
+            parse_syntax_only(ast_allocator, &p);
+        } else {
+            parse(ast_allocator, &p);
+        }
+        CyTicks elapsed = cy_ticks_elapsed(start, cy_ticks_query());
+        f64 us = cy_ticks_to_time_unit(elapsed, CY_MICROSECONDS);
+        best_us = CY_MIN(best_us, us);
+        elapsed_us += us;
+
+        ok = p.err.kind == P_ERR_NONE;
+        *allocs_out = counting.allocs;
+
+        cy_free_all(temp);
+    }
+
+    cy_arena_deinit(&arena);
+    *best_us_out = best_us;
+    return ok;
+}
+
+// NOTE(cya): building the AST against only recognizing the program
+static b32 bench_syntax(CyAllocator a, BenchShape shape, String src)
+{
+    TokenList tokens;
+    if (!bench_reference_tokens(a, src, &tokens)) {
+        return false;
+    }
+
+    b32 ok = true;
+    f64 base_us = 0.0;
+    for (isize i = 0; ok && i < CY_STATIC_ARR_LEN(g_bench_syntax_modes); i++) {
+        const BenchSyntaxMode *mode = &g_bench_syntax_modes[i];
+        f64 us;
+        isize allocs;
+        ok = bench_syntax_mode(a, src, &tokens, mode, &us, &allocs);
+        if (!ok) {
+            cy_printf_err("erro no programa gerado com %s\n", mode->name);
+            break;
+        }
+
+        base_us = i == 0 ? us : base_us;
+        printf(
+            "%-10s %8.1fK %8s %10td %10.1f %8.2fx\n",
+            g_bench_shape_names[shape], src.len / 1024.0, mode->name, allocs,
+            size_in_mb(src.len) / (us / 1e6), base_us / us
+        );
+        fflush(stdout);
+    }
+
+    token_list_free(a, &tokens);
+    return ok;
+}
+
+/* --------------------------- Incremental edits ---------------------------- */
+#define BENCH_EDIT_COUNT 500
+
+/* Types a space before a token and deletes it, over and over, updating the
+ * tokens with tokenizer_edit and checking them against a full tokenize after
+ * every edit. Prints the average time per edit against a full tokenize. The
+ * edits keep the source free of lexical errors: the tokens stop at the first
+ * one, so an edit that fixes it has to lex the rest of the source again */
+static b32 bench_edits(CyAllocator a, BenchShape shape, String src_view)
+{
+    CyString src = cy_string_create_view(a, src_view);
+    Tokenizer t = tokenizer_init(cy_string_view_create(src));
+    TokenList list = tokenize(a, &t);
+    if (src == NULL || t.err != T_ERR_NONE || list.len < 2) {
+        cy_printf_err("erro no programa gerado\n");
+        cy_string_free(src);
+        token_list_free(a, &list);
+        return false;
+    }
+
+    f64 full_us;
+    Tokenizer setup = tokenizer_init(cy_string_view_create(src));
+    b32 ok = bench_tokenize(a, &setup, &list, &full_us);
+
+    f64 edit_us = 0.0;
+    isize relexed = 0, edit_count = 0;
+    for (isize i = 0; ok && i < BENCH_EDIT_COUNT; i++) {
+        // NOTE(cya): spread over the whole source, skipping EOF
+        Token tok = token_list_get(&list, (i * 2654435761u) % (list.len - 1));
+        SourceEdit edits[] = {
+            { .offset = tok.offset, .text = cy_string_view_create_c(" ") },
+            { .offset = tok.offset, .len = 1 },
+        };
+        for (isize e = 0; ok && e < CY_STATIC_ARR_LEN(edits); e++) {
+            src = source_apply_edit(src, edits[e]);
+            if (src == NULL) {
+                ok = false;
+                break;
+            }
+
+            Tokenizer edited = tokenizer_init(cy_string_view_create(src));
+            CyTicks start = cy_ticks_query();
+            relexed += tokenizer_edit(a, &edited, &list, edits[e]);
+            CyTicks elapsed = cy_ticks_elapsed(start, cy_ticks_query());
+            edit_us += cy_ticks_to_time_unit(elapsed, CY_MICROSECONDS);
+            edit_count += 1;
+
+            Tokenizer full = tokenizer_init(cy_string_view_create(src));
+            TokenList reference = tokenize(a, &full);
+            ok = edited.err == full.err &&
+                token_lists_are_equal(&list, &reference);
+            token_list_free(a, &reference);
+        }
+    }
+
+    if (ok) {
+        f64 us = edit_us / edit_count;
+        printf(
+            "%-10s %8.1fK %8td %10.1f %10.2f %10.1f %9.0fx\n",
+            g_bench_shape_names[shape], src_view.len / 1024.0, edit_count,
+            (f64)relexed / edit_count, us, full_us, full_us / us
+        );
+        fflush(stdout);
+    } else {
+        cy_printf_err("erro: tokens diferentes após uma edição\n");
+    }
+
+    cy_string_free(src);
+    token_list_free(a, &list);
+    return ok;
+}
+
+/* ---------------------------- Lexical recovery ---------------------------- */
+static void bench_print_recover_row(
+    BenchShape shape, String src, const char *kind, isize error_count,
+    f64 recover_us, f64 serial_us
+) {
+    printf(
+        "%-10s %8.1fK %8s %8td %10.1f %10.1f %9.1fx\n",
+        g_bench_shape_names[shape], src.len / 1024.0, kind, error_count,
+        recover_us, serial_us, serial_us / recover_us
+    );
+    fflush(stdout);
+}
+
+#define BENCH_RECOVER_ERROR_EVERY 1000 // NOTE(cya): in words of the source
+
+/* Turns the first letter of one in every BENCH_RECOVER_ERROR_EVERY words into
+ * a $ (an invalid symbol, which recovery skips along with the rest of the
+ * word) and times finding them all with tokenize_recovering against the loop
+ * it replaces: lexing up to the first error, fixing it and lexing again, until
+ * there are none left */
+static b32 bench_recover(CyAllocator a, BenchShape shape, String src_view)
+{
+    TokenList reference;
+    if (!bench_reference_tokens(a, src_view, &reference)) {
+        return false;
+    }
+
+    CyString src = cy_string_create_view(a, src_view);
+    isize max_errors = reference.len / BENCH_RECOVER_ERROR_EVERY + 1;
+    u32 *bad_offsets = cy_alloc_array(a, u32, max_errors);
+    if (src == NULL || bad_offsets == NULL) {
+        cy_string_free(src);
+        cy_free(a, bad_offsets);
+        token_list_free(a, &reference);
+        return false;
+    }
+
+    isize error_count = 0, words = 0;
+    for (isize i = 0; i < reference.len; i++) {
+        TokenKind kind = reference.kinds[i];
+        b32 is_word = kind == C_TOKEN_IDENT ||
+            (kind > C_TOKEN__KEYWORD_BEGIN && kind < C_TOKEN__KEYWORD_END);
+        if (is_word && words++ % BENCH_RECOVER_ERROR_EVERY == 0) {
+            bad_offsets[error_count++] = reference.offsets[i];
+            src[reference.offsets[i]] = '$';
+        }
+    }
+
+    String view = cy_string_view_create(src);
+    CyArena arena = cy_arena_init(a, 0);
+    CyAllocator temp = cy_arena_allocator(&arena);
+
+    b32 ok = true;
+    f64 recover_us = F64_MAX, elapsed_us = 0.0;
+    for (isize i = 0; ok && elapsed_us < BENCH_MIN_TIME_US; i++) {
+        Tokenizer t = tokenizer_init(view);
+        TokenList list = {0};
+        LexDiagnostics diags = {0};
+
+        CyTicks start = cy_ticks_query();
+        ok = tokenize_recovering(temp, &t, &list, &diags);
+        CyTicks elapsed = cy_ticks_elapsed(start, cy_ticks_query());
+        f64 us = cy_ticks_to_time_unit(elapsed, CY_MICROSECONDS);
+        recover_us = CY_MIN(recover_us, us);
+        elapsed_us += us;
+
+        // NOTE(cya): each bad word comes out as one invalid token
+        ok = ok && diags.len == error_count && list.len == reference.len;
+        for (isize e = 0; ok && e < diags.len; e++) {
+            ok = diags.items[e].err == T_ERR_INVALID_SYMBOL &&
+                diags.items[e].bad_tok.offset == bad_offsets[e];
+        }
+
+        cy_free_all(temp);
+    }
+
+    // NOTE(cya): each pass stops at the first error left, which then gets
+    // fixed, and the last one finds none
+    f64 serial_us = 0.0;
+    for (isize e = 0; ok && e <= error_count; e++) {
+        Tokenizer t = tokenizer_init(view);
+
+        CyTicks start = cy_ticks_query();
+        tokenize(temp, &t);
+        CyTicks elapsed = cy_ticks_elapsed(start, cy_ticks_query());
+        serial_us += cy_ticks_to_time_unit(elapsed, CY_MICROSECONDS);
+
+        if (e < error_count) {
+            u32 offset = bad_offsets[e];
+            ok = t.err == T_ERR_INVALID_SYMBOL && t.bad_tok.offset == offset;
+            src[offset] = src_view.text[offset];
+        } else {
+            ok = t.err == T_ERR_NONE;
+        }
+
+        cy_free_all(temp);
+    }
+
+    if (ok) {
+        bench_print_recover_row(
+            shape, src_view, "lexical", error_count, recover_us, serial_us
+        );
+    } else {
+        cy_printf_err("erro: erros léxicos diferentes dos inseridos\n");
+    }
+
+    cy_arena_deinit(&arena);
+    cy_free(a, bad_offsets);
+    cy_string_free(src);
+    token_list_free(a, &reference);
+    return ok;
+}
+
+/* ---------------------------- Syntax recovery ----------------------------- */
+/* Turns the first ; after one in every BENCH_RECOVER_ERROR_EVERY words into a
+ * ) (a syntax error, after which panic mode skips to the next ;, which is left
+ * alone) and times finding them all with a recovering parse (as --all-errors
+ * does) against parsing up to the first error, fixing it and parsing again */
+static b32 bench_recover_syntax(
+    CyAllocator a, BenchShape shape, String src_view
+) {
+    TokenList reference;
+    if (!bench_reference_tokens(a, src_view, &reference)) {
+        return false;
+    }
+
+    CyString src = cy_string_create_view(a, src_view);
+    isize max_errors = reference.len / BENCH_RECOVER_ERROR_EVERY + 1;
+    u32 *bad_offsets = cy_alloc_array(a, u32, max_errors);
+    if (src == NULL || bad_offsets == NULL) {
+        cy_string_free(src);
+        cy_free(a, bad_offsets);
+        token_list_free(a, &reference);
+        return false;
+    }
+
+    isize error_count = 0, words = 0, kept = 1;
+    b32 pending = false;
+    for (isize i = 0; i < reference.len; i++) {
+        TokenKind kind = reference.kinds[i];
+        b32 is_word = kind == C_TOKEN_IDENT ||
+            (kind > C_TOKEN__KEYWORD_BEGIN && kind < C_TOKEN__KEYWORD_END);
+        if (is_word && words++ % BENCH_RECOVER_ERROR_EVERY == 0) {
+            pending = true;
+        } else if (kind == C_TOKEN_SEMICOLON && pending && kept > 0) {
+            bad_offsets[error_count++] = reference.offsets[i];
+            src[reference.offsets[i]] = ')';
+            pending = false;
+            kept = 0;
+        } else if (kind == C_TOKEN_SEMICOLON) {
+            kept += 1;
+        }
+    }
+
+    String view = cy_string_view_create(src);
+    CyArena arena = cy_arena_init(a, 0);
+    CyAllocator temp = cy_arena_allocator(&arena);
+
+    b32 ok = true;
+    f64 recover_us = F64_MAX, elapsed_us = 0.0;
+    for (isize i = 0; ok && elapsed_us < BENCH_MIN_TIME_US; i++) {
+        Tokenizer t = tokenizer_init(view);
+
+        CyTicks start = cy_ticks_query();
+        Parser p = parser_init(temp, &t, NULL, PARSER_STACK_INIT_CAP);
+        p.recover = true;
+        parse(temp, &p);
+        CyTicks elapsed = cy_ticks_elapsed(start, cy_ticks_query());
+        f64 us = cy_ticks_to_time_unit(elapsed, CY_MICROSECONDS);
+        recover_us = CY_MIN(recover_us, us);
+        elapsed_us += us;
+
+        // NOTE(cya): each ) is one error, and nothing else is
+        ok = p.errors.len == error_count;
+        for (isize e = 0; ok && e < p.errors.len; e++) {
+            ok = p.errors.items[e].found.offset == bad_offsets[e];
+        }
+
+        cy_free_all(temp);
+    }
+
+    f64 serial_us = 0.0;
+    for (isize e = 0; ok && e <= error_count; e++) {
+        Tokenizer t = tokenizer_init(view);
+
+        CyTicks start = cy_ticks_query();
+        Parser p = parser_init(temp, &t, NULL, PARSER_STACK_INIT_CAP);
+        parse(temp, &p);
+        CyTicks elapsed = cy_ticks_elapsed(start, cy_ticks_query());
+        serial_us += cy_ticks_to_time_unit(elapsed, CY_MICROSECONDS);
+
+        if (e < error_count) {
+            u32 offset = bad_offsets[e];
+            ok = p.err.kind != P_ERR_NONE && p.err.found.offset == offset;
+            src[offset] = ';';
+        } else {
+            ok = p.err.kind == P_ERR_NONE;
+        }
+
+        cy_free_all(temp);
+    }
+
+    if (ok) {
+        bench_print_recover_row(
+            shape, src_view, "syntax", error_count, recover_us, serial_us
+        );
+    } else {
+        cy_printf_err("erro: erros sintáticos diferentes dos inseridos\n");
+    }
+
+    cy_arena_deinit(&arena);
+    cy_free(a, bad_offsets);
+    cy_string_free(src);
+    token_list_free(a, &reference);
+    return ok;
+}
+
+/* -------------------------- Parallel compilation -------------------------- */
+#define BENCH_MAX_THREADS 256
+
+// NOTE(cya): each worker compiles the same source with its own context
+typedef struct {
+    pthread_t thread;
+    String src;
+    CyString expected; // NOTE(cya): IL every compilation must reproduce
+    f64 min_time_us;
+    isize compiles;
+    b32 ok;
+} BenchWorker;
+
+static void *bench_worker_run(void *data)
+{
+    BenchWorker *w = data;
+    CompilerContext ctx = compiler_context_init(cy_heap_allocator());
+    CyTicks start = cy_ticks_query();
+    f64 elapsed_us = 0.0;
+
+    w->ok = true;
+    while (w->ok && elapsed_us < w->min_time_us) {
+        CompilerOutput output = compile_with_context(&ctx, w->src, NULL, NULL);
+        w->ok = output.code != NULL &&
+            cy_string_are_equal(output.code, w->expected);
+        compiler_output_free(&output);
+
+        w->compiles += 1;
+        CyTicks elapsed = cy_ticks_elapsed(start, cy_ticks_query());
+        elapsed_us = cy_ticks_to_time_unit(elapsed, CY_MICROSECONDS);
+    }
+
+    compiler_context_deinit(&ctx);
+    return NULL;
+}
+
+// NOTE(cya): aggregate throughput (in MB/s) of thread_count parallel workers
+static b32 bench_run_parallel(
+    String src, CyString expected, isize thread_count, f64 *mb_per_s_out
+) {
+    BenchWorker workers[BENCH_MAX_THREADS] = {0};
+    CyTicks start = cy_ticks_query();
+    isize started = 0;
+    for (; started < thread_count; started++) {
+        BenchWorker *w = &workers[started];
+        w->src = src;
+        w->expected = expected;
+        w->min_time_us = BENCH_MIN_TIME_US;
+        if (pthread_create(&w->thread, NULL, bench_worker_run, w) != 0) {
+            break;
+        }
+    }
+
+    b32 ok = started == thread_count;
+    isize compiles = 0;
+    for (isize i = 0; i < started; i++) {
+        pthread_join(workers[i].thread, NULL);
+        ok = ok && workers[i].ok;
+        compiles += workers[i].compiles;
+    }
+
+    CyTicks elapsed = cy_ticks_elapsed(start, cy_ticks_query());
+    f64 elapsed_s = cy_ticks_to_time_unit(elapsed, CY_SECONDS);
+    *mb_per_s_out = size_in_mb(src.len * compiles) / elapsed_s;
+    return ok;
+}
+
+static b32 bench_scaling(
+    CyAllocator a, BenchShape shape, String src, isize max_threads
+) {
+    CompilerOutput reference = compile(a, src);
+    if (reference.code == NULL) {
+        cy_printf_err("erro no programa gerado: %s\n", reference.msg);
+        compiler_output_free(&reference);
+        return false;
+    }
+
+    f64 base_mb_per_s = 0.0;
+    for (isize threads = 1, next; threads <= max_threads; threads = next) {
+        f64 mb_per_s;
+        if (!bench_run_parallel(src, reference.code, threads, &mb_per_s)) {
+            cy_printf_err(
+                "erro: saída diferente (ou falha) com %td threads\n", threads
+            );
+            compiler_output_free(&reference);
+            return false;
+        }
+
+        if (threads == 1) {
+            base_mb_per_s = mb_per_s;
+        }
+
+        printf(
+            "%-10s %8.1fK %8td %10.1f %8.2fx\n", g_bench_shape_names[shape],
+            src.len / 1024.0, threads, mb_per_s, mb_per_s / base_mb_per_s
+        );
+        fflush(stdout);
+
+        // NOTE(cya): powers of two, then max_threads itself
+        next = threads * 2;
+        if (threads < max_threads && next > max_threads) {
+            next = max_threads;
+        }
+    }
+
+    compiler_output_free(&reference);
+    return true;
+}
+
+/* ------------------------------ Driver ------------------------------------ */
+static isize parse_size(const char *str)
+{
+    char *end = NULL;
+    f64 val = strtod(str, &end);
+    switch (*end) {
+    case 'k':
+    case 'K': {
+        val *= 1024.0;
+    } break;
+    case 'm':
+    case 'M': {
+        val *= 1024.0 * 1024.0;
+    } break;
+    case '\0': break;
+    default: return -1;
+    }
+
+    return val > 0 ? (isize)val : -1;
+}
+
+static void print_usage(const char *program)
+{
+    cy_printf_err(
+        "uso: %s [--shape NOME] [--max-size N] [--size N] [--emit] "
+        "[--threads N] [--classify] [--scan] [--dfa] "
+        "[--tokenize-threads N] [--edit] [--recover] [--expr] [--syntax]\n",
+        program
+    );
+    cy_printf_err("  formas:");
+    for (isize i = 0; i < BENCH_SHAPE_COUNT; i++) {
+        cy_printf_err(" %s", g_bench_shape_names[i]);
+    }
+
+    cy_printf_err("\n  tamanhos aceitam os sufixos K e M (ex.: 512K, 10M)\n");
+    cy_printf_err("  --emit imprime o programa gerado em vez de medi-lo\n");
+    cy_printf_err(
+        "  --threads mede a vazão de 1 até N compilações em paralelo "
+        "(com --size, ou 100K por padrão)\n"
+    );
+    cy_printf_err(
+        "  --classify mede o custo de classificar palavras "
+        "(palavras reservadas e identificadores)\n"
+    );
+    cy_printf_err(
+        "  --scan mede o tokenize com cada conjunto de kernels de varredura "
+        "(com --size, ou 1M por padrão)\n"
+    );
+    cy_printf_err(
+        "  --dfa compara o tokenize atual com o baseado em tabelas (DFA) "
+        "(com --size, ou 1M por padrão)\n"
+    );
+    cy_printf_err(
+        "  --tokenize-threads mede o tokenize em blocos de 1 até N threads "
+        "(com --size, ou 10M por padrão)\n"
+    );
+    cy_printf_err(
+        "  --edit compara o tokenize incremental de pequenas edições com o "
+        "tokenize completo (com --size, ou 1M por padrão)\n"
+    );
+    cy_printf_err(
+        "  --recover compara achar todos os erros léxicos (e sintáticos) "
+        "numa passada com "
+        "corrigi-los um a um (com --size, ou 1M por padrão)\n"
+    );
+    cy_printf_err(
+        "  --expr compara o parse de expressões pela tabela LL(1) com o por "
+        "precedência (com --size, ou 1M por padrão)\n"
+    );
+    cy_printf_err(
+        "  --syntax compara o parse completo com só a verificação da sintaxe, "
+        "sem AST (com --size, ou 1M por padrão)\n"
+    );
+}
+
+int main(int argc, char **argv)
+{
+    isize sizes[] = {
+        1 << 10, 10 << 10, 100 << 10, 1 << 20, 10 << 20, 100 << 20,
+    };
+    isize size_count = CY_STATIC_ARR_LEN(sizes);
+    isize max_size = ISIZE_MAX;
+    i32 only_shape = -1;
+    isize max_threads = 0, max_tokenize_threads = 0;
+    b32 emit = false, classify = false, scan = false, dfa = false;
+    b32 edit = false, recover = false, expr = false, syntax = false;
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        b32 has_val = i + 1 < argc;
+        if (strcmp(arg, "--shape") == 0 && has_val) {
+            const char *name = argv[++i];
+            for (isize s = 0; s < BENCH_SHAPE_COUNT; s++) {
+                if (strcmp(name, g_bench_shape_names[s]) == 0) {
+                    only_shape = s;
+                }
+            }
+
+            if (only_shape < 0) {
+                print_usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+        } else if (strcmp(arg, "--max-size") == 0 && has_val) {
+            max_size = parse_size(argv[++i]);
+        } else if (strcmp(arg, "--size") == 0 && has_val) {
+            sizes[0] = max_size = parse_size(argv[++i]);
+            size_count = 1;
+        } else if (strcmp(arg, "--emit") == 0) {
+            emit = true;
+        } else if (strcmp(arg, "--classify") == 0) {
+            classify = true;
+        } else if (strcmp(arg, "--scan") == 0) {
+            scan = true;
+        } else if (strcmp(arg, "--dfa") == 0) {
+            dfa = true;
+        } else if (strcmp(arg, "--edit") == 0) {
+            edit = true;
+        } else if (strcmp(arg, "--recover") == 0) {
+            recover = true;
+        } else if (strcmp(arg, "--expr") == 0) {
+            expr = true;
+        } else if (strcmp(arg, "--syntax") == 0) {
+            syntax = true;
+        } else if (strcmp(arg, "--tokenize-threads") == 0 && has_val) {
+            max_tokenize_threads = atoi(argv[++i]);
+            b32 valid = max_tokenize_threads >= 1 &&
+                max_tokenize_threads <= TOKENIZE_MAX_THREADS;
+            if (!valid) {
+                print_usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+        } else if (strcmp(arg, "--threads") == 0 && has_val) {
+            max_threads = atoi(argv[++i]);
+            if (max_threads < 1 || max_threads > BENCH_MAX_THREADS) {
+                print_usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+        } else {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+
+        if (max_size < 0) {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    CyAllocator a = cy_heap_allocator();
+    if (emit) {
+        BenchShape shape = only_shape < 0 ? BENCH_DECLS : only_shape;
+        CyString src = bench_generate(a, shape, sizes[0], &g_default_params);
+        fwrite(src, 1, cy_string_len(src), stdout);
+        cy_string_free(src);
+        return EXIT_SUCCESS;
+    }
+
+    if (classify) {
+        return bench_classification(a) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if (scan || dfa) {
+        isize size = size_count == 1 ? sizes[0] : 1 << 20;
+        printf(
+            "%-10s %9s %8s %10s %9s\n",
+            "shape", "size", scan ? "kernels" : "backend", "MB/s", "speedup"
+        );
+        for (isize shape = 0; shape < BENCH_SHAPE_COUNT; shape++) {
+            if (only_shape >= 0 && shape != only_shape) {
+                continue;
+            }
+
+            CyString src = bench_generate(a, shape, size, &g_default_params);
+            b32 ok = src != NULL;
+            if (ok) {
+                String view = cy_string_view_create(src);
+                ok = scan ? bench_scan_kernels(a, shape, view) :
+                    bench_dfa(a, shape, view);
+            }
+
+            cy_string_free(src);
+            if (!ok) {
+                return EXIT_FAILURE;
+            }
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    if (edit) {
+        isize size = size_count == 1 ? sizes[0] : 1 << 20;
+        printf(
+            "%-10s %9s %8s %10s %10s %10s %10s\n", "shape", "size", "edits",
+            "tokens", "us/edit", "full_us", "speedup"
+        );
+        for (isize shape = 0; shape < BENCH_SHAPE_COUNT; shape++) {
+            if (only_shape >= 0 && shape != only_shape) {
+                continue;
+            }
+
+            CyString src = bench_generate(a, shape, size, &g_default_params);
+            b32 ok = src != NULL &&
+                bench_edits(a, shape, cy_string_view_create(src));
+            cy_string_free(src);
+            if (!ok) {
+                return EXIT_FAILURE;
+            }
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    if (recover) {
+        isize size = size_count == 1 ? sizes[0] : 1 << 20;
+        printf(
+            "%-10s %9s %8s %8s %10s %10s %10s\n", "shape", "size", "kind",
+            "errors", "recover_us", "serial_us", "speedup"
+        );
+        for (isize shape = 0; shape < BENCH_SHAPE_COUNT; shape++) {
+            if (only_shape >= 0 && shape != only_shape) {
+                continue;
+            }
+
+            CyString src = bench_generate(a, shape, size, &g_default_params);
+            b32 ok = src != NULL &&
+                bench_recover(a, shape, cy_string_view_create(src)) &&
+                bench_recover_syntax(a, shape, cy_string_view_create(src));
+            cy_string_free(src);
+            if (!ok) {
+                return EXIT_FAILURE;
+            }
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    if (expr) {
+        isize size = size_count == 1 ? sizes[0] : 1 << 20;
+        printf(
+            "%-10s %9s %8s %10s %10s %10s %10s %9s\n", "shape", "size",
+            "backend", "allocs", "frees", "nodes", "MB/s", "speedup"
+        );
+        for (isize shape = 0; shape < BENCH_SHAPE_COUNT; shape++) {
+            if (only_shape >= 0 && shape != only_shape) {
+                continue;
+            }
+
+            CyString src = bench_generate(a, shape, size, &g_default_params);
+            b32 ok = src != NULL &&
+                bench_expr(a, shape, cy_string_view_create(src));
+            cy_string_free(src);
+            if (!ok) {
+                return EXIT_FAILURE;
+            }
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    if (syntax) {
+        isize size = size_count == 1 ? sizes[0] : 1 << 20;
+        printf(
+            "%-10s %9s %8s %10s %10s %9s\n", "shape", "size", "mode",
+            "allocs", "MB/s", "speedup"
+        );
+        for (isize shape = 0; shape < BENCH_SHAPE_COUNT; shape++) {
+            if (only_shape >= 0 && shape != only_shape) {
+                continue;
+            }
+
+            CyString src = bench_generate(a, shape, size, &g_default_params);
+            b32 ok = src != NULL &&
+                bench_syntax(a, shape, cy_string_view_create(src));
+            cy_string_free(src);
+            if (!ok) {
+                return EXIT_FAILURE;
+            }
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    if (max_tokenize_threads > 0) {
+        isize size = size_count == 1 ? sizes[0] : 10 << 20;
+        printf(
+            "%-10s %9s %8s %8s %10s %9s\n",
+            "shape", "size", "threads", "chunks", "MB/s", "speedup"
+        );
+        for (isize shape = 0; shape < BENCH_SHAPE_COUNT; shape++) {
+            if (only_shape >= 0 && shape != only_shape) {
+                continue;
+            }
+
+            CyString src = bench_generate(a, shape, size, &g_default_params);
+            b32 ok = src != NULL && bench_tokenize_scaling(
+                a, shape, cy_string_view_create(src), max_tokenize_threads
+            );
+            cy_string_free(src);
+            if (!ok) {
+                return EXIT_FAILURE;
+            }
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    if (max_threads > 0) {
+        isize size = size_count == 1 ? sizes[0] : 100 << 10;
+        printf(
+            "%-10s %9s %8s %10s %9s\n",
+            "shape", "size", "threads", "MB/s", "speedup"
+        );
+        for (isize shape = 0; shape < BENCH_SHAPE_COUNT; shape++) {
+            if (only_shape >= 0 && shape != only_shape) {
+                continue;
+            }
+
+            CyString src = bench_generate(a, shape, size, &g_default_params);
+            b32 ok = src != NULL && bench_scaling(
+                a, shape, cy_string_view_create(src), max_threads
+            );
+            cy_string_free(src);
+            if (!ok) {
+                return EXIT_FAILURE;
+            }
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    bench_print_header();
+    for (isize shape = 0; shape < BENCH_SHAPE_COUNT; shape++) {
+        if (only_shape >= 0 && shape != only_shape) {
+            continue;
+        }
+
+        isize prev_len = 0;
+        for (isize i = 0; i < size_count && sizes[i] <= max_size; i++) {
+            isize size = sizes[i];
+            CyString src = bench_generate(a, shape, size, &g_default_params);
+            if (src == NULL) {
+                cy_printf_err("erro ao gerar programa de %td bytes\n", size);
+                return EXIT_FAILURE;
+            } else if (cy_string_len(src) == prev_len) {
+                // NOTE(cya): a single chunk of this shape is already larger
+                cy_string_free(src);
+                continue;
+            }
+
+            prev_len = cy_string_len(src);
+
+            BenchResult res;
+            b32 ok = bench_run(a, cy_string_view_create(src), &res);
+            cy_string_free(src);
+            if (!ok) {
+                return EXIT_FAILURE;
+            }
+
+            bench_print_row(shape, &res);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,1384 @@
+#define COMPILER_GEN
+#include "compiler.c"
+
+#include <stdlib.h>
+
+/* ------------------------------ Keywords ---------------------------------- */
+#define KEYWORD_GEN_MAX_BITS 8
+#define KEYWORD_GEN_TRIES 0x100000
+
+// NOTE(cya): fixed LCG, so the same keywords always give the same table
+static inline u32 gen_next_candidate(u32 *state)
+{
+    *state = *state * 1664525u + 1013904223u;
+    return *state | 1; // NOTE(cya): odd multipliers keep every key bit
+}
+
+static inline u32 gen_keyword_slot(String keyword, u32 mul, isize bits)
+{
+    return (KEYWORD_HASH_KEY(keyword) * mul) >> (32 - bits);
+}
+
+/* Looks for the smallest table (and a multiplier for it) where every keyword
+ * lands in its own slot */
+static b32 gen_keyword_hash(u32 *mul_out, isize *bits_out)
+{
+    isize min_bits = 0;
+    while (((isize)1 << min_bits) < KEYWORD_COUNT) {
+        min_bits += 1;
+    }
+
+    for (isize bits = min_bits; bits <= KEYWORD_GEN_MAX_BITS; bits++) {
+        u32 state = 0x2024;
+        for (isize try = 0; try < KEYWORD_GEN_TRIES; try++) {
+            u32 mul = gen_next_candidate(&state);
+            u8 used[1 << KEYWORD_GEN_MAX_BITS] = {0};
+            b32 collided = false;
+            for (isize i = C_TOKEN__KEYWORD_BEGIN + 1;
+                i < C_TOKEN__KEYWORD_END && !collided; i++) {
+                u32 slot = gen_keyword_slot(g_token_strings[i], mul, bits);
+                collided = used[slot];
+                used[slot] = true;
+            }
+
+            if (!collided) {
+                *mul_out = mul;
+                *bits_out = bits;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+static int gen_keywords(void)
+{
+    isize min_len = ISIZE_MAX, max_len = 0;
+    for (isize i = C_TOKEN__KEYWORD_BEGIN + 1; i < C_TOKEN__KEYWORD_END; i++) {
+        String keyword = g_token_strings[i];
+        if (keyword.len < 2) {
+            cy_printf_err(
+                "erro: palavra reservada curta demais para o hash (%.*s)\n",
+                STRING_ARG(keyword)
+            );
+            return EXIT_FAILURE;
+        }
+
+        min_len = CY_MIN(min_len, keyword.len);
+        max_len = CY_MAX(max_len, keyword.len);
+    }
+
+    u32 mul;
+    isize bits;
+    if (!gen_keyword_hash(&mul, &bits)) {
+        cy_printf_err("erro: nenhum hash perfeito encontrado\n");
+        return EXIT_FAILURE;
+    }
+
+    isize slots[1 << KEYWORD_GEN_MAX_BITS] = {0};
+    for (isize i = C_TOKEN__KEYWORD_BEGIN + 1; i < C_TOKEN__KEYWORD_END; i++) {
+        slots[gen_keyword_slot(g_token_strings[i], mul, bits)] = i;
+    }
+
+    // NOTE(cya): the lookup must agree with the linear scan for every slot
+    for (isize i = C_TOKEN__KEYWORD_BEGIN + 1; i < C_TOKEN__KEYWORD_END; i++) {
+        String keyword = g_token_strings[i];
+        u32 slot = gen_keyword_slot(keyword, mul, bits);
+        if (slots[slot] != i || keyword_lookup(keyword) != (TokenKind)i) {
+            cy_printf_err("erro: tabela inconsistente (%.*s)\n",
+                STRING_ARG(keyword));
+            return EXIT_FAILURE;
+        }
+    }
+
+    printf("// NOTE(cya): generated by compiler_gen.c (./build.sh gen), ");
+    printf("do not edit\n");
+    printf("#ifndef _COMPILER_KEYWORDS_H\n");
+    printf("#define _COMPILER_KEYWORDS_H\n\n");
+    printf("#define KEYWORD_GEN_BEGIN %d\n", C_TOKEN__KEYWORD_BEGIN);
+    printf("#define KEYWORD_GEN_COUNT %d\n", KEYWORD_COUNT);
+    printf("#define KEYWORD_GEN_MIN_LEN %td\n", min_len);
+    printf("#define KEYWORD_GEN_MAX_LEN %td\n\n", max_len);
+    printf("#define KEYWORD_HASH_MUL 0x%08Xu\n", mul);
+    printf("#define KEYWORD_HASH_BITS %td\n\n", bits);
+    printf("// NOTE(cya): token kind in each slot (0 means empty)\n");
+    printf("static const u8 g_keyword_slots[1 << KEYWORD_HASH_BITS] = {\n");
+    for (isize i = 0; i < ((isize)1 << bits); i++) {
+        if (slots[i] == 0) {
+            printf("    0,\n");
+        } else {
+            String keyword = g_token_strings[slots[i]];
+            printf("    %td, // %.*s\n", slots[i], STRING_ARG(keyword));
+        }
+    }
+
+    printf("};\n\n");
+    printf("#endif // _COMPILER_KEYWORDS_H\n");
+    return EXIT_SUCCESS;
+}
+
+/* ------------------------------ Lexer DFA --------------------------------- */
+/* The lexical rules, in priority order (keywords and symbols come first, as
+ * literals from g_token_strings). The token regexes are the ones in README.md,
+ * except for comments, which follow what the tokenizer actually accepts (one
+ * line feed can both open and close an empty comment). The remaining rules
+ * match the whitespace that's skipped and the lexical errors, so that, with
+ * longest match, every input has exactly one reading */
+typedef struct {
+    isize label;
+    const char *regex;
+} DfaRule;
+
+static const DfaRule g_dfa_rules[] = {
+    { C_TOKEN_IDENT, "[ifbs]_([A-Z]|[a-z][A-Z]?)(([a-z]|[0-9])[A-Z]?)*" },
+    { C_TOKEN_INTEGER, "0|[1-9][0-9]*" },
+    { C_TOKEN_FLOAT, "(0|[1-9][0-9]*),[0-9](0*[1-9]+)*" },
+    { C_TOKEN_STRING, "\"([^\\n\"%]|%x)*\"" },
+    { C_TOKEN_COMMENT, ">@[\\r\\n]([^@]*[\\r\\n])?@<" },
+    { DFA_WHITESPACE, "[ \\t\\r\\n\\v\\f]+" },
+    { DFA_ERR_KEYWORD, "[a-z][a-zA-Z]*" },
+    { DFA_ERR_IDENT, "[a-zA-Z][a-zA-Z0-9_]*" },
+    { DFA_ERR_STRING_FORMAT, "\"([^\\n\"%]|%x)*%[^x]" },
+    { DFA_ERR_STRING_NEWLINE, "\"([^\\n\"%]|%x)*\\n" },
+    { DFA_ERR_STRING_EOF, "\"([^\\n\"%]|%x)*%?" },
+    { DFA_ERR_COMMENT, ">@[^@]*@?" },
+    { DFA_ERR_SYMBOL, "." },
+};
+
+#define NFA_MAX_STATES 0x1000
+#define NFA_SET_WORDS (NFA_MAX_STATES / 64)
+#define DFA_MAX_STATES 0x400
+
+/* Thompson NFA: a state either moves on a byte in set (to next) or has up to
+ * two epsilon moves; rule ends are marked with the rule's priority */
+typedef struct {
+    u8 set[32];
+    i32 next;
+    i32 eps[2];
+    i32 rule; // NOTE(cya): -1 unless the state accepts
+} NfaState;
+
+typedef struct {
+    i32 start;
+    i32 end; // NOTE(cya): has no moves until joined to something else
+} NfaFrag;
+
+static NfaState g_nfa[NFA_MAX_STATES];
+static isize g_nfa_count;
+
+static i32 nfa_new_state(void)
+{
+    if (g_nfa_count >= NFA_MAX_STATES) {
+        cy_printf_err("erro: NFA grande demais\n");
+        exit(EXIT_FAILURE);
+    }
+
+    NfaState *s = &g_nfa[g_nfa_count];
+    *s = (NfaState){ .next = -1, .eps = { -1, -1 }, .rule = -1 };
+    return (i32)g_nfa_count++;
+}
+
+static inline void nfa_set_add(NfaState *s, u8 c)
+{
+    s->set[c >> 3] |= 1 << (c & 7);
+}
+
+static inline b32 nfa_set_has(const NfaState *s, u8 c)
+{
+    return (s->set[c >> 3] >> (c & 7)) & 1;
+}
+
+static NfaFrag nfa_byte_set(const u8 set[32])
+{
+    NfaFrag f = { nfa_new_state(), nfa_new_state() };
+    cy_mem_copy(g_nfa[f.start].set, set, 32);
+    g_nfa[f.start].next = f.end;
+    return f;
+}
+
+static NfaFrag nfa_concat(NfaFrag a, NfaFrag b)
+{
+    g_nfa[a.end].eps[0] = b.start;
+    return (NfaFrag){ a.start, b.end };
+}
+
+typedef struct {
+    const char *cur;
+    const char *regex;
+} RegexParser;
+
+static void regex_fail(const RegexParser *p, const char *msg)
+{
+    cy_printf_err(
+        "erro: %s em /%s/ (posição %td)\n", msg, p->regex, p->cur - p->regex
+    );
+    exit(EXIT_FAILURE);
+}
+
+static u8 regex_parse_char(RegexParser *p)
+{
+    u8 c = *p->cur++;
+    if (c == '\0') {
+        regex_fail(p, "fim inesperado");
+    } else if (c != '\\') {
+        return c;
+    }
+
+    c = *p->cur++;
+    switch (c) {
+    case 'n': return '\n';
+    case 'r': return '\r';
+    case 't': return '\t';
+    case 'v': return '\v';
+    case 'f': return '\f';
+    case '\0': regex_fail(p, "escape incompleto"); break;
+    default: break;
+    }
+
+    return c;
+}
+
+static NfaFrag regex_parse_alt(RegexParser *p);
+
+static NfaFrag regex_parse_atom(RegexParser *p)
+{
+    u8 set[32] = {0};
+    NfaState tmp = {0};
+    switch (*p->cur) {
+    case '(': {
+        p->cur += 1;
+        NfaFrag f = regex_parse_alt(p);
+        if (*p->cur++ != ')') {
+            regex_fail(p, "falta )");
+        }
+
+        return f;
+    } break;
+    case '.': {
+        p->cur += 1;
+        cy_mem_set(set, 0xFF, sizeof(set));
+        return nfa_byte_set(set);
+    } break;
+    case '[': {
+        p->cur += 1;
+        b32 negate = *p->cur == '^';
+        p->cur += negate;
+        do {
+            u8 lo = regex_parse_char(p), hi = lo;
+            if (*p->cur == '-' && p->cur[1] != ']') {
+                p->cur += 1;
+                hi = regex_parse_char(p);
+            }
+
+            for (isize c = lo; c <= hi; c++) {
+                nfa_set_add(&tmp, (u8)c);
+            }
+        } while (*p->cur != ']');
+
+        p->cur += 1;
+        for (isize i = 0; i < 32; i++) {
+            set[i] = negate ? ~tmp.set[i] : tmp.set[i];
+        }
+
+        return nfa_byte_set(set);
+    } break;
+    default: {
+        nfa_set_add(&tmp, regex_parse_char(p));
+        return nfa_byte_set(tmp.set);
+    } break;
+    }
+}
+
+static NfaFrag regex_parse_repeat(RegexParser *p)
+{
+    NfaFrag f = regex_parse_atom(p);
+    for (;;) {
+        char op = *p->cur;
+        if (op != '*' && op != '+' && op != '?') {
+            return f;
+        }
+
+        p->cur += 1;
+        i32 end = nfa_new_state();
+        if (op == '+') {
+            g_nfa[f.end].eps[0] = f.start;
+            g_nfa[f.end].eps[1] = end;
+            f = (NfaFrag){ f.start, end };
+            continue;
+        }
+
+        i32 start = nfa_new_state();
+        g_nfa[start].eps[0] = f.start;
+        g_nfa[start].eps[1] = end;
+        g_nfa[f.end].eps[0] = op == '*' ? f.start : end;
+        g_nfa[f.end].eps[1] = op == '*' ? end : -1;
+        f = (NfaFrag){ start, end };
+    }
+}
+
+static NfaFrag regex_parse_concat(RegexParser *p)
+{
+    i32 empty = nfa_new_state();
+    NfaFrag f = { empty, empty };
+    while (*p->cur != '\0' && *p->cur != '|' && *p->cur != ')') {
+        f = nfa_concat(f, regex_parse_repeat(p));
+    }
+
+    return f;
+}
+
+static NfaFrag regex_parse_alt(RegexParser *p)
+{
+    NfaFrag f = regex_parse_concat(p);
+    while (*p->cur == '|') {
+        p->cur += 1;
+        NfaFrag g = regex_parse_concat(p);
+        NfaFrag alt = { nfa_new_state(), nfa_new_state() };
+        g_nfa[alt.start].eps[0] = f.start;
+        g_nfa[alt.start].eps[1] = g.start;
+        g_nfa[f.end].eps[0] = alt.end;
+        g_nfa[g.end].eps[0] = alt.end;
+        f = alt;
+    }
+
+    return f;
+}
+
+static NfaFrag nfa_literal(String str)
+{
+    i32 empty = nfa_new_state();
+    NfaFrag f = { empty, empty };
+    for (isize i = 0; i < str.len; i++) {
+        NfaState tmp = {0};
+        nfa_set_add(&tmp, str.text[i]);
+        f = nfa_concat(f, nfa_byte_set(tmp.set));
+    }
+
+    return f;
+}
+
+// NOTE(cya): labels of each rule (literals first), indexed by priority
+static isize g_rule_labels[C_TOKEN_COUNT + CY_STATIC_ARR_LEN(g_dfa_rules)];
+static isize g_rule_count;
+
+// NOTE(cya): chains rule onto the start state with a new epsilon fork
+static i32 nfa_add_rule(i32 start, NfaFrag rule, isize label)
+{
+    g_nfa[rule.end].rule = (i32)g_rule_count;
+    g_rule_labels[g_rule_count++] = label;
+
+    i32 fork = nfa_new_state();
+    g_nfa[start].eps[0] = rule.start;
+    g_nfa[start].eps[1] = fork;
+    return fork;
+}
+
+static i32 nfa_build(void)
+{
+    i32 start = nfa_new_state(), tail = start;
+    for (isize i = C_TOKEN__OPERATOR_BEGIN + 1; i < C_TOKEN__KEYWORD_END; i++) {
+        if (g_token_strings[i].len > 0) {
+            tail = nfa_add_rule(tail, nfa_literal(g_token_strings[i]), i);
+        }
+    }
+
+    for (isize i = 0; i < CY_STATIC_ARR_LEN(g_dfa_rules); i++) {
+        RegexParser p = { g_dfa_rules[i].regex, g_dfa_rules[i].regex };
+        NfaFrag f = regex_parse_alt(&p);
+        if (*p.cur != '\0') {
+            regex_fail(&p, "caractere inesperado");
+        }
+
+        tail = nfa_add_rule(tail, f, g_dfa_rules[i].label);
+    }
+
+    return start;
+}
+
+typedef struct {
+    u64 bits[NFA_SET_WORDS];
+} NfaSet;
+
+static void nfa_closure(NfaSet *set)
+{
+    i32 stack[NFA_MAX_STATES];
+    isize top = 0;
+    for (isize i = 0; i < g_nfa_count; i++) {
+        if ((set->bits[i / 64] >> (i % 64)) & 1) {
+            stack[top++] = (i32)i;
+        }
+    }
+
+    while (top > 0) {
+        NfaState *s = &g_nfa[stack[--top]];
+        for (isize e = 0; e < 2; e++) {
+            i32 to = s->eps[e];
+            if (to >= 0 && !((set->bits[to / 64] >> (to % 64)) & 1)) {
+                set->bits[to / 64] |= (u64)1 << (to % 64);
+                stack[top++] = to;
+            }
+        }
+    }
+}
+
+/* Subset construction; state 0 is the dead state (the empty set) and state 1
+ * the start state */
+static NfaSet g_dfa_sets[DFA_MAX_STATES];
+static i32 g_dfa_next[DFA_MAX_STATES][256];
+static isize g_dfa_label[DFA_MAX_STATES];
+static isize g_dfa_count;
+
+static i32 dfa_find_or_add(const NfaSet *set)
+{
+    for (isize i = 0; i < g_dfa_count; i++) {
+        if (cy_mem_compare(&g_dfa_sets[i], set, sizeof(*set)) == 0) {
+            return (i32)i;
+        }
+    }
+
+    if (g_dfa_count >= DFA_MAX_STATES) {
+        cy_printf_err("erro: DFA grande demais\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // NOTE(cya): the highest priority rule wins among the accepting states
+    isize best = -1;
+    for (isize i = 0; i < g_nfa_count; i++) {
+        b32 in_set = (set->bits[i / 64] >> (i % 64)) & 1;
+        i32 rule = g_nfa[i].rule;
+        if (in_set && rule >= 0 && (best < 0 || rule < best)) {
+            best = rule;
+        }
+    }
+
+    g_dfa_sets[g_dfa_count] = *set;
+    g_dfa_label[g_dfa_count] = best < 0 ? 0 : g_rule_labels[best];
+    return (i32)g_dfa_count++;
+}
+
+static void dfa_build(i32 nfa_start)
+{
+    NfaSet dead = {0}, start = {0};
+    dfa_find_or_add(&dead);
+    start.bits[nfa_start / 64] |= (u64)1 << (nfa_start % 64);
+    nfa_closure(&start);
+    dfa_find_or_add(&start);
+
+    for (isize d = 0; d < g_dfa_count; d++) {
+        for (isize c = 0; c < 256; c++) {
+            NfaSet move = {0};
+            for (isize i = 0; i < g_nfa_count; i++) {
+                b32 in_set = (g_dfa_sets[d].bits[i / 64] >> (i % 64)) & 1;
+                NfaState *s = &g_nfa[i];
+                if (in_set && s->next >= 0 && nfa_set_has(s, (u8)c)) {
+                    move.bits[s->next / 64] |= (u64)1 << (s->next % 64);
+                }
+            }
+
+            nfa_closure(&move);
+            g_dfa_next[d][c] = dfa_find_or_add(&move);
+        }
+    }
+}
+
+/* Moore's algorithm: states start split by label and are split again while
+ * any byte takes them to different groups; the dead and start states keep
+ * groups 0 and 1 */
+static isize dfa_minimize(i32 group_out[DFA_MAX_STATES])
+{
+    static i32 sig[DFA_MAX_STATES][257];
+    i32 group[DFA_MAX_STATES];
+    for (isize d = 0; d < g_dfa_count; d++) {
+        group[d] = (i32)g_dfa_label[d];
+    }
+
+    isize group_count = 0;
+    for (;;) {
+        for (isize d = 0; d < g_dfa_count; d++) {
+            sig[d][0] = group[d];
+            for (isize c = 0; c < 256; c++) {
+                sig[d][c + 1] = group[g_dfa_next[d][c]];
+            }
+        }
+
+        isize new_count = 0;
+        i32 new_group[DFA_MAX_STATES];
+        for (isize d = 0; d < g_dfa_count; d++) {
+            new_group[d] = -1;
+            for (isize e = 0; e < d; e++) {
+                if (cy_mem_compare(sig[d], sig[e], sizeof(sig[d])) == 0) {
+                    new_group[d] = new_group[e];
+                    break;
+                }
+            }
+
+            if (new_group[d] < 0) {
+                new_group[d] = (i32)new_count++;
+            }
+        }
+
+        cy_mem_copy(group, new_group, sizeof(group));
+        if (new_count == group_count) {
+            break;
+        }
+
+        group_count = new_count;
+    }
+
+    // NOTE(cya): groups are numbered in order of their first state, so the
+    // dead state is in group 0 and the start state in group 1
+    CY_ASSERT(group[0] == 0 && group[1] == 1);
+    cy_mem_copy(group_out, group, sizeof(group));
+    return group_count;
+}
+
+static void gen_print_u8_table(const i32 *vals, isize count, isize indent)
+{
+    isize col = 0;
+    for (isize i = 0; i < count; i++) {
+        if (col == 0) {
+            printf("%*s", (int)indent, "");
+            col = indent;
+        }
+
+        col += printf("%d,", vals[i]);
+        if (i + 1 == count || col > 72) {
+            printf("\n");
+            col = 0;
+        } else {
+            col += printf(" ");
+        }
+    }
+}
+
+static int gen_dfa(void)
+{
+    i32 nfa_start = nfa_build();
+    dfa_build(nfa_start);
+
+    static i32 group[DFA_MAX_STATES];
+    isize state_count = dfa_minimize(group);
+
+    // NOTE(cya): a representative (original) state for each group
+    i32 repr[DFA_MAX_STATES];
+    for (isize d = g_dfa_count - 1; d >= 0; d--) {
+        repr[group[d]] = (i32)d;
+    }
+
+    // NOTE(cya): bytes with the same column of transitions share a class
+    i32 byte_class[256], class_byte[256];
+    isize class_count = 0;
+    for (isize c = 0; c < 256; c++) {
+        byte_class[c] = -1;
+        for (isize k = 0; k < class_count && byte_class[c] < 0; k++) {
+            b32 same = true;
+            for (isize g = 0; g < state_count && same; g++) {
+                const i32 *next = g_dfa_next[repr[g]];
+                same = group[next[c]] == group[next[class_byte[k]]];
+            }
+
+            if (same) {
+                byte_class[c] = (i32)k;
+            }
+        }
+
+        if (byte_class[c] < 0) {
+            class_byte[class_count] = (i32)c;
+            byte_class[c] = (i32)class_count++;
+        }
+    }
+
+    if (state_count > U8_MAX || DFA_LABEL_COUNT > U8_MAX) {
+        cy_printf_err("erro: DFA não cabe em tabelas de u8\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("// NOTE(cya): generated by compiler_gen.c (./build.sh gen), ");
+    printf("do not edit\n");
+    printf("#ifndef _COMPILER_DFA_H\n");
+    printf("#define _COMPILER_DFA_H\n\n");
+    printf("#define DFA_GEN_LABEL_COUNT %d\n", DFA_LABEL_COUNT);
+    printf("#define DFA_STATE_COUNT %td\n", state_count);
+    printf("#define DFA_CLASS_COUNT %td\n\n", class_count);
+    printf("static const u8 g_dfa_byte_class[256] = {\n");
+    gen_print_u8_table(byte_class, 256, 4);
+    printf("};\n\n");
+
+    printf("// NOTE(cya): DfaLabel (or TokenKind) of each state, 0 if none\n");
+    printf("static const u8 g_dfa_accept[DFA_STATE_COUNT] = {\n");
+    i32 labels[DFA_MAX_STATES];
+    for (isize g = 0; g < state_count; g++) {
+        labels[g] = (i32)g_dfa_label[repr[g]];
+    }
+
+    gen_print_u8_table(labels, state_count, 4);
+    printf("};\n\n");
+
+    printf("static const u8 g_dfa_next[DFA_STATE_COUNT][DFA_CLASS_COUNT] = ");
+    printf("{\n");
+    for (isize g = 0; g < state_count; g++) {
+        i32 row[256];
+        for (isize k = 0; k < class_count; k++) {
+            row[k] = group[g_dfa_next[repr[g]][class_byte[k]]];
+        }
+
+        printf("    {\n");
+        gen_print_u8_table(row, class_count, 8);
+        printf("    },\n");
+    }
+
+    printf("};\n\n");
+    printf("#endif // _COMPILER_DFA_H\n");
+    return EXIT_SUCCESS;
+}
+
+/* --------------------------- Powers of five ------------------------------- */
+/* The 128-bit significands of 5^q that the Eisel-Lemire float conversion
+ * multiplies by, worked out with plain big integers */
+#define POW5_GEN_MIN_EXP -342
+#define POW5_GEN_MAX_EXP 308
+#define POW5_GEN_LIMBS 64
+
+// NOTE(cya): little-endian base 2^32 digits, len of them in use
+typedef struct {
+    u32 d[POW5_GEN_LIMBS];
+    isize len;
+} GenBig;
+
+static inline void gen_big_trim(GenBig *a)
+{
+    while (a->len > 0 && a->d[a->len - 1] == 0) {
+        a->len -= 1;
+    }
+}
+
+static isize gen_big_bit_len(const GenBig *a)
+{
+    if (a->len == 0) {
+        return 0;
+    }
+
+    isize bits = (a->len - 1) * 32;
+    for (u32 top = a->d[a->len - 1]; top != 0; top >>= 1) {
+        bits += 1;
+    }
+
+    return bits;
+}
+
+static void gen_big_mul_small(GenBig *a, u32 n)
+{
+    u64 carry = 0;
+    for (isize i = 0; i < a->len; i++) {
+        carry += (u64)a->d[i] * n;
+        a->d[i] = (u32)carry;
+        carry >>= 32;
+    }
+
+    if (carry != 0) {
+        a->d[a->len++] = (u32)carry;
+    }
+}
+
+static void gen_big_shl(GenBig *a, isize n)
+{
+    isize words = n / 32, bits = n % 32;
+    isize len = a->len + words + 1;
+    for (isize i = len - 1; i >= 0; i--) {
+        isize src = i - words;
+        u64 hi = src >= 0 && src < a->len ? a->d[src] : 0;
+        u64 lo = src >= 1 && src - 1 < a->len ? a->d[src - 1] : 0;
+        a->d[i] = (u32)(((hi << 32 | lo) << bits) >> 32);
+    }
+
+    a->len = len;
+    gen_big_trim(a);
+}
+
+static void gen_big_shr(GenBig *a, isize n)
+{
+    isize words = n / 32, bits = n % 32;
+    for (isize i = 0; i < a->len; i++) {
+        isize src = i + words;
+        u64 lo = src < a->len ? a->d[src] : 0;
+        u64 hi = src + 1 < a->len ? a->d[src + 1] : 0;
+        a->d[i] = (u32)((hi << 32 | lo) >> bits);
+    }
+
+    gen_big_trim(a);
+}
+
+static int gen_big_compare(const GenBig *a, const GenBig *b)
+{
+    if (a->len != b->len) {
+        return a->len < b->len ? -1 : 1;
+    }
+
+    for (isize i = a->len - 1; i >= 0; i--) {
+        if (a->d[i] != b->d[i]) {
+            return a->d[i] < b->d[i] ? -1 : 1;
+        }
+    }
+
+    return 0;
+}
+
+// NOTE(cya): a -= b, with a >= b
+static void gen_big_sub(GenBig *a, const GenBig *b)
+{
+    i64 borrow = 0;
+    for (isize i = 0; i < a->len; i++) {
+        i64 diff = (i64)a->d[i] - (i < b->len ? b->d[i] : 0) - borrow;
+        borrow = diff < 0;
+        a->d[i] = (u32)(diff + (borrow << 32));
+    }
+
+    gen_big_trim(a);
+}
+
+// NOTE(cya): floor(2^b / p), by long division one bit at a time
+static GenBig gen_big_pow2_div(isize b, const GenBig *p)
+{
+    GenBig quot = {0}, rem = {0};
+    for (isize i = b; i >= 0; i--) {
+        gen_big_shl(&rem, 1);
+        if (i == b) {
+            rem = (GenBig){ .d = {1}, .len = 1 };
+        }
+
+        if (gen_big_compare(&rem, p) >= 0) {
+            gen_big_sub(&rem, p);
+            quot.d[i / 32] |= (u32)1 << (i % 32);
+            quot.len = CY_MAX(quot.len, i / 32 + 1);
+        }
+    }
+
+    return quot;
+}
+
+/* 5^q shifted into [2^127, 2^128): truncated for q >= 0, and one more than
+ * the truncated reciprocal for q < 0 (so it's never too small) */
+static GenBig gen_pow5_significand(isize q)
+{
+    GenBig pow5 = { .d = {1}, .len = 1 };
+    for (isize i = 0; i < (q < 0 ? -q : q); i++) {
+        gen_big_mul_small(&pow5, 5);
+    }
+
+    GenBig sig = pow5;
+    if (q < 0) {
+        isize z = gen_big_bit_len(&pow5);
+        sig = gen_big_pow2_div(q >= -27 ? z + 127 : 2 * z + 128, &pow5);
+
+        GenBig one = { .d = {1}, .len = 1 };
+        isize len = sig.len;
+        sig.d[len] = 0;
+        sig.len = len + 1;
+        for (isize i = 0; i < sig.len; i++) {
+            u64 sum = (u64)sig.d[i] + (i < one.len ? one.d[i] : 0);
+            one = (GenBig){ .d = {(u32)(sum >> 32)}, .len = 1 };
+            sig.d[i] = (u32)sum;
+        }
+
+        gen_big_trim(&sig);
+    }
+
+    isize bits = gen_big_bit_len(&sig);
+    if (bits < 128) {
+        gen_big_shl(&sig, 128 - bits);
+    } else if (bits > 128) {
+        gen_big_shr(&sig, bits - 128);
+    }
+
+    return sig;
+}
+
+static int gen_pow5(void)
+{
+    printf("// NOTE(cya): generated by compiler_gen.c (./build.sh gen), ");
+    printf("do not edit\n");
+    printf("#ifndef _COMPILER_POW5_H\n");
+    printf("#define _COMPILER_POW5_H\n\n");
+    printf("#define POW5_GEN_MIN_EXP %d\n", POW5_GEN_MIN_EXP);
+    printf("#define POW5_GEN_MAX_EXP %d\n\n", POW5_GEN_MAX_EXP);
+    printf("// NOTE(cya): high and low halves of 5^q, from POW5_GEN_MIN_EXP\n");
+    printf("static const u64 g_pow5_128[][2] = {\n");
+    for (isize q = POW5_GEN_MIN_EXP; q <= POW5_GEN_MAX_EXP; q++) {
+        GenBig sig = gen_pow5_significand(q);
+        if (gen_big_bit_len(&sig) != 128) {
+            cy_printf_err("erro: 5^%td não tem 128 bits\n", q);
+            return EXIT_FAILURE;
+        }
+
+        u64 hi = (u64)sig.d[3] << 32 | sig.d[2];
+        u64 lo = (u64)sig.d[1] << 32 | sig.d[0];
+        printf(
+            "    {0x%016llx, 0x%016llx},\n",
+            (unsigned long long)hi, (unsigned long long)lo
+        );
+    }
+
+    printf("};\n\n");
+    printf("#endif // _COMPILER_POW5_H\n");
+    return EXIT_SUCCESS;
+}
+
+/* ------------------------------ LL(1) table ------------------------------- */
+/* The productions are read from GRAMMAR_RULES in compiler.c: names in angle
+ * brackets are non-terminals (from g_non_terminal_strings), anything else a
+ * terminal (from g_token_strings, quoted or not), and a lone î the empty
+ * string */
+#define LL1_GEN_MAX_RHS 8
+#define LL1_CLOSURE_SIM_CAP 0x40
+#define LL1_CLOSURE_POOL_CAP 0x1000
+
+typedef struct {
+    NonTerminal lhs;
+    const char *rhs;
+} GrammarText;
+
+static const GrammarText g_grammar_text[] = {
+#define GRAMMAR_RULE(e, n, s) [e - GR_0] = { n, s }
+    GRAMMAR_RULES
+#undef GRAMMAR_RULE
+};
+
+#define GRAMMAR_RULE_COUNT CY_STATIC_ARR_LEN(g_grammar_text)
+
+typedef struct {
+    NonTerminal lhs;
+    ParserSymbol rhs[LL1_GEN_MAX_RHS];
+    isize len;
+} GenProduction;
+
+/* The columns, in the order syntax errors list the expected terminals (the
+ * one the table had back when it was written by hand) */
+static const TokenKind g_ll1_gen_cols[] = {
+    C_TOKEN_IDENT, C_TOKEN_INTEGER, C_TOKEN_FLOAT, C_TOKEN_STRING,
+    C_TOKEN_SEMICOLON, C_TOKEN_COMMA, C_TOKEN_PAREN_OPEN, C_TOKEN_PAREN_CLOSE,
+    C_TOKEN_EQUALS, C_TOKEN_AND, C_TOKEN_OR, C_TOKEN_NOT, C_TOKEN_CMP_EQ,
+    C_TOKEN_CMP_NE, C_TOKEN_CMP_LT, C_TOKEN_CMP_GT, C_TOKEN_ADD, C_TOKEN_SUB,
+    C_TOKEN_MUL, C_TOKEN_DIV, C_TOKEN_MAIN, C_TOKEN_READ, C_TOKEN_TRUE,
+    C_TOKEN_FALSE, C_TOKEN_WRITE, C_TOKEN_WRITELN, C_TOKEN_IF, C_TOKEN_ELIF,
+    C_TOKEN_ELSE, C_TOKEN_END, C_TOKEN_REPEAT, C_TOKEN_WHILE, C_TOKEN_UNTIL,
+    C_TOKEN_EOF,
+};
+
+// NOTE(cya): sets of terminals are bit masks over TokenKind
+typedef u64 TerminalSet;
+CY_STATIC_ASSERT(C_TOKEN_COUNT <= 64);
+
+static inline b32 ll1_is_non_terminal(NonTerminal n)
+{
+    return g_non_terminal_strings[n].len > 0;
+}
+
+static b32 ll1_find_symbol(String name, ParserSymbol *sym_out)
+{
+    if (name.len > 2 && name.text[0] == '<') {
+        for (isize n = 0; n < NT_COUNT; n++) {
+            if (cy_string_view_are_equal(name, g_non_terminal_strings[n])) {
+                *sym_out = PARSER_SYMBOL_NON_TERMINAL + n;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    if (name.len > 2 && name.text[0] == '"' && name.text[name.len - 1] == '"') {
+        name.text += 1;
+        name.len -= 2;
+    }
+
+    for (isize k = C_TOKEN_EOF + 1; k < C_TOKEN_COUNT; k++) {
+        if (k != C_TOKEN_COMMENT &&
+            cy_string_view_are_equal(name, g_token_strings[k])) {
+            *sym_out = k;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static b32 ll1_read_rule(isize rule, GenProduction *p)
+{
+    const GrammarText *g = &g_grammar_text[rule];
+    *p = (GenProduction){ .lhs = g->lhs };
+
+    const char *cur = g->rhs;
+    b32 empty = false;
+    for (;;) {
+        while (*cur == ' ') {
+            cur += 1;
+        }
+
+        if (*cur == '\0') {
+            break;
+        }
+
+        const char *start = cur;
+        while (*cur != ' ' && *cur != '\0') {
+            cur += 1;
+        }
+
+        String name = cy_string_view_create_len(start, cur - start);
+        if (cy_string_view_are_equal(name, cy_string_view_create_c("î"))) {
+            empty = true;
+            continue;
+        }
+
+        ParserSymbol sym;
+        if (!ll1_find_symbol(name, &sym)) {
+            cy_printf_err(
+                "erro: símbolo desconhecido na regra GR_%td (%.*s)\n",
+                rule, STRING_ARG(name)
+            );
+            return false;
+        } else if (p->len == LL1_GEN_MAX_RHS) {
+            cy_printf_err("erro: regra GR_%td longa demais\n", rule);
+            return false;
+        }
+
+        p->rhs[p->len++] = sym;
+    }
+
+    if (empty == (p->len > 0)) {
+        cy_printf_err("erro: regra GR_%td mistura î com símbolos\n", rule);
+        return false;
+    } else if (!ll1_is_non_terminal(p->lhs)) {
+        cy_printf_err("erro: regra GR_%td sem não-terminal\n", rule);
+        return false;
+    }
+
+    return true;
+}
+
+/* FIRST of a string of symbols, and whether it can derive the empty string */
+static TerminalSet ll1_first_of(
+    const ParserSymbol *syms, isize len, const TerminalSet *first,
+    const b32 *nullable, b32 *nullable_out
+) {
+    TerminalSet set = 0;
+    for (isize i = 0; i < len; i++) {
+        if (parser_symbol_is_token(syms[i])) {
+            set |= (TerminalSet)1 << syms[i];
+            *nullable_out = false;
+            return set;
+        }
+
+        NonTerminal n = parser_symbol_non_terminal(syms[i]);
+        set |= first[n];
+        if (!nullable[n]) {
+            *nullable_out = false;
+            return set;
+        }
+    }
+
+    *nullable_out = true;
+    return set;
+}
+
+static void ll1_print_expected(const char *str)
+{
+    isize len = strlen(str);
+    while (len > 72) {
+        isize cut = 72;
+        while (cut > 0 && str[cut] != ' ') {
+            cut -= 1;
+        }
+
+        if (cut == 0) {
+            break;
+        }
+
+        printf("    \"%.*s\"\n", (int)(cut + 1), str);
+        str += cut + 1;
+        len -= cut + 1;
+    }
+
+    printf("    \"%s\",\n", str);
+}
+
+static int gen_ll1(void)
+{
+    static GenProduction rules[GRAMMAR_RULE_COUNT];
+    b32 has_rules[NT_COUNT] = {0};
+    for (isize r = 0; r < GRAMMAR_RULE_COUNT; r++) {
+        if (!ll1_read_rule(r, &rules[r])) {
+            return EXIT_FAILURE;
+        }
+
+        has_rules[rules[r].lhs] = true;
+    }
+
+    for (isize n = 0; n < NT_COUNT; n++) {
+        if (ll1_is_non_terminal(n) && !has_rules[n]) {
+            cy_printf_err("erro: %.*s não tem regras\n",
+                STRING_ARG(g_non_terminal_strings[n]));
+            return EXIT_FAILURE;
+        }
+    }
+
+    TerminalSet first[NT_COUNT] = {0}, follow[NT_COUNT] = {0};
+    b32 nullable[NT_COUNT] = {0};
+    follow[NT_START] = (TerminalSet)1 << C_TOKEN_EOF;
+    for (b32 changed = true; changed;) {
+        changed = false;
+        for (isize r = 0; r < GRAMMAR_RULE_COUNT; r++) {
+            const GenProduction *p = &rules[r];
+            b32 rhs_nullable;
+            TerminalSet set = ll1_first_of(
+                p->rhs, p->len, first, nullable, &rhs_nullable
+            );
+            if ((first[p->lhs] | set) != first[p->lhs] ||
+                (rhs_nullable && !nullable[p->lhs])) {
+                first[p->lhs] |= set;
+                nullable[p->lhs] |= rhs_nullable;
+                changed = true;
+            }
+
+            for (isize i = 0; i < p->len; i++) {
+                if (parser_symbol_is_token(p->rhs[i])) {
+                    continue;
+                }
+
+                NonTerminal n = parser_symbol_non_terminal(p->rhs[i]);
+                b32 rest_nullable;
+                TerminalSet rest = ll1_first_of(
+                    &p->rhs[i + 1], p->len - i - 1, first, nullable,
+                    &rest_nullable
+                );
+                if (rest_nullable) {
+                    rest |= follow[p->lhs];
+                }
+
+                if ((follow[n] | rest) != follow[n]) {
+                    follow[n] |= rest;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    // NOTE(cya): a rule goes in every column of its FIRST (and of its
+    // non-terminal's FOLLOW, if it derives î); two in a cell is a conflict
+    static i32 table[NT_COUNT][C_TOKEN_COUNT];
+    TerminalSet used = 0;
+    for (isize r = 0; r < GRAMMAR_RULE_COUNT; r++) {
+        const GenProduction *p = &rules[r];
+        b32 rhs_nullable;
+        TerminalSet set = ll1_first_of(
+            p->rhs, p->len, first, nullable, &rhs_nullable
+        );
+        if (rhs_nullable) {
+            set |= follow[p->lhs];
+        }
+
+        for (isize k = 0; k < C_TOKEN_COUNT; k++) {
+            if ((set >> k & 1) == 0) {
+                continue;
+            } else if (table[p->lhs][k] != GR_NONE) {
+                cy_printf_err(
+                    "erro: a gramática não é LL(1): %.*s com %.*s pode usar "
+                    "GR_%d ou GR_%td\n",
+                    STRING_ARG(g_non_terminal_strings[p->lhs]),
+                    STRING_ARG(g_token_strings[k]),
+                    table[p->lhs][k] - GR_0, r
+                );
+                return EXIT_FAILURE;
+            }
+
+            table[p->lhs][k] = (i32)(GR_0 + r);
+        }
+
+        for (isize i = 0; i < p->len; i++) {
+            if (parser_symbol_is_token(p->rhs[i])) {
+                used |= (TerminalSet)1 << p->rhs[i];
+            }
+        }
+    }
+
+    i32 col_from_kind[C_TOKEN_COUNT];
+    for (isize k = 0; k < C_TOKEN_COUNT; k++) {
+        col_from_kind[k] = -1;
+    }
+
+    isize col_count = CY_STATIC_ARR_LEN(g_ll1_gen_cols);
+    used |= (TerminalSet)1 << C_TOKEN_EOF;
+    for (isize c = 0; c < col_count; c++) {
+        TokenKind kind = g_ll1_gen_cols[c];
+        if ((used >> kind & 1) == 0 || col_from_kind[kind] >= 0) {
+            cy_printf_err("erro: coluna de %.*s fora da gramática\n",
+                STRING_ARG(g_token_strings[kind]));
+            return EXIT_FAILURE;
+        }
+
+        col_from_kind[kind] = (i32)c;
+    }
+
+    for (isize k = 0; k < C_TOKEN_COUNT; k++) {
+        if ((used >> k & 1) && col_from_kind[k] < 0) {
+            cy_printf_err("erro: %.*s não tem coluna\n",
+                STRING_ARG(g_token_strings[k]));
+            return EXIT_FAILURE;
+        } else if (col_from_kind[k] < 0) {
+            // NOTE(cya): no rule is ever chosen on these (see below)
+            col_from_kind[k] = col_from_kind[C_TOKEN_EOF];
+        }
+    }
+
+    for (isize n = 0; n < NT_COUNT; n++) {
+        if (table[n][C_TOKEN_EOF] != GR_NONE) {
+            cy_printf_err("erro: %.*s expande no EOF\n",
+                STRING_ARG(g_non_terminal_strings[n]));
+            return EXIT_FAILURE;
+        }
+    }
+
+    i32 row_from_kind[NT_COUNT] = {0};
+    isize row_count = 0;
+    for (isize n = 0; n < NT_COUNT; n++) {
+        if (ll1_is_non_terminal(n)) {
+            row_from_kind[n] = (i32)row_count++;
+        }
+    }
+
+    if (GRAMMAR_RULE_COUNT >= U8_MAX || row_count > U8_MAX ||
+        col_count > U8_MAX) {
+        cy_printf_err("erro: tabela LL(1) não cabe em u8\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("// NOTE(cya): generated by compiler_gen.c (./build.sh gen), ");
+    printf("do not edit\n");
+    printf("#ifndef _COMPILER_LL1_H\n");
+    printf("#define _COMPILER_LL1_H\n\n");
+    printf("#define LL1_GEN_RULE_COUNT %td\n", (isize)GRAMMAR_RULE_COUNT);
+    printf("#define LL1_GEN_NT_COUNT %d\n", NT_COUNT);
+    printf("#define LL1_GEN_TOKEN_COUNT %d\n", C_TOKEN_COUNT);
+    printf("#define LL1_ROW_COUNT %td\n", row_count);
+    printf("#define LL1_COL_COUNT %td\n\n", col_count);
+    printf("static const u8 g_ll1_row_from_kind[LL1_GEN_NT_COUNT] = {\n");
+    gen_print_u8_table(row_from_kind, NT_COUNT, 4);
+    printf("};\n\n");
+    printf("// NOTE(cya): terminals the grammar doesn't use get the EOF ");
+    printf("column, which\n// no rule expands on\n");
+    printf("static const u8 g_ll1_col_from_kind[LL1_GEN_TOKEN_COUNT] = {\n");
+    gen_print_u8_table(col_from_kind, C_TOKEN_COUNT, 4);
+    printf("};\n\n");
+
+    printf("// NOTE(cya): GrammarRule to expand (0 is a syntax error)\n");
+    printf("static const u8 g_ll1_table[LL1_ROW_COUNT][LL1_COL_COUNT] = {\n");
+    for (isize n = 0; n < NT_COUNT; n++) {
+        if (!ll1_is_non_terminal(n)) {
+            continue;
+        }
+
+        i32 row[CY_STATIC_ARR_LEN(g_ll1_gen_cols)];
+        for (isize c = 0; c < col_count; c++) {
+            row[c] = table[n][g_ll1_gen_cols[c]];
+        }
+
+        printf("    { // %.*s\n", STRING_ARG(g_non_terminal_strings[n]));
+        gen_print_u8_table(row, col_count, 8);
+        printf("    },\n");
+    }
+
+    printf("};\n\n");
+    printf("// NOTE(cya): the terminals each row has a rule for\n");
+    printf("static const char *const g_ll1_expected[LL1_ROW_COUNT] = {\n");
+    for (isize n = 0; n < NT_COUNT; n++) {
+        if (!ll1_is_non_terminal(n)) {
+            continue;
+        }
+
+        char expected[0x200] = {0};
+        isize len = 0;
+        for (isize c = 0; c < col_count; c++) {
+            TokenKind kind = g_ll1_gen_cols[c];
+            if (table[n][kind] != GR_NONE) {
+                String s = g_token_strings[kind];
+                len += snprintf(expected + len, sizeof(expected) - len,
+                    "%s%.*s", len > 0 ? " " : "", STRING_ARG(s));
+            }
+        }
+
+        printf("    // %.*s\n", STRING_ARG(g_non_terminal_strings[n]));
+        ll1_print_expected(expected);
+    }
+
+    printf("};\n\n");
+
+    i32 rhs_len[GRAMMAR_RULE_COUNT + 1] = {0};
+    isize rhs_max_len = 1;
+    for (isize r = 0; r < GRAMMAR_RULE_COUNT; r++) {
+        rhs_len[GR_0 + r] = (i32)rules[r].len;
+        rhs_max_len = CY_MAX(rhs_max_len, rules[r].len);
+    }
+
+    printf("#define LL1_RHS_MAX_LEN %td\n\n", rhs_max_len);
+    printf("// NOTE(cya): how many symbols each GrammarRule pushes\n");
+    printf("static const u8 g_ll1_rhs_len[LL1_GEN_RULE_COUNT + 1] = {\n");
+    gen_print_u8_table(rhs_len, GRAMMAR_RULE_COUNT + 1, 4);
+    printf("};\n\n");
+    printf("// NOTE(cya): and which (as ParserSymbol), the last one first\n");
+    printf("static const u16 g_ll1_rhs[LL1_GEN_RULE_COUNT + 1]");
+    printf("[LL1_RHS_MAX_LEN] = {\n");
+    printf("    { 0 }, // GR_NONE\n");
+    for (isize r = 0; r < GRAMMAR_RULE_COUNT; r++) {
+        const GenProduction *p = &rules[r];
+        printf("    { ");
+        for (isize i = p->len - 1; i >= 0; i--) {
+            printf("%d%s", p->rhs[i], i > 0 ? ", " : " ");
+        }
+
+        printf("%s}, // GR_%td\n", p->len == 0 ? "0 " : "", r);
+    }
+
+    printf("};\n\n");
+
+    // NOTE(cya): each non-terminal is expanded with the table, the way
+    // parser_recognize would, until there's a terminal on top that matches
+    // the lookahead (or the non-terminal derived î); equal entries share
+    // their place in the pool
+    static i32 closure[NT_COUNT][C_TOKEN_COUNT];
+    u64 derives_empty[CY_STATIC_ARR_LEN(g_ll1_gen_cols)] = {0};
+    static i32 pool[LL1_CLOSURE_POOL_CAP];
+    isize pool_len = 1, closure_max_len = 1; // NOTE(cya): 0 is no closure
+    for (isize n = 0; n < NT_COUNT; n++) {
+        if (!ll1_is_non_terminal(n)) {
+            continue;
+        }
+
+        for (isize c = 0; c < col_count; c++) {
+            TokenKind kind = g_ll1_gen_cols[c];
+            i32 sim[LL1_CLOSURE_SIM_CAP];
+            isize len = 0;
+            sim[len++] = PARSER_SYMBOL_NON_TERMINAL + (i32)n;
+            b32 failed = false;
+            while (!failed && len > 0 &&
+                !parser_symbol_is_token(sim[len - 1])) {
+                NonTerminal top = parser_symbol_non_terminal(sim[len - 1]);
+                i32 rule = table[top][kind];
+                failed = rule == GR_NONE;
+                if (failed) {
+                    continue;
+                }
+
+                len -= 1;
+                const GenProduction *p = &rules[rule - GR_0];
+                if (len + p->len > LL1_CLOSURE_SIM_CAP) {
+                    cy_printf_err("erro: expansão LL(1) profunda demais\n");
+                    return EXIT_FAILURE;
+                }
+
+                for (isize i = p->len - 1; i >= 0; i--) {
+                    sim[len++] = p->rhs[i];
+                }
+            }
+
+            if (failed || (len > 0 && sim[len - 1] != (i32)kind)) {
+                continue;
+            }
+
+            isize at = 1;
+            while (at < pool_len && (pool[at] != len ||
+                cy_mem_compare(&pool[at + 1], sim, len * sizeof(*sim)))) {
+                at += pool[at] + 1;
+            }
+
+            if (at == pool_len) {
+                if (pool_len + len + 1 > LL1_CLOSURE_POOL_CAP) {
+                    cy_printf_err("erro: expansões LL(1) demais\n");
+                    return EXIT_FAILURE;
+                }
+
+                pool[pool_len++] = (i32)len;
+                cy_mem_copy(&pool[pool_len], sim, len * sizeof(*sim));
+                pool_len += len;
+            }
+
+            closure[n][kind] = (i32)at;
+            closure_max_len = CY_MAX(closure_max_len, len);
+            if (len == 0) {
+                derives_empty[c] |= (u64)1 << n;
+            }
+        }
+    }
+
+    printf("#define LL1_CLOSURE_MAX_LEN %td\n\n", closure_max_len);
+    printf("/* NOTE(cya): what each non-terminal leaves on the stack once ");
+    printf("it's expanded\n * down to the lookahead (on top, to be ");
+    printf("matched), as an offset into\n * g_ll1_closure_syms, or 0 if ");
+    printf("it's a syntax error somewhere on the way */\n");
+    printf("static const u16 g_ll1_closure[LL1_ROW_COUNT][LL1_COL_COUNT] = ");
+    printf("{\n");
+    for (isize n = 0; n < NT_COUNT; n++) {
+        if (!ll1_is_non_terminal(n)) {
+            continue;
+        }
+
+        i32 row[CY_STATIC_ARR_LEN(g_ll1_gen_cols)];
+        for (isize c = 0; c < col_count; c++) {
+            row[c] = closure[n][g_ll1_gen_cols[c]];
+        }
+
+        printf("    { // %.*s\n", STRING_ARG(g_non_terminal_strings[n]));
+        gen_print_u8_table(row, col_count, 8);
+        printf("    },\n");
+    }
+
+    printf("};\n\n");
+    printf("/* NOTE(cya): a count, then that many symbols in the order ");
+    printf("they're pushed,\n * padded so LL1_CLOSURE_MAX_LEN can be read ");
+    printf("from any of them */\n");
+    printf("static const u16 g_ll1_closure_syms[%td + LL1_CLOSURE_MAX_LEN]",
+        pool_len);
+    printf(" = {\n");
+    printf("    0,\n");
+    for (isize at = 1; at < pool_len; at += pool[at] + 1) {
+        gen_print_u8_table(&pool[at], pool[at] + 1, 4);
+    }
+
+    printf("};\n\n");
+    printf("// NOTE(cya): the non-terminals with a closure of î on each ");
+    printf("column, as bit\n// masks over NonTerminal\n");
+    printf("static const u64 g_ll1_derives_empty[LL1_COL_COUNT] = {\n");
+    for (isize c = 0; c < col_count; c++) {
+        String s = g_token_strings[g_ll1_gen_cols[c]];
+        printf("    0x%016llx, // %.*s\n",
+            (unsigned long long)derives_empty[c], STRING_ARG(s));
+    }
+
+    printf("};\n\n");
+    printf("#endif // _COMPILER_LL1_H\n");
+    return EXIT_SUCCESS;
+}
+
+/* ------------------------------ Driver ------------------------------------ */
+static void print_usage(const char *program)
+{
+    cy_printf_err("uso: %s keywords > compiler_keywords.h\n", program);
+    cy_printf_err("     %s dfa > compiler_dfa.h\n", program);
+    cy_printf_err("     %s pow5 > compiler_pow5.h\n", program);
+    cy_printf_err("     %s ll1 > compiler_ll1.h\n", program);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc == 2 && strcmp(argv[1], "keywords") == 0) {
+        return gen_keywords();
+    } else if (argc == 2 && strcmp(argv[1], "dfa") == 0) {
+        return gen_dfa();
+    } else if (argc == 2 && strcmp(argv[1], "pow5") == 0) {
+        return gen_pow5();
+    } else if (argc == 2 && strcmp(argv[1], "ll1") == 0) {
+        return gen_ll1();
+    }
+
+    print_usage(argv[0]);
+    return EXIT_FAILURE;
+}
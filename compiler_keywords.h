@@ -0,0 +1,33 @@
+// NOTE(cya): generated by compiler_gen.c (./build.sh gen), do not edit
+#ifndef _COMPILER_KEYWORDS_H
+#define _COMPILER_KEYWORDS_H
+
+#define KEYWORD_GEN_BEGIN 29
+#define KEYWORD_GEN_COUNT 13
+#define KEYWORD_GEN_MIN_LEN 2
+#define KEYWORD_GEN_MAX_LEN 7
+
+#define KEYWORD_HASH_MUL 0x3BC68D87u
+#define KEYWORD_HASH_BITS 4
+
+// NOTE(cya): token kind in each slot (0 means empty)
+static const u8 g_keyword_slots[1 << KEYWORD_HASH_BITS] = {
+    0,
+    32, // if
+    0,
+    40, // repeat
+    34, // else
+    37, // read
+    0,
+    35, // true
+    36, // false
+    30, // main
+    38, // write
+    39, // writeln
+    31, // end
+    33, // elif
+    42, // while
+    41, // until
+};
+
+#endif // _COMPILER_KEYWORDS_H
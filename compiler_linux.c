@@ -0,0 +1,982 @@
+#include "compiler.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#define EXIT_COMPILE_ERROR 1
+#define EXIT_USAGE_ERROR 2
+
+#define READ_CHUNK_SIZE 0x10000
+#define MAX_TOKENIZE_THREADS 256
+#define MAX_SERVER_CLIENTS 4096
+
+typedef struct {
+    const char *in_path;  // NOTE(cya): NULL or "-" means stdin
+    const char *out_path; // NOTE(cya): NULL or "-" means stdout
+    const char *cache_dir; // NOTE(cya): NULL means no cache
+    isize cache_size;
+    const char *server_path;  // NOTE(cya): socket to serve requests on
+    const char *connect_path; // NOTE(cya): socket of a running server
+    isize max_clients; // NOTE(cya): 0 means one per CPU
+    isize tokenize_threads;
+    b32 all_errors;
+    b32 syntax_only;
+    b32 dfa_tokenizer;
+    b32 print_stats;
+} CliArgs;
+
+static void print_usage(const char *program)
+{
+    cy_printf_err(
+        "uso: %s [--stats] [--threads n] [--all-errors] [--dfa] "
+        "[entrada] [-o saida.il]\n", program
+    );
+    cy_printf_err(
+        "     %s --syntax-only [--stats] [--threads n] [--all-errors] "
+        "[--dfa] [entrada]\n", program
+    );
+    cy_printf_err(
+        "     %s [--stats] [--threads n] [--all-errors] [--syntax-only] "
+        "[--dfa] --cache dir\n"
+        "        [--cache-size n] [entrada] [-o saida.il]\n", program
+    );
+    cy_printf_err(
+        "     %s --server socket [--max-clients n] [--threads n] "
+        "[--all-errors] [--syntax-only]\n"
+        "        [--dfa]\n", program
+    );
+    cy_printf_err(
+        "     %s --connect socket [--stats] [entrada] [-o saida.il]\n",
+        program
+    );
+    cy_printf_err(
+        "  (sem entrada ou com \"-\" lê da entrada padrão; "
+        "sem -o ou com \"-o -\" escreve na saída padrão)\n"
+    );
+    cy_printf_err(
+        "  --stats       imprime os tempos e contadores de cada etapa\n"
+        "  --threads     divide o tokenize de fontes grandes em n threads\n"
+        "  --cache       reutiliza resultados guardados no diretório dado\n"
+        "  --cache-size  limite do cache em bytes (aceita K, M e G)\n"
+        "  --all-errors  lista todos os erros léxicos (ou, sem eles, todos os\n"
+        "                sintáticos), não só o primeiro\n"
+        "  --syntax-only só verifica a sintaxe, sem gerar código\n"
+        "  --dfa         lê os tokens com o autômato gerado das regras\n"
+        "                léxicas, em vez de caractere por caractere\n"
+        "  --server      atende pedidos de compilação pelo socket dado\n"
+        "  --max-clients atende até n clientes ao mesmo tempo (por padrão,\n"
+        "                um por CPU); os demais esperam\n"
+        "  --connect     compila usando um servidor já em execução\n"
+    );
+}
+
+// NOTE(cya): returns -1 if str isn't a valid size
+static isize parse_size(const char *str)
+{
+    char *end = NULL;
+    errno = 0;
+    long long size = strtoll(str, &end, 10);
+    if (errno != 0 || end == str || size <= 0) {
+        return -1;
+    }
+
+    switch (*end) {
+    case 'k': case 'K': size *= 1024LL, end++; break;
+    case 'm': case 'M': size *= 1024LL * 1024, end++; break;
+    case 'g': case 'G': size *= 1024LL * 1024 * 1024, end++; break;
+    default: break;
+    }
+
+    return *end == '\0' ? (isize)size : -1;
+}
+
+static b32 parse_args(int argc, char **argv, CliArgs *args_out)
+{
+    CliArgs args = {.tokenize_threads = 1};
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (strcmp(arg, "-o") == 0) {
+            if (i + 1 >= argc) {
+                return false;
+            }
+
+            args.out_path = argv[++i];
+        } else if (strcmp(arg, "--cache") == 0) {
+            if (i + 1 >= argc) {
+                return false;
+            }
+
+            args.cache_dir = argv[++i];
+        } else if (strcmp(arg, "--cache-size") == 0) {
+            if (i + 1 >= argc) {
+                return false;
+            }
+
+            args.cache_size = parse_size(argv[++i]);
+            if (args.cache_size < 0) {
+                return false;
+            }
+        } else if (strcmp(arg, "--server") == 0) {
+            if (i + 1 >= argc) {
+                return false;
+            }
+
+            args.server_path = argv[++i];
+        } else if (strcmp(arg, "--max-clients") == 0) {
+            if (i + 1 >= argc) {
+                return false;
+            }
+
+            char *end = NULL;
+            long clients = strtol(argv[++i], &end, 10);
+            if (*end != '\0' || clients < 1 || clients > MAX_SERVER_CLIENTS) {
+                return false;
+            }
+
+            args.max_clients = clients;
+        } else if (strcmp(arg, "--connect") == 0) {
+            if (i + 1 >= argc) {
+                return false;
+            }
+
+            args.connect_path = argv[++i];
+        } else if (strcmp(arg, "--threads") == 0) {
+            if (i + 1 >= argc) {
+                return false;
+            }
+
+            char *end = NULL;
+            long threads = strtol(argv[++i], &end, 10);
+            if (*end != '\0' || threads < 1 || threads > MAX_TOKENIZE_THREADS) {
+                return false;
+            }
+
+            args.tokenize_threads = threads;
+        } else if (strcmp(arg, "--all-errors") == 0) {
+            args.all_errors = true;
+        } else if (strcmp(arg, "--syntax-only") == 0) {
+            args.syntax_only = true;
+        } else if (strcmp(arg, "--dfa") == 0) {
+            args.dfa_tokenizer = true;
+        } else if (strcmp(arg, "--stats") == 0) {
+            args.print_stats = true;
+        } else if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+            return false;
+        } else if (args.in_path == NULL) {
+            args.in_path = arg;
+        } else {
+            return false;
+        }
+    }
+
+    // NOTE(cya): the server compiles from memory only, without the cache
+    if (args.server_path != NULL && (args.connect_path != NULL ||
+        args.cache_dir != NULL || args.in_path != NULL ||
+        args.out_path != NULL || args.print_stats)) {
+        return false;
+    } else if (args.connect_path != NULL && args.cache_dir != NULL) {
+        return false;
+    } else if (args.max_clients > 0 && args.server_path == NULL) {
+        return false;
+    } else if ((args.tokenize_threads > 1 || args.all_errors ||
+        args.syntax_only || args.dfa_tokenizer) &&
+        args.connect_path != NULL) {
+        // NOTE(cya): the server compiles with the options it was started with
+        return false;
+    } else if (args.syntax_only && args.out_path != NULL) {
+        return false; // NOTE(cya): there's no code to write
+    }
+
+    *args_out = args;
+    return true;
+}
+
+static inline b32 path_is_std_stream(const char *path)
+{
+    return path == NULL || strcmp(path, "-") == 0;
+}
+
+static void print_stats(const CompilerStats *s)
+{
+    f64 src_mb = (f64)s->src_bytes / (1024.0 * 1024.0);
+    f64 total_s = s->total_us / CY_MICROSECONDS;
+    cy_printf_err("tokenize+parse: %9.1fμs\n", s->parse_us);
+    cy_printf_err("check:       %12.1fμs\n", s->check_us);
+    cy_printf_err("il_generate: %12.1fμs\n", s->il_generate_us);
+    cy_printf_err("total:       %12.1fμs", s->total_us);
+    if (total_s > 0.0) {
+        cy_printf_err(" (%.1f MB/s)", src_mb / total_s);
+    }
+
+    cy_printf_err("\n");
+    cy_printf_err("src bytes:         %td\n", s->src_bytes);
+    cy_printf_err("tokens:            %td\n", s->token_count);
+    cy_printf_err("ast nodes:         %td\n", s->ast_node_count);
+    cy_printf_err("arena bytes:       %td\n", s->arena_bytes);
+    cy_printf_err("parser stack max:  %td\n", s->parser_stack_max_depth);
+    cy_printf_err("il bytes:          %td\n", s->il_bytes);
+}
+
+static void print_cache_stats(b32 hit, const CompileCacheStats *s)
+{
+    cy_printf_err("cache:             %s\n", hit ? "hit" : "miss");
+    cy_printf_err("cache hits:        %td\n", s->hits);
+    cy_printf_err("cache misses:      %td\n", s->misses);
+    cy_printf_err("cache evictions:   %td\n", s->evictions);
+    cy_printf_err("cache entries:     %td\n", s->entry_count);
+    cy_printf_err("cache bytes:       %td\n", s->total_bytes);
+}
+
+static CyString read_all(CyAllocator a, int fd)
+{
+    CyString str = cy_string_create_reserve(a, READ_CHUNK_SIZE);
+    CY_VALIDATE_PTR(str);
+
+    for (;;) {
+        str = cy_string_reserve_space_for(str, READ_CHUNK_SIZE);
+        CY_VALIDATE_PTR(str);
+
+        isize len = cy_string_len(str);
+        isize bytes_read = read(fd, str + len, cy_string_available_space(str));
+        if (bytes_read < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            cy_string_free(str);
+            return NULL;
+        } else if (bytes_read == 0) {
+            break;
+        }
+
+        str[len + bytes_read] = '\0';
+        cy__string_set_len(str, len + bytes_read);
+    }
+
+    return str;
+}
+
+static CyString read_path(CyAllocator a, const char *path)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    CyString str = read_all(a, fd);
+    int err = errno;
+    close(fd);
+    errno = err;
+    return str;
+}
+
+static b32 write_all(int fd, const u8 *buf, isize len)
+{
+    while (len > 0) {
+        isize bytes_written = write(fd, buf, len);
+        if (bytes_written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return false;
+        }
+
+        buf += bytes_written, len -= bytes_written;
+    }
+
+    return true;
+}
+
+typedef struct {
+    const char *path;
+    int fd;
+    int err;
+} OutputFile;
+
+/* The file is only created once there's IL to write, so a program that
+ * doesn't compile won't leave an empty file behind */
+static IL_SINK_WRITE_PROC(output_file_write)
+{
+    OutputFile *out = data;
+    if (out->fd < 0) {
+        out->fd = open(out->path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (out->fd < 0) {
+            out->err = errno;
+            return false;
+        }
+    }
+
+    if (!write_all(out->fd, buf, len)) {
+        out->err = errno;
+        return false;
+    }
+
+    return true;
+}
+
+/* ----------------------------- Compile server ----------------------------- */
+/* Requests and responses are a fixed header followed by raw bytes (the source
+ * for requests; the message and then the IL for responses). Both ends are the
+ * same binary, so the stats travel as they are in memory */
+#define SERVER_MAGIC 0x31565253 // NOTE(cya): "SRV1"
+#define SERVER_MAX_SRC_LEN ((isize)1 << 30)
+#define SERVER_BACKLOG 16
+/* Buffers a request grew past this are given back when their worker goes
+ * idle, so each worker doesn't keep the memory of the largest source it has
+ * seen (up to SERVER_MAX_SRC_LEN) */
+#define SERVER_IDLE_MAX_BUF_SIZE (16 * READ_CHUNK_SIZE)
+#define SERVER_WAIT_SLICE_NS 100000000L // NOTE(cya): 100 ms
+
+typedef struct {
+    u32 magic;
+    u32 reserved;
+    u64 src_len;
+} ServerRequest;
+
+typedef struct {
+    u32 magic;
+    u32 ok;
+    u64 msg_len;
+    u64 code_len;
+    CompilerStats stats;
+} ServerResponse;
+
+/* Each connection is served on a thread of its own, so an idle client can't
+ * hold up the others. Workers (a context and its buffers) outlive their
+ * connections and are reused by the next ones, so the memory they grew is
+ * kept from one client to the next (up to SERVER_IDLE_MAX_BUF_SIZE). At most
+ * max_busy connections are served at once; the next ones wait in the listen
+ * backlog until a worker is done */
+typedef struct ServerWorker ServerWorker;
+typedef struct Server Server;
+
+struct ServerWorker {
+    Server *server;
+    ServerWorker *next;      // NOTE(cya): every worker, in creation order
+    ServerWorker *next_idle;
+    CompilerContext ctx;
+    CyString src_buf;
+    CyString code_buf;
+    int conn; // NOTE(cya): -1 while idle
+};
+
+struct Server {
+    pthread_mutex_t lock;
+    pthread_cond_t idle_cond; // NOTE(cya): signaled when a worker is done
+    const CliArgs *args;
+    ServerWorker *workers;
+    ServerWorker *idle;
+    isize busy_count;
+    isize max_busy;
+};
+
+static volatile sig_atomic_t g_server_quit;
+
+static void server_handle_signal(int sig)
+{
+    CY_UNUSED(sig);
+    g_server_quit = true;
+}
+
+// NOTE(cya): false on error or if the stream ends first
+static b32 read_exact(int fd, void *buf, isize len)
+{
+    u8 *cur = buf;
+    while (len > 0) {
+        isize bytes_read = read(fd, cur, len);
+        if (bytes_read < 0) {
+            if (errno == EINTR && !g_server_quit) {
+                continue;
+            }
+
+            return false;
+        } else if (bytes_read == 0) {
+            errno = ECONNRESET;
+            return false;
+        }
+
+        cur += bytes_read, len -= bytes_read;
+    }
+
+    return true;
+}
+
+static b32 socket_address(const char *path, struct sockaddr_un *addr_out)
+{
+    struct sockaddr_un addr = {.sun_family = AF_UNIX};
+    if (cy_str_len(path) >= (isize)sizeof(addr.sun_path)) {
+        errno = ENAMETOOLONG;
+        return false;
+    }
+
+    strcpy(addr.sun_path, path);
+    *addr_out = addr;
+    return true;
+}
+
+static int socket_connect(const char *path)
+{
+    struct sockaddr_un addr;
+    if (!socket_address(path, &addr)) {
+        return -1;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        int err = errno;
+        close(fd);
+        errno = err;
+        return -1;
+    }
+
+    return fd;
+}
+
+/* Answers requests until the client hangs up. The source and IL buffers (and
+ * the context's memory) are reused from one request to the next */
+static void server_serve(
+    int conn, CompilerContext *ctx, CyString *src_buf, CyString *code_buf
+) {
+    for (;;) {
+        ServerRequest req;
+        if (!read_exact(conn, &req, sizeof(req)) ||
+            req.magic != SERVER_MAGIC ||
+            req.src_len > (u64)SERVER_MAX_SRC_LEN) {
+            return;
+        }
+
+        CyString src = *src_buf;
+        cy__string_set_len(src, 0);
+        src = cy_string_reserve_space_for(src, req.src_len);
+        if (src == NULL) {
+            return;
+        }
+
+        *src_buf = src;
+        if (!read_exact(conn, src, req.src_len)) {
+            return;
+        }
+
+        CyString code = *code_buf;
+        cy__string_set_len(code, 0);
+
+        CompilerStats stats;
+        CyStringView src_view = cy_string_view_create_len(src, req.src_len);
+        IlSinkBackend sink = il_sink_backend_string(&code);
+        CompilerOutput output = compile_with_context(
+            ctx, src_view, &sink, &stats
+        );
+        *code_buf = code;
+
+        ServerResponse res = {
+            .magic = SERVER_MAGIC,
+            .ok = output.ok,
+            .msg_len = cy_string_len(output.msg),
+            .code_len = output.ok ? cy_string_len(code) : 0,
+            .stats = stats,
+        };
+        b32 sent = write_all(conn, (const u8*)&res, sizeof(res)) &&
+            write_all(conn, (const u8*)output.msg, res.msg_len) &&
+            write_all(conn, (const u8*)code, res.code_len);
+        compiler_output_free(&output);
+        if (!sent) {
+            return;
+        }
+    }
+}
+
+static CompilerContext server_context_init(
+    CyAllocator a, const CliArgs *args
+) {
+    CompilerContext ctx = compiler_context_init(a);
+    ctx.tokenize_threads = args->tokenize_threads;
+    ctx.all_errors = args->all_errors;
+    ctx.syntax_only = args->syntax_only;
+    ctx.dfa_tokenizer = args->dfa_tokenizer;
+    return ctx;
+}
+
+static ServerWorker *server_worker_acquire(Server *server, CyAllocator a)
+{
+    pthread_mutex_lock(&server->lock);
+    ServerWorker *w = server->idle;
+    if (w != NULL) {
+        server->idle = w->next_idle;
+    }
+    pthread_mutex_unlock(&server->lock);
+
+    if (w == NULL) {
+        w = cy_alloc_item(a, ServerWorker);
+        if (w == NULL) {
+            return NULL;
+        }
+
+        *w = (ServerWorker){
+            .server = server,
+            .ctx = server_context_init(a, server->args),
+            .src_buf = cy_string_create_reserve(a, READ_CHUNK_SIZE),
+            .code_buf = cy_string_create_reserve(a, READ_CHUNK_SIZE),
+            .conn = -1,
+        };
+
+        pthread_mutex_lock(&server->lock);
+        w->next = server->workers;
+        server->workers = w;
+        pthread_mutex_unlock(&server->lock);
+    }
+
+    return w;
+}
+
+// NOTE(cya): a buffer is only replaced if its smaller copy could be made
+static CyString server_buf_trim(CyString buf)
+{
+    if (cy_string_cap(buf) <= SERVER_IDLE_MAX_BUF_SIZE) {
+        return buf;
+    }
+
+    CyAllocator a = CY_STRING_HEADER(buf)->alloc;
+    CyString trimmed = cy_string_create_reserve(a, READ_CHUNK_SIZE);
+    if (trimmed == NULL) {
+        return buf;
+    }
+
+    cy_string_free(buf);
+    return trimmed;
+}
+
+/* After a large request, gives back the buffers and the context's memory
+ * (the arena holds the tokens and the AST of the last source until the next
+ * compilation) */
+static void server_worker_trim(ServerWorker *w)
+{
+    if (cy_string_cap(w->src_buf) <= SERVER_IDLE_MAX_BUF_SIZE &&
+        cy_string_cap(w->code_buf) <= SERVER_IDLE_MAX_BUF_SIZE) {
+        return;
+    }
+
+    w->src_buf = server_buf_trim(w->src_buf);
+    w->code_buf = server_buf_trim(w->code_buf);
+
+    CyAllocator a = w->ctx.alloc;
+    compiler_context_deinit(&w->ctx);
+    w->ctx = server_context_init(a, w->server->args);
+
+#if defined(__GLIBC__)
+    // NOTE(cya): glibc serves large blocks from the heap once one was freed,
+    // and keeps the freed pages mapped unless asked
+    malloc_trim(0);
+#endif
+}
+
+static void *server_worker_run(void *data)
+{
+    ServerWorker *w = data;
+    server_serve(w->conn, &w->ctx, &w->src_buf, &w->code_buf);
+    server_worker_trim(w);
+
+    Server *server = w->server;
+    int conn = w->conn;
+    pthread_mutex_lock(&server->lock);
+    w->conn = -1;
+    w->next_idle = server->idle;
+    server->idle = w;
+    server->busy_count -= 1;
+    pthread_cond_signal(&server->idle_cond);
+    pthread_mutex_unlock(&server->lock);
+
+    close(conn);
+    return NULL;
+}
+
+/* Waits until fewer than max_busy workers are busy. The signals that stop the
+ * server don't wake a condition wait, so it waits in slices. False if the
+ * server is stopping */
+static b32 server_wait_for_worker(Server *server)
+{
+    pthread_mutex_lock(&server->lock);
+    while (server->busy_count >= server->max_busy && !g_server_quit) {
+        struct timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_nsec += SERVER_WAIT_SLICE_NS;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec += 1, deadline.tv_nsec -= 1000000000L;
+        }
+
+        pthread_cond_timedwait(&server->idle_cond, &server->lock, &deadline);
+    }
+    pthread_mutex_unlock(&server->lock);
+
+    return !g_server_quit;
+}
+
+static void server_worker_start(Server *server, ServerWorker *w, int conn)
+{
+    pthread_mutex_lock(&server->lock);
+    w->conn = conn;
+    server->busy_count += 1;
+    pthread_mutex_unlock(&server->lock);
+
+    // NOTE(cya): the signals that stop the server are left to the accepting
+    // thread, so they interrupt accept()
+    sigset_t block, old;
+    sigemptyset(&block);
+    sigaddset(&block, SIGINT);
+    sigaddset(&block, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &block, &old);
+
+    pthread_t thread;
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    b32 started = pthread_create(&thread, &attr, server_worker_run, w) == 0;
+    pthread_attr_destroy(&attr);
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+    if (!started) {
+        server_worker_run(w);
+    }
+}
+
+/* Stops reading from every client (requests being compiled still get their
+ * replies), waits for the workers to finish and frees them */
+static void server_shutdown(Server *server, CyAllocator a)
+{
+    pthread_mutex_lock(&server->lock);
+    for (ServerWorker *w = server->workers; w != NULL; w = w->next) {
+        if (w->conn >= 0) {
+            shutdown(w->conn, SHUT_RD);
+        }
+    }
+
+    while (server->busy_count > 0) {
+        pthread_cond_wait(&server->idle_cond, &server->lock);
+    }
+    pthread_mutex_unlock(&server->lock);
+
+    ServerWorker *w = server->workers;
+    while (w != NULL) {
+        ServerWorker *next = w->next;
+        cy_string_free(w->code_buf);
+        cy_string_free(w->src_buf);
+        compiler_context_deinit(&w->ctx);
+        cy_free(a, w);
+        w = next;
+    }
+
+    pthread_cond_destroy(&server->idle_cond);
+    pthread_mutex_destroy(&server->lock);
+}
+
+static int server_run(const char *path, const CliArgs *args)
+{
+    struct sockaddr_un addr;
+    if (!socket_address(path, &addr)) {
+        cy_printf_err("erro no socket %s: %s\n", path, strerror(errno));
+        return EXIT_USAGE_ERROR;
+    }
+
+    // NOTE(cya): a socket left behind by a server that's gone is replaced,
+    // but anything else at that path is left alone
+    struct stat st;
+    if (lstat(path, &st) == 0) {
+        int fd = S_ISSOCK(st.st_mode) ? socket_connect(path) : -1;
+        if (fd >= 0 || !S_ISSOCK(st.st_mode)) {
+            if (fd >= 0) {
+                close(fd);
+            }
+
+            cy_printf_err("erro no socket %s: já está em uso\n", path);
+            return EXIT_USAGE_ERROR;
+        }
+
+        unlink(path);
+    }
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0 ||
+        bind(listener, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        listen(listener, SERVER_BACKLOG) != 0) {
+        cy_printf_err("erro no socket %s: %s\n", path, strerror(errno));
+        if (listener >= 0) {
+            close(listener);
+        }
+
+        return EXIT_USAGE_ERROR;
+    }
+
+    struct sigaction sa = {.sa_handler = server_handle_signal};
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    CyAllocator a = cy_heap_allocator();
+    Server server = {
+        .args = args,
+        .max_busy = args->max_clients,
+    };
+    if (server.max_busy <= 0) {
+        long cpu_count = sysconf(_SC_NPROCESSORS_ONLN);
+        server.max_busy = CY_MIN(CY_MAX(cpu_count, 1), MAX_SERVER_CLIENTS);
+    }
+
+    pthread_mutex_init(&server.lock, NULL);
+    pthread_condattr_t cond_attr;
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&server.idle_cond, &cond_attr);
+    pthread_condattr_destroy(&cond_attr);
+
+    cy_printf_err("servidor aguardando pedidos em %s\n", path);
+    int status = EXIT_SUCCESS;
+    while (server_wait_for_worker(&server)) {
+        int conn = accept(listener, NULL, NULL);
+        if (conn < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+
+            cy_printf_err("erro no socket %s: %s\n", path, strerror(errno));
+            status = EXIT_USAGE_ERROR;
+            break;
+        }
+
+        ServerWorker *w = server_worker_acquire(&server, a);
+        if (w == NULL) {
+            close(conn);
+            continue;
+        }
+
+        server_worker_start(&server, w, conn);
+    }
+
+    close(listener);
+    unlink(path);
+
+    server_shutdown(&server, a);
+    return status;
+}
+
+// NOTE(cya): false if the server couldn't be reached (see errno)
+static b32 compile_remote(
+    CyAllocator a, const char *path, CyStringView src,
+    const IlSinkBackend *sink, CompilerStats *stats_out,
+    CompilerOutput *output_out
+) {
+    int fd = socket_connect(path);
+    if (fd < 0) {
+        return false;
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+
+    ServerRequest req = {.magic = SERVER_MAGIC, .src_len = src.len};
+    ServerResponse res;
+    b32 ok = write_all(fd, (const u8*)&req, sizeof(req)) &&
+        write_all(fd, src.text, src.len) &&
+        read_exact(fd, &res, sizeof(res)) &&
+        res.magic == SERVER_MAGIC;
+    if (!ok) {
+        goto cleanup;
+    }
+
+    CompilerOutput output = {
+        .ok = res.ok,
+        .msg = cy_string_create_reserve(a, res.msg_len),
+    };
+    ok = output.msg != NULL && read_exact(fd, output.msg, res.msg_len);
+    if (!ok) {
+        cy_string_free(output.msg);
+        goto cleanup;
+    }
+
+    output.msg[res.msg_len] = '\0';
+    cy__string_set_len(output.msg, res.msg_len);
+
+    u8 buf[READ_CHUNK_SIZE];
+    for (u64 left = res.code_len; left > 0 && output.ok;) {
+        isize len = CY_MIN(left, sizeof(buf));
+        ok = read_exact(fd, buf, len);
+        if (!ok) {
+            break;
+        }
+
+        output.ok = sink->proc(sink->data, buf, len);
+        left -= len;
+    }
+
+    if (!ok) {
+        cy_string_free(output.msg);
+        goto cleanup;
+    }
+
+    if (stats_out != NULL) {
+        *stats_out = res.stats;
+    }
+
+    *output_out = output;
+
+cleanup:
+    if (!ok && errno == 0) {
+        errno = EPROTO;
+    }
+
+    close(fd);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    CliArgs args;
+    if (!parse_args(argc, argv, &args)) {
+        print_usage(argv[0]);
+        return EXIT_USAGE_ERROR;
+    }
+
+    if (args.server_path != NULL) {
+        return server_run(args.server_path, &args);
+    }
+
+    int status = EXIT_SUCCESS;
+    CyAllocator a = cy_heap_allocator();
+    CyString src_code = NULL;
+    CompilerOutput output = {0};
+    CompilerStats stats;
+    CompilerStats *stats_out = args.print_stats ? &stats : NULL;
+    CompileCache cache = {.index_fd = -1};
+    CyFileMap src_map = {0};
+
+    // NOTE(cya): the IL is streamed out as it's generated
+    OutputFile out = {.fd = STDOUT_FILENO};
+    if (!path_is_std_stream(args.out_path)) {
+        out = (OutputFile){.path = args.out_path, .fd = -1};
+    }
+
+    IlSinkBackend sink = {.proc = output_file_write, .data = &out};
+    if (args.cache_dir != NULL &&
+        !compile_cache_open(args.cache_dir, args.cache_size, &cache)) {
+        // NOTE(cya): the cache is only an optimization, so carry on without
+        cy_printf_err(
+            "aviso: cache %s indisponível: %s\n",
+            args.cache_dir, strerror(errno)
+        );
+    }
+
+    CyStringView src;
+    if (!path_is_std_stream(args.in_path)) {
+        // NOTE(cya): the tokenizer reads straight from the page cache
+        if (cy_file_map_open(args.in_path, &src_map)) {
+            src = (CyStringView){.text = src_map.data, .len = src_map.size};
+        } else if (errno == ENODEV) {
+            // NOTE(cya): pipes and devices (e.g. <(...), /dev/stdin) can't
+            // be mapped, so they're read whole like standard input
+            src_code = read_path(a, args.in_path);
+            if (src_code == NULL) {
+                cy_printf_err(
+                    "erro ao ler %s: %s\n", args.in_path, strerror(errno)
+                );
+                status = EXIT_USAGE_ERROR;
+                goto cleanup;
+            }
+
+            src = cy_string_view_create(src_code);
+        } else {
+            cy_printf_err(
+                "erro ao abrir %s: %s\n", args.in_path, strerror(errno)
+            );
+            status = EXIT_USAGE_ERROR;
+            goto cleanup;
+        }
+    } else {
+        src_code = read_all(a, STDIN_FILENO);
+        if (src_code == NULL) {
+            cy_printf_err("erro ao ler código fonte: %s\n", strerror(errno));
+            status = EXIT_USAGE_ERROR;
+            goto cleanup;
+        }
+
+        src = cy_string_view_create(src_code);
+    }
+
+    if (args.connect_path != NULL) {
+        errno = 0;
+        if (!compile_remote(
+            a, args.connect_path, src, &sink, stats_out, &output
+        )) {
+            cy_printf_err(
+                "erro ao falar com o servidor em %s: %s\n",
+                args.connect_path, strerror(errno)
+            );
+            status = EXIT_USAGE_ERROR;
+            goto cleanup;
+        }
+    } else {
+        CompilerContext ctx = compiler_context_init(a);
+        ctx.tokenize_threads = args.tokenize_threads;
+        ctx.all_errors = args.all_errors;
+        ctx.syntax_only = args.syntax_only;
+        ctx.dfa_tokenizer = args.dfa_tokenizer;
+        if (cache.index != NULL) {
+            output = compile_cached_with_context(
+                &cache, &ctx, src, &sink, stats_out
+            );
+        } else {
+            output = compile_with_context(&ctx, src, &sink, stats_out);
+        }
+        compiler_context_deinit(&ctx);
+    }
+
+    if (out.err != 0) {
+        const char *path = out.path != NULL ? out.path : "saída padrão";
+        cy_printf_err("erro ao escrever %s: %s\n", path, strerror(out.err));
+        status = EXIT_USAGE_ERROR;
+        goto cleanup;
+    }
+
+    cy_printf_err("%s\n", output.msg);
+    if (stats_out != NULL) {
+        print_stats(stats_out);
+        if (cache.index != NULL) {
+            CompileCacheStats cache_stats = compile_cache_stats(&cache);
+            print_cache_stats(stats_out->cache_hit, &cache_stats);
+        }
+    }
+
+    if (!output.ok) {
+        status = EXIT_COMPILE_ERROR;
+    }
+
+cleanup:
+    if (out.path != NULL && out.fd >= 0) {
+        close(out.fd);
+        if (status == EXIT_USAGE_ERROR) {
+            unlink(out.path);
+        }
+    }
+
+    if (cache.index != NULL) {
+        compile_cache_close(&cache);
+    }
+
+    compiler_output_free(&output);
+    cy_file_map_close(&src_map);
+    cy_string_free(src_code);
+    return status;
+}
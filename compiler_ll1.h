@@ -0,0 +1,638 @@
+// NOTE(cya): generated by compiler_gen.c (./build.sh gen), do not edit
+#ifndef _COMPILER_LL1_H
+#define _COMPILER_LL1_H
+
+#define LL1_GEN_RULE_COUNT 74
+#define LL1_GEN_NT_COUNT 42
+#define LL1_GEN_TOKEN_COUNT 44
+#define LL1_ROW_COUNT 36
+#define LL1_COL_COUNT 34
+
+static const u8 g_ll1_row_from_kind[LL1_GEN_NT_COUNT] = {
+    0, 0, 1, 2, 3, 4, 5, 6, 7, 0, 0, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17,
+    18, 19, 20, 21, 22, 0, 0, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33,
+    34, 35, 0,
+};
+
+// NOTE(cya): terminals the grammar doesn't use get the EOF column, which
+// no rule expands on
+static const u8 g_ll1_col_from_kind[LL1_GEN_TOKEN_COUNT] = {
+    33, 33, 33, 0, 1, 2, 3, 33, 33, 33, 8, 16, 17, 18, 19, 10, 9, 11, 33,
+    12, 13, 14, 15, 33, 6, 7, 5, 4, 33, 33, 20, 29, 26, 27, 28, 22, 23, 21,
+    24, 25, 30, 32, 31, 33,
+};
+
+// NOTE(cya): GrammarRule to expand (0 is a syntax error)
+static const u8 g_ll1_table[LL1_ROW_COUNT][LL1_COL_COUNT] = {
+    { // <inicio>
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <lista_instr>
+        2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2,
+        0, 0, 2, 2, 2, 0, 0, 0, 2, 0, 0, 0,
+    },
+    { // <lista_instr_rep>
+        3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3,
+        0, 0, 3, 3, 3, 0, 0, 4, 3, 0, 0, 0,
+    },
+    { // <instrucao>
+        5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 6,
+        0, 0, 7, 7, 9, 0, 0, 0, 8, 0, 0, 0,
+    },
+    { // <dec_ou_atr>
+        10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <atr_opt>
+        0, 0, 0, 0, 12, 0, 0, 0, 11, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <lista_id>
+        13, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <lista_id_mul>
+        0, 0, 0, 0, 15, 14, 0, 0, 15, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <cmd>
+        16, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 17,
+        0, 0, 18, 18, 20, 0, 0, 0, 19, 0, 0, 0,
+    },
+    { // <cmd_atr>
+        21, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <cmd_entr>
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 22,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <lista_entr>
+        23, 0, 0, 23, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <lista_entr_mul>
+        0, 0, 0, 0, 0, 24, 0, 25, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <cte_str_opt>
+        27, 0, 0, 26, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <cmd_saida>
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 28, 28, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <cmd_saida_tipo>
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 29, 30, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <cmd_sel>
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 34, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <elif>
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 35, 36, 36, 0, 0, 0, 0,
+    },
+    { // <else>
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 37, 38, 0, 0, 0, 0,
+    },
+    { // <lista_cmd>
+        39, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 39,
+        0, 0, 39, 39, 39, 0, 0, 0, 39, 0, 0, 0,
+    },
+    { // <lista_cmd_mul>
+        40, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 40,
+        0, 0, 40, 40, 40, 41, 41, 41, 40, 41, 41, 0,
+    },
+    { // <cmd_rep>
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 42, 0, 0, 0,
+    },
+    { // <cmd_rep_tipo>
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 43, 44, 0,
+    },
+    { // <lista_expr>
+        31, 31, 31, 31, 0, 0, 31, 0, 0, 0, 0, 31, 0, 0, 0, 0, 31, 31, 0, 0,
+        0, 0, 31, 31, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <lista_expr_mul>
+        0, 0, 0, 0, 0, 32, 0, 33, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <expr>
+        45, 45, 45, 45, 0, 0, 45, 0, 0, 0, 0, 45, 0, 0, 0, 0, 45, 45, 0, 0,
+        0, 0, 45, 45, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <expr_log>
+        48, 0, 0, 0, 48, 48, 0, 48, 0, 46, 47, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 48, 0, 0, 48, 48, 48, 0, 0, 0, 48, 0, 0, 0,
+    },
+    { // <elemento>
+        49, 49, 49, 49, 0, 0, 49, 0, 0, 0, 0, 52, 0, 0, 0, 0, 49, 49, 0, 0,
+        0, 0, 50, 51, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <relacional>
+        53, 53, 53, 53, 0, 0, 53, 0, 0, 0, 0, 0, 0, 0, 0, 0, 53, 53, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <relacional_mul>
+        55, 0, 0, 0, 55, 55, 0, 55, 0, 55, 55, 0, 54, 54, 54, 54, 0, 0, 0,
+        0, 0, 55, 0, 0, 55, 55, 55, 0, 0, 0, 55, 0, 0, 0,
+    },
+    { // <operador_relacional>
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 56, 57, 58, 59, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <aritmetica>
+        60, 60, 60, 60, 0, 0, 60, 0, 0, 0, 0, 0, 0, 0, 0, 0, 60, 60, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <aritmetica_mul>
+        63, 0, 0, 0, 63, 63, 0, 63, 0, 63, 63, 0, 63, 63, 63, 63, 61, 62,
+        0, 0, 0, 63, 0, 0, 63, 63, 63, 0, 0, 0, 63, 0, 0, 0,
+    },
+    { // <termo>
+        64, 64, 64, 64, 0, 0, 64, 0, 0, 0, 0, 0, 0, 0, 0, 0, 64, 64, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <termo_mul>
+        67, 0, 0, 0, 67, 67, 0, 67, 0, 67, 67, 0, 67, 67, 67, 67, 67, 67,
+        65, 66, 0, 67, 0, 0, 67, 67, 67, 0, 0, 0, 67, 0, 0, 0,
+    },
+    { // <fator>
+        68, 69, 70, 71, 0, 0, 72, 0, 0, 0, 0, 0, 0, 0, 0, 0, 73, 74, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+};
+
+// NOTE(cya): the terminals each row has a rule for
+static const char *const g_ll1_expected[LL1_ROW_COUNT] = {
+    // <inicio>
+    "main",
+    // <lista_instr>
+    "identificador read write writeln if repeat",
+    // <lista_instr_rep>
+    "identificador read write writeln if end repeat",
+    // <instrucao>
+    "identificador read write writeln if repeat",
+    // <dec_ou_atr>
+    "identificador",
+    // <atr_opt>
+    "; =",
+    // <lista_id>
+    "identificador",
+    // <lista_id_mul>
+    "; , =",
+    // <cmd>
+    "identificador read write writeln if repeat",
+    // <cmd_atr>
+    "identificador",
+    // <cmd_entr>
+    "read",
+    // <lista_entr>
+    "identificador constante_string",
+    // <lista_entr_mul>
+    ", )",
+    // <cte_str_opt>
+    "identificador constante_string",
+    // <cmd_saida>
+    "write writeln",
+    // <cmd_saida_tipo>
+    "write writeln",
+    // <cmd_sel>
+    "if",
+    // <elif>
+    "elif else end",
+    // <else>
+    "else end",
+    // <lista_cmd>
+    "identificador read write writeln if repeat",
+    // <lista_cmd_mul>
+    "identificador read write writeln if elif else end repeat while until",
+    // <cmd_rep>
+    "repeat",
+    // <cmd_rep_tipo>
+    "while until",
+    // <lista_expr>
+    "identificador constante_int constante_float constante_string ( ! + - "
+    "true false",
+    // <lista_expr_mul>
+    ", )",
+    // <expr>
+    "identificador constante_int constante_float constante_string ( ! + - "
+    "true false",
+    // <expr_log>
+    "identificador ; , ) && || read write writeln if repeat",
+    // <elemento>
+    "identificador constante_int constante_float constante_string ( ! + - "
+    "true false",
+    // <relacional>
+    "identificador constante_int constante_float constante_string ( + -",
+    // <relacional_mul>
+    "identificador ; , ) && || == != < > read write writeln if repeat",
+    // <operador_relacional>
+    "== != < >",
+    // <aritmetica>
+    "identificador constante_int constante_float constante_string ( + -",
+    // <aritmetica_mul>
+    "identificador ; , ) && || == != < > + - read write writeln if repeat",
+    // <termo>
+    "identificador constante_int constante_float constante_string ( + -",
+    // <termo_mul>
+    "identificador ; , ) && || == != < > + - * / read write writeln if repeat",
+    // <fator>
+    "identificador constante_int constante_float constante_string ( + -",
+};
+
+#define LL1_RHS_MAX_LEN 6
+
+// NOTE(cya): how many symbols each GrammarRule pushes
+static const u8 g_ll1_rhs_len[LL1_GEN_RULE_COUNT + 1] = {
+    0, 3, 3, 1, 0, 1, 1, 1, 1, 1, 2, 2, 0, 2, 2, 0, 1, 1, 1, 1, 1, 3, 4, 3,
+    2, 0, 2, 0, 4, 1, 1, 2, 2, 0, 6, 4, 0, 2, 0, 3, 1, 0, 4, 1, 1, 2, 3, 3,
+    0, 1, 1, 1, 2, 2, 2, 0, 1, 1, 1, 1, 2, 3, 3, 0, 2, 3, 3, 0, 1, 1, 1, 1,
+    3, 2, 2,
+};
+
+// NOTE(cya): and which (as ParserSymbol), the last one first
+static const u16 g_ll1_rhs[LL1_GEN_RULE_COUNT + 1][LL1_RHS_MAX_LEN] = {
+    { 0 }, // GR_NONE
+    { 31, 46, 30 }, // GR_0
+    { 47, 27, 48 }, // GR_1
+    { 46 }, // GR_2
+    { 0 }, // GR_3
+    { 49 }, // GR_4
+    { 57 }, // GR_5
+    { 61 }, // GR_6
+    { 68 }, // GR_7
+    { 63 }, // GR_8
+    { 50, 51 }, // GR_9
+    { 74, 10 }, // GR_10
+    { 0 }, // GR_11
+    { 52, 3 }, // GR_12
+    { 51, 26 }, // GR_13
+    { 0 }, // GR_14
+    { 56 }, // GR_15
+    { 57 }, // GR_16
+    { 61 }, // GR_17
+    { 68 }, // GR_18
+    { 63 }, // GR_19
+    { 74, 10, 51 }, // GR_20
+    { 25, 58, 24, 37 }, // GR_21
+    { 59, 3, 60 }, // GR_22
+    { 58, 26 }, // GR_23
+    { 0 }, // GR_24
+    { 26, 6 }, // GR_25
+    { 0 }, // GR_26
+    { 25, 72, 24, 62 }, // GR_27
+    { 38 }, // GR_28
+    { 39 }, // GR_29
+    { 73, 74 }, // GR_30
+    { 72, 26 }, // GR_31
+    { 0 }, // GR_32
+    { 31, 65, 64, 66, 74, 32 }, // GR_33
+    { 64, 66, 74, 33 }, // GR_34
+    { 0 }, // GR_35
+    { 66, 34 }, // GR_36
+    { 0 }, // GR_37
+    { 67, 27, 55 }, // GR_38
+    { 66 }, // GR_39
+    { 0 }, // GR_40
+    { 74, 69, 66, 40 }, // GR_41
+    { 42 }, // GR_42
+    { 41 }, // GR_43
+    { 75, 76 }, // GR_44
+    { 75, 76, 16 }, // GR_45
+    { 75, 76, 15 }, // GR_46
+    { 0 }, // GR_47
+    { 77 }, // GR_48
+    { 35 }, // GR_49
+    { 36 }, // GR_50
+    { 76, 17 }, // GR_51
+    { 78, 80 }, // GR_52
+    { 80, 79 }, // GR_53
+    { 0 }, // GR_54
+    { 19 }, // GR_55
+    { 20 }, // GR_56
+    { 21 }, // GR_57
+    { 22 }, // GR_58
+    { 81, 82 }, // GR_59
+    { 81, 82, 11 }, // GR_60
+    { 81, 82, 12 }, // GR_61
+    { 0 }, // GR_62
+    { 83, 84 }, // GR_63
+    { 83, 84, 13 }, // GR_64
+    { 83, 84, 14 }, // GR_65
+    { 0 }, // GR_66
+    { 3 }, // GR_67
+    { 4 }, // GR_68
+    { 5 }, // GR_69
+    { 6 }, // GR_70
+    { 25, 74, 24 }, // GR_71
+    { 84, 11 }, // GR_72
+    { 84, 12 }, // GR_73
+};
+
+#define LL1_CLOSURE_MAX_LEN 8
+
+/* NOTE(cya): what each non-terminal leaves on the stack once it's expanded
+ * down to the lookahead (on top, to be matched), as an offset into
+ * g_ll1_closure_syms, or 0 if it's a syntax error somewhere on the way */
+static const u16 g_ll1_closure[LL1_ROW_COUNT][LL1_COL_COUNT] = {
+    { // <inicio>
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <lista_instr>
+        5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 11,
+        0, 0, 18, 25, 32, 0, 0, 0, 41, 0, 0, 0,
+    },
+    { // <lista_instr_rep>
+        5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 11,
+        0, 0, 18, 25, 32, 0, 0, 48, 41, 0, 0, 0,
+    },
+    { // <instrucao>
+        49, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 53,
+        0, 0, 58, 63, 68, 0, 0, 0, 75, 0, 0, 0,
+    },
+    { // <dec_ou_atr>
+        49, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <atr_opt>
+        0, 0, 0, 0, 48, 0, 0, 0, 80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <lista_id>
+        83, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <lista_id_mul>
+        0, 0, 0, 0, 48, 86, 0, 0, 48, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <cmd>
+        89, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 53,
+        0, 0, 58, 63, 68, 0, 0, 0, 75, 0, 0, 0,
+    },
+    { // <cmd_atr>
+        89, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <cmd_entr>
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 53,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <lista_entr>
+        94, 0, 0, 97, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <lista_entr_mul>
+        0, 0, 0, 0, 0, 102, 0, 48, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <cte_str_opt>
+        48, 0, 0, 105, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <cmd_saida>
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 58, 63, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <cmd_saida_tipo>
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 108, 110, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <cmd_sel>
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 68, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <elif>
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 112, 48, 48, 0, 0, 0, 0,
+    },
+    { // <else>
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 117, 48, 0, 0, 0, 0,
+    },
+    { // <lista_cmd>
+        120, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 127,
+        0, 0, 134, 141, 148, 0, 0, 0, 157, 0, 0, 0,
+    },
+    { // <lista_cmd_mul>
+        120, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 127,
+        0, 0, 134, 141, 148, 48, 48, 48, 157, 48, 48, 0,
+    },
+    { // <cmd_rep>
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 75, 0, 0, 0,
+    },
+    { // <cmd_rep_tipo>
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 164, 166, 0,
+    },
+    { // <lista_expr>
+        168, 175, 182, 189, 0, 0, 196, 0, 0, 0, 0, 205, 0, 0, 0, 0, 210, 218,
+        0, 0, 0, 0, 226, 230, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <lista_expr_mul>
+        0, 0, 0, 0, 0, 234, 0, 48, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <expr>
+        237, 243, 249, 255, 0, 0, 261, 0, 0, 0, 0, 269, 0, 0, 0, 0, 273, 280,
+        0, 0, 0, 0, 287, 290, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <expr_log>
+        48, 0, 0, 0, 48, 48, 0, 48, 0, 293, 297, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 48, 0, 0, 48, 48, 48, 0, 0, 0, 48, 0, 0, 0,
+    },
+    { // <elemento>
+        301, 306, 311, 316, 0, 0, 321, 0, 0, 0, 0, 328, 0, 0, 0, 0, 331, 337,
+        0, 0, 0, 0, 343, 345, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <relacional>
+        301, 306, 311, 316, 0, 0, 321, 0, 0, 0, 0, 0, 0, 0, 0, 0, 331, 337,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <relacional_mul>
+        48, 0, 0, 0, 48, 48, 0, 48, 0, 48, 48, 0, 347, 350, 353, 356, 0, 0,
+        0, 0, 0, 48, 0, 0, 48, 48, 48, 0, 0, 0, 48, 0, 0, 0,
+    },
+    { // <operador_relacional>
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 359, 361, 363, 365, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <aritmetica>
+        367, 371, 375, 379, 0, 0, 383, 0, 0, 0, 0, 0, 0, 0, 0, 0, 389, 394,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <aritmetica_mul>
+        48, 0, 0, 0, 48, 48, 0, 48, 0, 48, 48, 0, 48, 48, 48, 48, 399, 403,
+        0, 0, 0, 48, 0, 0, 48, 48, 48, 0, 0, 0, 48, 0, 0, 0,
+    },
+    { // <termo>
+        407, 410, 413, 416, 0, 0, 419, 0, 0, 0, 0, 0, 0, 0, 0, 0, 424, 428,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    { // <termo_mul>
+        48, 0, 0, 0, 48, 48, 0, 48, 0, 48, 48, 0, 48, 48, 48, 48, 48, 48,
+        432, 436, 0, 48, 0, 0, 48, 48, 48, 0, 0, 0, 48, 0, 0, 0,
+    },
+    { // <fator>
+        440, 442, 444, 446, 0, 0, 448, 0, 0, 0, 0, 0, 0, 0, 0, 0, 452, 455,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+};
+
+/* NOTE(cya): a count, then that many symbols in the order they're pushed,
+ * padded so LL1_CLOSURE_MAX_LEN can be read from any of them */
+static const u16 g_ll1_closure_syms[458 + LL1_CLOSURE_MAX_LEN] = {
+    0,
+    3, 31, 46, 30,
+    5, 47, 27, 50, 52, 3,
+    6, 47, 27, 25, 58, 24, 37,
+    6, 47, 27, 25, 72, 24, 38,
+    6, 47, 27, 25, 72, 24, 39,
+    8, 47, 27, 31, 65, 64, 66, 74, 32,
+    6, 47, 27, 74, 69, 66, 40,
+    0,
+    3, 50, 52, 3,
+    4, 25, 58, 24, 37,
+    4, 25, 72, 24, 38,
+    4, 25, 72, 24, 39,
+    6, 31, 65, 64, 66, 74, 32,
+    4, 74, 69, 66, 40,
+    2, 74, 10,
+    2, 52, 3,
+    2, 51, 26,
+    4, 74, 10, 52, 3,
+    2, 59, 3,
+    4, 59, 3, 26, 6,
+    2, 58, 26,
+    2, 26, 6,
+    1, 38,
+    1, 39,
+    4, 64, 66, 74, 33,
+    2, 66, 34,
+    6, 67, 27, 74, 10, 52, 3,
+    6, 67, 27, 25, 58, 24, 37,
+    6, 67, 27, 25, 72, 24, 38,
+    6, 67, 27, 25, 72, 24, 39,
+    8, 67, 27, 31, 65, 64, 66, 74, 32,
+    6, 67, 27, 74, 69, 66, 40,
+    1, 42,
+    1, 41,
+    6, 73, 75, 78, 81, 83, 3,
+    6, 73, 75, 78, 81, 83, 4,
+    6, 73, 75, 78, 81, 83, 5,
+    6, 73, 75, 78, 81, 83, 6,
+    8, 73, 75, 78, 81, 83, 25, 74, 24,
+    4, 73, 75, 76, 17,
+    7, 73, 75, 78, 81, 83, 84, 11,
+    7, 73, 75, 78, 81, 83, 84, 12,
+    3, 73, 75, 35,
+    3, 73, 75, 36,
+    2, 72, 26,
+    5, 75, 78, 81, 83, 3,
+    5, 75, 78, 81, 83, 4,
+    5, 75, 78, 81, 83, 5,
+    5, 75, 78, 81, 83, 6,
+    7, 75, 78, 81, 83, 25, 74, 24,
+    3, 75, 76, 17,
+    6, 75, 78, 81, 83, 84, 11,
+    6, 75, 78, 81, 83, 84, 12,
+    2, 75, 35,
+    2, 75, 36,
+    3, 75, 76, 16,
+    3, 75, 76, 15,
+    4, 78, 81, 83, 3,
+    4, 78, 81, 83, 4,
+    4, 78, 81, 83, 5,
+    4, 78, 81, 83, 6,
+    6, 78, 81, 83, 25, 74, 24,
+    2, 76, 17,
+    5, 78, 81, 83, 84, 11,
+    5, 78, 81, 83, 84, 12,
+    1, 35,
+    1, 36,
+    2, 80, 19,
+    2, 80, 20,
+    2, 80, 21,
+    2, 80, 22,
+    1, 19,
+    1, 20,
+    1, 21,
+    1, 22,
+    3, 81, 83, 3,
+    3, 81, 83, 4,
+    3, 81, 83, 5,
+    3, 81, 83, 6,
+    5, 81, 83, 25, 74, 24,
+    4, 81, 83, 84, 11,
+    4, 81, 83, 84, 12,
+    3, 81, 82, 11,
+    3, 81, 82, 12,
+    2, 83, 3,
+    2, 83, 4,
+    2, 83, 5,
+    2, 83, 6,
+    4, 83, 25, 74, 24,
+    3, 83, 84, 11,
+    3, 83, 84, 12,
+    3, 83, 84, 13,
+    3, 83, 84, 14,
+    1, 3,
+    1, 4,
+    1, 5,
+    1, 6,
+    3, 25, 74, 24,
+    2, 84, 11,
+    2, 84, 12,
+};
+
+// NOTE(cya): the non-terminals with a closure of î on each column, as bit
+// masks over NonTerminal
+static const u64 g_ll1_derives_empty[LL1_COL_COUNT] = {
+    0x000000a480010000, // identificador
+    0x0000000000000000, // constante_int
+    0x0000000000000000, // constante_float
+    0x0000000000000000, // constante_string
+    0x000000a480000140, // ;
+    0x000000a480000000, // ,
+    0x0000000000000000, // (
+    0x000000a4a0008000, // )
+    0x0000000000000100, // =
+    0x000000a400000000, // &&
+    0x000000a400000000, // ||
+    0x0000000000000000, // !
+    0x000000a000000000, // ==
+    0x000000a000000000, // !=
+    0x000000a000000000, // <
+    0x000000a000000000, // >
+    0x0000008000000000, // +
+    0x0000008000000000, // -
+    0x0000000000000000, // *
+    0x0000000000000000, // /
+    0x0000000000000000, // main
+    0x000000a480000000, // read
+    0x0000000000000000, // true
+    0x0000000000000000, // false
+    0x000000a480000000, // write
+    0x000000a480000000, // writeln
+    0x000000a480000000, // if
+    0x0000000000800000, // elif
+    0x0000000000900000, // else
+    0x0000000000b00008, // end
+    0x000000a480000000, // repeat
+    0x0000000000800000, // while
+    0x0000000000800000, // until
+    0x0000000000000000, // EOF
+};
+
+#endif // _COMPILER_LL1_H
@@ -0,0 +1,321 @@
+#include "compiler.c"
+
+#include <stdlib.h>
+
+/* ---------------------------- Error recovery ------------------------------ */
+/* Sources with syntax errors and how many of them --all-errors should report:
+ * one per actual mistake, with none cascading from the recovery */
+typedef struct {
+    const char *src;
+    isize error_count;
+} RecoverTest;
+
+static const RecoverTest g_recover_tests[] = {
+    // NOTE(cya): the ) is still pending, so it isn't skipped for the ;
+    {"main\n  i_a;\n  writeln(i_a +);\nend\n", 1},
+    {"main\n  i_a;\n  i_a = (1 +);\nend\n", 1},
+    {"main\n  i_a;\n  writeln((i_a *));\nend\n", 1},
+    // NOTE(cya): a stray token is dropped
+    {"main\n  i_a, i_b;\n  writeln(i_a i_b);\nend\n", 1},
+    {"main\n  i_a;\n  i_a = 1 +;\n  writeln(i_a +);\nend\n", 2},
+};
+
+static isize count_lines(CyString str)
+{
+    isize count = 0, len = cy_string_len(str);
+    for (isize i = 0; i < len; i++) {
+        count += str[i] == '\n';
+    }
+
+    return count + (len > 0 && str[len - 1] != '\n');
+}
+
+// NOTE(cya): both parsers (with and without an AST) recover the same way
+static b32 test_recover(CompilerContext *ctx)
+{
+    b32 ok = true;
+    for (isize i = 0; i < CY_STATIC_ARR_LEN(g_recover_tests); i++) {
+        const RecoverTest *test = &g_recover_tests[i];
+        for (isize syntax_only = 0; syntax_only < 2; syntax_only++) {
+            ctx->syntax_only = (b32)syntax_only;
+            CompilerOutput output = compile_with_context(
+                ctx, cy_string_view_create_c(test->src), NULL, NULL
+            );
+
+            isize error_count = output.ok ? 0 : count_lines(output.msg);
+            if (error_count != test->error_count) {
+                cy_printf_err(
+                    "recover %td%s%s: %td erros, esperado %td\n%s\n", i,
+                    syntax_only ? " (--syntax-only)" : "",
+                    ctx->dfa_tokenizer ? " (--dfa)" : "", error_count,
+                    test->error_count, output.msg
+                );
+                ok = false;
+            }
+
+            compiler_output_free(&output);
+        }
+    }
+
+    return ok;
+}
+
+/* The message source gets (as --all-errors would have it). A NULL expected
+ * message means the source must compile, whatever the success message says */
+static b32 test_message(
+    CompilerContext *ctx, const char *name, String src, const char *expected
+) {
+    ctx->syntax_only = false;
+    CompilerOutput output = compile_with_context(ctx, src, NULL, NULL);
+
+    b32 ok = expected == NULL ? output.ok : strcmp(output.msg, expected) == 0;
+    if (!ok) {
+        cy_printf_err(
+            "%s%s: a mensagem foi\n%s\nesperado\n%s\n", name,
+            ctx->dfa_tokenizer ? " (--dfa)" : "", output.msg,
+            expected == NULL ? "programa compilado com sucesso" : expected
+        );
+    }
+
+    compiler_output_free(&output);
+    return ok;
+}
+
+/* ---------------------------- Numeric constants --------------------------- */
+/* The expected values are C's own reading of the same digits, which rounds
+ * correctly. Constants with more than 19 significant digits may take the
+ * strtod path, and the rest go through Clinger's fast path or Eisel-Lemire */
+typedef struct {
+    const char *text;
+    f64 val;
+    isize precision;
+} FloatTest;
+
+// NOTE(cya): the digits of F64_MAX and of the halfway point above it
+#define TEST_F64_MAX_DIGITS \
+    "1797693134862315708145274237317043567980705675258449965989174768" \
+    "0315726078002853876058955863276687817154045895351438246423432132" \
+    "6889464182768467546703537516986049910576551282076245490090389328" \
+    "9440758685084551339423045832369032229481658085593321233482747978" \
+    "26204144723168738177180919299881250404026184124858368"
+#define TEST_F64_HALFWAY_HEAD \
+    "1797693134862315807937289714053034150799341327100378269361737789" \
+    "8044496829276475094664901797758720709633028641669288791094655554" \
+    "7851940402630657488671505820681908902000708383676273854845817711" \
+    "5317644757302700698555713669596228429148198608349364752927190741" \
+    "6844436551070434271155969950809304288017790417449779"
+
+static const FloatTest g_float_tests[] = {
+    {"0,1", 0.1, 1},
+    {"2,5", 2.5, 1},
+    {"0,0001", 0.0001, 4},
+    {"0,30000000000000004", 0.30000000000000004, 17},
+    // NOTE(cya): halfway between two f64s, rounded to the even one
+    {"9007199254740993,0", 9007199254740992.0, 1},
+    {"9007199254740995,0", 9007199254740996.0, 1},
+    {"9007199254740993,00000000000000000001", 9007199254740994.0, 20},
+    {"4503599627370496,5", 4503599627370496.0, 1},
+    {"4503599627370497,5", 4503599627370498.0, 1},
+    // NOTE(cya): more than 19 significant digits
+    {
+        "1,00000000000000011102230246251565404236316680908203125",
+        1.0, 53
+    },
+    {
+        "1,00000000000000011102230246251565404236316680908203126",
+        1.0000000000000002, 53
+    },
+    {
+        "1,00000000000000033306690738754696212708950042724609375",
+        1.0000000000000004, 53
+    },
+    {
+        "123456789012345678901234567890,0",
+        123456789012345678901234567890.0, 1
+    },
+    {
+        "0,0000000000000000000000000000000000000000000000000000123456789"
+        "01234567890123",
+        1.2345678901234567890123e-53, 75
+    },
+    {TEST_F64_MAX_DIGITS ",0", F64_MAX, 1},
+    {TEST_F64_HALFWAY_HEAD "1,99", F64_MAX, 2},
+};
+
+typedef struct {
+    const char *text;
+    isize val;
+} IntTest;
+
+static const IntTest g_int_tests[] = {
+    {"0", 0},
+    {"1234567890", 1234567890},
+    {"9223372036854775807", ISIZE_MAX},
+};
+
+// NOTE(cya): constants that don't fit, and the message each one gets
+static const char *g_number_overflow_tests[] = {
+    "9223372036854775808",
+    "18446744073709551616",
+    "100000000000000000000000",
+    "1" "0000000000000000000000000000000000000000000000000000000000000000"
+    "0000000000000000000000000000000000000000000000000000000000000000"
+    "0000000000000000000000000000000000000000000000000000000000000000"
+    "0000000000000000000000000000000000000000000000000000000000000000"
+    "00000000000000000000000000000000000000000000000000000,0",
+    TEST_F64_HALFWAY_HEAD "2,0",
+};
+
+// NOTE(cya): with the tokenizer the context compiles with
+static Token test_lex_number(
+    const CompilerContext *ctx, const char *text, Tokenizer *t
+) {
+    *t = tokenizer_init(cy_string_view_create_c(text));
+    if (ctx->dfa_tokenizer) {
+        t->backend = TOKENIZER_BACKEND_DFA;
+    }
+
+    return tokenizer_next_token(t);
+}
+
+static b32 test_numbers(CompilerContext *ctx)
+{
+    const char *dfa = ctx->dfa_tokenizer ? " (--dfa)" : "";
+    b32 ok = true;
+    for (isize i = 0; i < CY_STATIC_ARR_LEN(g_float_tests); i++) {
+        const FloatTest *test = &g_float_tests[i];
+        Tokenizer t;
+        Token tok = test_lex_number(ctx, test->text, &t);
+        if (tok.kind != C_TOKEN_FLOAT || t.err != T_ERR_NONE ||
+            t.value.f.val != test->val ||
+            t.value.f.precision != test->precision) {
+            cy_printf_err(
+                "float %td%s: %.17g (%td casas), esperado %.17g (%td casas)\n",
+                i, dfa, t.value.f.val, t.value.f.precision, test->val,
+                test->precision
+            );
+            ok = false;
+        }
+    }
+
+    for (isize i = 0; i < CY_STATIC_ARR_LEN(g_int_tests); i++) {
+        const IntTest *test = &g_int_tests[i];
+        Tokenizer t;
+        Token tok = test_lex_number(ctx, test->text, &t);
+        if (tok.kind != C_TOKEN_INTEGER || t.err != T_ERR_NONE ||
+            t.value.i != test->val) {
+            cy_printf_err(
+                "int %td%s: %td, esperado %td\n", i, dfa, t.value.i,
+                test->val
+            );
+            ok = false;
+        }
+    }
+
+    for (isize i = 0; i < CY_STATIC_ARR_LEN(g_number_overflow_tests); i++) {
+        const char *text = g_number_overflow_tests[i];
+        b32 is_float = strchr(text, ',') != NULL;
+        CyString src = cy_string_create(cy_heap_allocator(), "");
+        const char *ident = is_float ? "f_x" : "i_x";
+        src = cy_string_append_fmt(
+            src, "main\n  %s;\n  %s = %s;\nend\n", ident, ident, text
+        );
+        CyString expected = cy_string_create(cy_heap_allocator(), "");
+        expected = cy_string_append_fmt(
+            expected, "Erro na linha 3 – %s constante_%s muito grande",
+            text, is_float ? "float" : "int"
+        );
+
+        char name[0x40];
+        snprintf(name, sizeof(name), "overflow %td", i);
+        ok &= test_message(
+            ctx, name, cy_string_view_create(src), expected
+        );
+        cy_string_free(expected);
+        cy_string_free(src);
+    }
+
+    return ok;
+}
+
+/* ---------------------------------- UTF-8 --------------------------------- */
+/* Columns count code points, and a bad sequence is reported by its first
+ * byte. The length is explicit so a source can hold a NUL */
+typedef struct {
+    const char *src;
+    isize len;
+    const char *msg;
+} Utf8Test;
+
+#define TEST_UTF8(src, msg) {src, sizeof(src) - 1, msg}
+#define TEST_UTF8_OK NULL
+#define TEST_UTF8_ERR(byte, col) \
+    "Erro na linha 2 – byte " byte " inválido em UTF-8 (coluna " col ")"
+
+static const Utf8Test g_utf8_tests[] = {
+    TEST_UTF8("main\n  writeln(\"ação à côté ü ñ 日本 😀\");\nend\n",
+              TEST_UTF8_OK),
+    TEST_UTF8(">@\ncomentário ação\n@<\nmain\n  writeln(\"ç\");\nend\n",
+              TEST_UTF8_OK),
+    TEST_UTF8("\xef\xbb\xbfmain\n  writeln(\"ação\");\nend\n", TEST_UTF8_OK),
+    // NOTE(cya): a NUL in a literal is just another byte
+    TEST_UTF8("main\n  writeln(\"a\0b\");\nend\n", TEST_UTF8_OK),
+    TEST_UTF8("main\n writeln(\"ação \xff\");\nend\n",
+              TEST_UTF8_ERR("0xFF", "16")),
+    TEST_UTF8("main\n  writeln(\"a\xff\");\nend\n",
+              TEST_UTF8_ERR("0xFF", "13")),
+    // NOTE(cya): overlong forms of '/' and of U+0800
+    TEST_UTF8("main\n  writeln(\"a\xc0\xaf\");\nend\n",
+              TEST_UTF8_ERR("0xC0", "13")),
+    TEST_UTF8("main\n  writeln(\"a\xe0\x9f\xbf\");\nend\n",
+              TEST_UTF8_ERR("0xE0", "13")),
+    // NOTE(cya): U+D800, a surrogate
+    TEST_UTF8("main\n  writeln(\"a\xed\xa0\x80\");\nend\n",
+              TEST_UTF8_ERR("0xED", "13")),
+    // NOTE(cya): U+110000 and a lead byte that can only start one like it
+    TEST_UTF8("main\n  writeln(\"a\xf4\x90\x80\x80\");\nend\n",
+              TEST_UTF8_ERR("0xF4", "13")),
+    TEST_UTF8("main\n  writeln(\"a\xf5\x80\x80\x80\");\nend\n",
+              TEST_UTF8_ERR("0xF5", "13")),
+    // NOTE(cya): truncated, by the closing quote and by the end of the source
+    TEST_UTF8("main\n  writeln(\"ã\xe3\x81\");\nend\n",
+              TEST_UTF8_ERR("0xE3", "13")),
+    TEST_UTF8("main\n  writeln(\"a\xf0\x9f\x98", TEST_UTF8_ERR("0xF0", "13")),
+    TEST_UTF8(">@\n  ação \xff\n@<\nmain\nend\n", TEST_UTF8_ERR("0xFF", "8")),
+    TEST_UTF8("main\n  \x80;\nend\n", TEST_UTF8_ERR("0x80", "3")),
+};
+
+static b32 test_utf8(CompilerContext *ctx)
+{
+    b32 ok = true;
+    for (isize i = 0; i < CY_STATIC_ARR_LEN(g_utf8_tests); i++) {
+        const Utf8Test *test = &g_utf8_tests[i];
+        char name[0x40];
+        snprintf(name, sizeof(name), "utf8 %td", i);
+        ok &= test_message(
+            ctx, name, cy_string_view_create_len(test->src, test->len),
+            test->msg
+        );
+    }
+
+    return ok;
+}
+
+int main(void)
+{
+    CompilerContext ctx = compiler_context_init(cy_heap_allocator());
+    ctx.all_errors = true;
+
+    // NOTE(cya): everything comes out the same with either tokenizer
+    b32 ok = true;
+    for (isize dfa = 0; dfa < 2; dfa++) {
+        ctx.dfa_tokenizer = (b32)dfa;
+        ok &= test_recover(&ctx);
+        ok &= test_numbers(&ctx);
+        ok &= test_utf8(&ctx);
+    }
+    compiler_context_deinit(&ctx);
+
+    printf("%s\n", ok ? "testes ok" : "testes falharam");
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -163,7 +163,7 @@ typedef i32 b32;
 #define U64_MIN 0U
 #define U64_MAX 0xFFFFFFFFFFFFFFFFULL
 #define I64_MIN (-0x7FFFFFFFFFFFFFFFLL - 1)
-#define I64_MAX 0x7FFFFFFFFFFFFFFFFLL
+#define I64_MAX 0x7FFFFFFFFFFFFFFFLL
 
 #define F32_MIN 1.17549435e-38F
 #define F32_MAX 3.40282347e+38F
@@ -200,6 +200,7 @@ typedef i32 Rune; // Unicode codepoint
 /* ================================= Runtime ================================ */
 #include <stdio.h>   // for optional logging
 #include <stdarg.h>  // va_args
+#include <wchar.h>   // vswprintf (non-windows)
 
 // TODO(cya): implement printf family and move this stuff to some better place
 #define cy_printf_err(...) fprintf(stderr, __VA_ARGS__)
@@ -388,6 +389,8 @@ CY_DEF CyAllocator cy_arena_allocator(CyArena *arena);
 CY_DEF CyArenaNode *cy_arena_insert_node(CyArena *arena, isize size);
 CY_DEF CyArena cy_arena_init(CyAllocator backing, isize initial_size);
 CY_DEF void cy_arena_deinit(CyArena *arena);
+// NOTE(cya): bytes handed out so far (including alignment padding)
+CY_DEF isize cy_arena_size_used(CyArena *arena);
 
 /* ------------------------- Stack Allocator Section ------------------------ */
 typedef struct CyStackNode {
@@ -456,6 +459,26 @@ CY_DEF CyPool cy_pool_init(
  * general-purpose heap allocator composed of the basic ones to replace malloc
  */
 
+/* ============================== File mapping ============================== */
+// NOTE(cya): read-only view of a whole file (empty files map to NULL/0);
+// pipes, sockets and devices have no fixed size, so opening them fails
+// (errno ENODEV on POSIX) and the caller should read them instead
+typedef struct {
+    const u8 *data;
+    isize size;
+#if defined(CY_OS_WINDOWS)
+    HANDLE file;
+    HANDLE mapping;
+#endif
+} CyFileMap;
+
+CY_DEF b32 cy_file_map_open(const char *path, CyFileMap *map_out);
+CY_DEF void cy_file_map_close(CyFileMap *map);
+
+/* ================================ Hashing ================================= */
+// NOTE(cya): MurmurHash64A (fast, non-cryptographic)
+CY_DEF u64 cy_hash_64(const void *data, isize len, u64 seed);
+
 /* ============================== Char procs ================================ */
 CY_DEF const char *cy_char_first_occurence(const char *str, char c);
 CY_DEF const char *cy_char_last_occurence(const char *str, char c);
@@ -602,6 +625,8 @@ CY_DEF b32 cy_string_16_view_contains(
 );
 
 /* ============================ Unicode helpers ============================= */
+CY_DEF isize cy_utf8_encode_rune(u8 buf[4], Rune r);
+CY_DEF isize cy_utf8_decode(const u8 *str, Rune *codepoint_out);
 CY_DEF isize cy_utf8_codepoints(const char *str);
 
 /******************************************************************************
@@ -731,10 +756,9 @@ inline CyTicks cy_ticks_elapsed(CyTicks start, CyTicks end)
 inline f64 cy_ticks_to_time_unit(CyTicks ticks, CyTimeUnit unit)
 {
 #if defined(CY_OS_WINDOWS)
-    static LARGE_INTEGER perf_freq;
-    if (perf_freq.QuadPart == 0) {
-        QueryPerformanceFrequency(&perf_freq);
-    }
+    // NOTE(cya): queried every time (it's cheap) to keep this thread-safe
+    LARGE_INTEGER perf_freq;
+    QueryPerformanceFrequency(&perf_freq);
 
     return (f64)ticks.counter.QuadPart * unit / perf_freq.QuadPart;
 #else
@@ -1134,6 +1158,22 @@ inline void cy_arena_deinit(CyArena *arena)
     cy_mem_set(arena, 0, sizeof(*arena));
 }
 
+inline isize cy_arena_size_used(CyArena *arena)
+{
+    if (arena == NULL) {
+        return 0;
+    }
+
+    isize used = 0;
+    CyArenaNode *cur_node = arena->state.first_node;
+    while (cur_node != NULL) {
+        used += cur_node->offset;
+        cur_node = cur_node->next;
+    }
+
+    return used;
+}
+
 CY_ALLOCATOR_PROC(cy_arena_allocator_proc)
 {
     CY_UNUSED(flags);
@@ -1465,13 +1505,18 @@ CY_ALLOCATOR_PROC(cy_stack_allocator_proc)
         isize prev_offset = (isize)(cur_addr - cur_padding - start);
         isize new_offset = (isize)(alloc_start + new_padding + size - start);
         if (new_offset <= cur_node->size) {
+            // NOTE(cya): the data only moves if the alignment changed
             u8 *new_addr = alloc_start + new_padding;
+            if (new_addr != cur_addr) {
+                cy_mem_move(new_addr, cur_addr, CY_MIN(old_size, size));
+            }
+
             header = (CyStackHeader*)new_addr - 1;
             header->padding = new_padding;
             header->prev_offset = prev_offset;
 
             cur_node->offset = new_offset;
-            ptr = alloc_start;
+            ptr = new_addr;
             break;
         }
 
@@ -1536,6 +1581,157 @@ CY_ALLOCATOR_PROC(cy_pool_allocator_proc)
 }
 #endif
 
+/* ============================== File mapping ============================== */
+#if !defined(CY_OS_WINDOWS)
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+b32 cy_file_map_open(const char *path, CyFileMap *map_out)
+{
+    CyFileMap map = {0};
+#if defined(CY_OS_WINDOWS)
+    map.file = CreateFileA(
+        path, GENERIC_READ, FILE_SHARE_READ, NULL,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+        NULL
+    );
+    if (map.file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (GetFileType(map.file) != FILE_TYPE_DISK) {
+        CloseHandle(map.file);
+        SetLastError(ERROR_INVALID_FUNCTION);
+        return false;
+    }
+
+    if (!GetFileSizeEx(map.file, &size)) {
+        CloseHandle(map.file);
+        return false;
+    }
+
+    map.size = (isize)size.QuadPart;
+    if (map.size > 0) {
+        map.mapping = CreateFileMappingA(
+            map.file, NULL, PAGE_READONLY, 0, 0, NULL
+        );
+        if (map.mapping == NULL) {
+            CloseHandle(map.file);
+            return false;
+        }
+
+        map.data = MapViewOfFile(map.mapping, FILE_MAP_READ, 0, 0, 0);
+        if (map.data == NULL) {
+            CloseHandle(map.mapping);
+            CloseHandle(map.file);
+            return false;
+        }
+    }
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+
+    if (!S_ISREG(st.st_mode)) {
+        close(fd);
+        errno = ENODEV;
+        return false;
+    }
+
+    map.size = (isize)st.st_size;
+    if (map.size > 0) {
+        void *data = mmap(NULL, map.size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            close(fd);
+            return false;
+        }
+
+        madvise(data, map.size, MADV_SEQUENTIAL);
+        map.data = data;
+    }
+
+    // NOTE(cya): the mapping stays valid after the descriptor is closed
+    close(fd);
+#endif
+
+    *map_out = map;
+    return true;
+}
+
+void cy_file_map_close(CyFileMap *map)
+{
+    if (map == NULL) {
+        return;
+    }
+
+#if defined(CY_OS_WINDOWS)
+    if (map->data != NULL) {
+        UnmapViewOfFile(map->data);
+    }
+    if (map->mapping != NULL) {
+        CloseHandle(map->mapping);
+    }
+    if (map->file != NULL && map->file != INVALID_HANDLE_VALUE) {
+        CloseHandle(map->file);
+    }
+#else
+    if (map->data != NULL) {
+        munmap((void*)map->data, map->size);
+    }
+#endif
+
+    cy_mem_zero(map, sizeof(*map));
+}
+
+/* ================================ Hashing ================================= */
+u64 cy_hash_64(const void *data, isize len, u64 seed)
+{
+    const u64 m = 0xC6A4A7935BD1E995ULL;
+    const int r = 47;
+
+    const u8 *p = data;
+    const u8 *end = p + (len & ~(isize)7);
+    u64 h = seed ^ ((u64)len * m);
+    for (; p != end; p += 8) {
+        u64 k;
+        cy_mem_copy(&k, p, sizeof(k));
+
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+
+        h ^= k;
+        h *= m;
+    }
+
+    switch (len & 7) {
+    case 7: h ^= (u64)p[6] << 48; // fallthrough
+    case 6: h ^= (u64)p[5] << 40; // fallthrough
+    case 5: h ^= (u64)p[4] << 32; // fallthrough
+    case 4: h ^= (u64)p[3] << 24; // fallthrough
+    case 3: h ^= (u64)p[2] << 16; // fallthrough
+    case 2: h ^= (u64)p[1] << 8;  // fallthrough
+    case 1: h ^= (u64)p[0];
+            h *= m;
+    }
+
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    return h;
+}
+
 /* ============================== Char procs =============================== */
 const char *cy_char_first_occurence(const char *str, char c)
 {
@@ -1778,9 +1974,9 @@ inline CyString cy_string_append_c(CyString str, const char *other)
 
 inline CyString cy_string_append_rune(CyString str, Rune r)
 {
-    // TODO(cya): utf-8 encode rune
-    isize width = 1;
-    return cy_string_append_len(str, (const char*)&r, width);
+    u8 buf[4];
+    isize width = cy_utf8_encode_rune(buf, r);
+    return cy_string_append_len(str, (const char*)buf, width);
 }
 
 CyString cy_string_append_fmt(CyString str, const char *fmt, ...)
@@ -1832,9 +2028,9 @@ inline CyString cy_string_prepend_c(CyString str, const char *other)
 
 CY_DEF CyString cy_string_prepend_rune(CyString str, Rune r)
 {
-    // TODO(cya): utf-8 encode rune
-    isize width = 1;
-    return cy_string_prepend_len(str, (const char*)&r, width);
+    u8 buf[4];
+    isize width = cy_utf8_encode_rune(buf, r);
+    return cy_string_prepend_len(str, (const char*)buf, width);
 }
 
 CY_DEF CyString cy_string_prepend_fmt(CyString str, const char *fmt, ...)
@@ -2261,7 +2457,11 @@ CyString16 cy_string_16_append_fmt(CyString16 str, const wchar_t *fmt, ...)
     // TODO(cya): maybe have some fancier size handling than this?
     wchar_t buf[0x1000] = {0};
 
+#if defined(CY_OS_WINDOWS)
     isize len = _vsnwprintf(buf, CY_STATIC_ARR_LEN(buf), fmt, va);
+#else
+    isize len = vswprintf(buf, CY_STATIC_ARR_LEN(buf), fmt, va);
+#endif
 
     va_end(va);
     return cy_string_16_append_len(str, buf, len);
@@ -2339,28 +2539,82 @@ b32 cy_string_16_view_contains(CyString16View str, const wchar_t *char_set)
 CY_DEF isize cy_utf8_codepoints(const char *str);
 
 /* ============================ Unicode helpers ============================= */
-#if 0
-static u8 cy__utf8_class_table[32] = {
-    0, 0, 0, 0, // 0 = 0xxxx
-    0, 0, 0, 0, // 1 = 10xxx
-    0, 0, 0, 0, // 2 = 110xx
-    0, 0, 0, 0, // 3 = 1110x
-    1, 1, 1, 1, // 4 = 11110
-    1, 1, 1, 1, // 5 = 11111 (invalid)
-    2, 2, 2, 2,
-    3, 3, 4, 5,
-};
-
+// NOTE(cya): surrogates and runes past CY_RUNE_MAX are encoded as U+FFFD
 isize cy_utf8_encode_rune(u8 buf[4], Rune r)
 {
-    return 0;
+    u32 c = (u32)r;
+    if (c < 0x80) {
+        buf[0] = (u8)c;
+        return 1;
+    } else if (c < 0x800) {
+        buf[0] = (u8)(0xC0 | c >> 6);
+        buf[1] = (u8)(0x80 | (c & 0x3F));
+        return 2;
+    } else if (c > (u32)CY_RUNE_MAX || (c >= 0xD800 && c <= 0xDFFF)) {
+        c = (u32)CY_RUNE_INVALID;
+    }
+
+    if (c < 0x10000) {
+        buf[0] = (u8)(0xE0 | c >> 12);
+        buf[1] = (u8)(0x80 | (c >> 6 & 0x3F));
+        buf[2] = (u8)(0x80 | (c & 0x3F));
+        return 3;
+    }
+
+    buf[0] = (u8)(0xF0 | c >> 18);
+    buf[1] = (u8)(0x80 | (c >> 12 & 0x3F));
+    buf[2] = (u8)(0x80 | (c >> 6 & 0x3F));
+    buf[3] = (u8)(0x80 | (c & 0x3F));
+    return 4;
 }
 
+/* Decodes the rune str starts with, returning its width. Invalid sequences
+ * (overlong forms and surrogates included) decode to CY_RUNE_INVALID with a
+ * width of 1. Reading stops at the first byte that isn't a continuation byte,
+ * so this never goes past the terminator of a C string */
 isize cy_utf8_decode(const u8 *str, Rune *codepoint_out)
 {
-    return 0;
+    static const Rune min_rune[] = { 0, 0, 0x80, 0x800, 0x10000 };
+
+    u8 c = str[0];
+    isize width = 0;
+    Rune r = 0;
+    if (c < 0x80) {
+        *codepoint_out = c;
+        return 1;
+    } else if ((c & 0xE0) == 0xC0) {
+        width = 2;
+        r = c & 0x1F;
+    } else if ((c & 0xF0) == 0xE0) {
+        width = 3;
+        r = c & 0x0F;
+    } else if ((c & 0xF8) == 0xF0) {
+        width = 4;
+        r = c & 0x07;
+    } else {
+        goto invalid;
+    }
+
+    for (isize i = 1; i < width; i++) {
+        if ((str[i] & 0xC0) != 0x80) {
+            goto invalid;
+        }
+
+        r = r << 6 | (str[i] & 0x3F);
+    }
+
+    b32 is_surrogate = r >= 0xD800 && r <= 0xDFFF;
+    if (r < min_rune[width] || r > CY_RUNE_MAX || is_surrogate) {
+        goto invalid;
+    }
+
+    *codepoint_out = r;
+    return width;
+
+invalid:
+    *codepoint_out = CY_RUNE_INVALID;
+    return 1;
 }
-#endif
 
 inline isize cy_utf8_codepoints(const char *str)
 {